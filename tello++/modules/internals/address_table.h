@@ -0,0 +1,160 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+template<typename Value>
+class AddressTable
+{
+    public:
+        static constexpr std::uint32_t empty_address = 0;
+
+        AddressTable(const std::size_t &initial_capacity = 16)
+        {
+            this->rehash(initial_capacity);
+        }
+
+        Value *find(const std::uint32_t &address)
+        {
+            std::size_t slot_index = this->find_slot(address);
+            return slot_index == this->slots.size() ? nullptr : &this->slots[slot_index].value;
+        }
+
+        const Value *find(const std::uint32_t &address) const
+        {
+            std::size_t slot_index = this->find_slot(address);
+            return slot_index == this->slots.size() ? nullptr : &this->slots[slot_index].value;
+        }
+
+        bool insert(const std::uint32_t &address, Value value)
+        {
+            if (address == empty_address || this->find(address))
+            {
+                return false;
+            }
+
+            if ((this->item_count + 1) * 2 > this->slots.size())
+            {
+                this->rehash(this->slots.size() * 2);
+            }
+
+            this->place(address, std::move(value));
+            this->item_count++;
+
+            return true;
+        }
+
+        bool erase(const std::uint32_t &address)
+        {
+            std::size_t hole_index = this->find_slot(address);
+
+            if (hole_index == this->slots.size())
+            {
+                return false;
+            }
+
+            for (std::size_t slot_index = (hole_index + 1) & this->slot_mask; this->slots[slot_index].address != empty_address; slot_index = (slot_index + 1) & this->slot_mask)
+            {
+                std::size_t home_slot = this->get_home_slot(this->slots[slot_index].address);
+                bool stays_put = hole_index <= slot_index ? (home_slot > hole_index && home_slot <= slot_index) : (home_slot > hole_index || home_slot <= slot_index);
+
+                if (!stays_put)
+                {
+                    this->slots[hole_index] = std::move(this->slots[slot_index]);
+                    hole_index = slot_index;
+                }
+            }
+
+            this->slots[hole_index] = Slot{};
+            this->item_count--;
+
+            return true;
+        }
+
+        std::size_t size() const
+        {
+            return this->item_count;
+        }
+
+        std::size_t capacity() const
+        {
+            return this->slots.size();
+        }
+
+    private:
+        struct Slot
+        {
+            std::uint32_t address = empty_address;
+            Value value{};
+        };
+
+        std::size_t get_home_slot(const std::uint32_t &address) const
+        {
+            return static_cast<std::size_t>((static_cast<std::uint64_t>(address) * 0x9E3779B97F4A7C15ull) >> this->hash_shift);
+        }
+
+        std::size_t find_slot(const std::uint32_t &address) const
+        {
+            if (address == empty_address)
+            {
+                return this->slots.size();
+            }
+
+            for (std::size_t slot_index = this->get_home_slot(address);; slot_index = (slot_index + 1) & this->slot_mask)
+            {
+                if (this->slots[slot_index].address == address)
+                {
+                    return slot_index;
+                }
+
+                if (this->slots[slot_index].address == empty_address)
+                {
+                    return this->slots.size();
+                }
+            }
+        }
+
+        void place(const std::uint32_t &address, Value value)
+        {
+            std::size_t slot_index = this->get_home_slot(address);
+
+            while (this->slots[slot_index].address != empty_address)
+            {
+                slot_index = (slot_index + 1) & this->slot_mask;
+            }
+
+            this->slots[slot_index] = Slot{address, std::move(value)};
+        }
+
+        void rehash(const std::size_t &minimum_capacity)
+        {
+            std::size_t slot_count = 4;
+            int slot_bits = 2;
+
+            while (slot_count < minimum_capacity)
+            {
+                slot_count *= 2;
+                slot_bits++;
+            }
+
+            std::vector<Slot> old_slots = std::exchange(this->slots, std::vector<Slot>(slot_count));
+
+            this->slot_mask = slot_count - 1;
+            this->hash_shift = 64 - slot_bits;
+
+            for (Slot &slot : old_slots)
+            {
+                if (slot.address != empty_address)
+                {
+                    this->place(slot.address, std::move(slot.value));
+                }
+            }
+        }
+
+        std::vector<Slot> slots;
+        std::size_t slot_mask = 0;
+        int hash_shift = 64;
+        std::size_t item_count = 0;
+};
\ No newline at end of file
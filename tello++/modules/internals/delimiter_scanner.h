@@ -0,0 +1,166 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TELLO_DELIMITER_SCANNER_SSE2
+#include <emmintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(TELLO_DELIMITER_SCANNER_SSE2) && (defined(__GNUC__) || defined(__clang__))
+#define TELLO_DELIMITER_SCANNER_AVX2
+#include <immintrin.h>
+#endif
+
+enum class DelimiterScannerKind
+{
+    scalar,
+    sse2,
+    avx2
+};
+
+using DelimiterScanner = std::size_t (*)(const char *data, const std::size_t &size, std::uint16_t *positions);
+
+inline int count_trailing_zero_bits(std::uint32_t mask)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long bit_index;
+    _BitScanForward(&bit_index, mask);
+    return static_cast<int>(bit_index);
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+inline std::size_t store_delimiter_positions(std::uint32_t mask, const std::size_t &block_offset, std::uint16_t *positions, std::size_t position_count)
+{
+    while (mask != 0)
+    {
+        positions[position_count++] = static_cast<std::uint16_t>(block_offset + count_trailing_zero_bits(mask));
+        mask &= mask - 1;
+    }
+
+    return position_count;
+}
+
+inline std::size_t scan_delimiters_scalar(const char *data, const std::size_t &size, std::uint16_t *positions)
+{
+    std::size_t position_count = 0;
+
+    for (std::size_t index = 0; index < size; index++)
+    {
+        positions[position_count] = static_cast<std::uint16_t>(index);
+        position_count += (data[index] == ':') | (data[index] == ';');
+    }
+
+    return position_count;
+}
+
+#if defined(TELLO_DELIMITER_SCANNER_SSE2)
+inline std::size_t scan_delimiters_sse2(const char *data, const std::size_t &size, std::uint16_t *positions)
+{
+    const __m128i colons = _mm_set1_epi8(':');
+    const __m128i semicolons = _mm_set1_epi8(';');
+
+    std::size_t position_count = 0;
+    std::size_t block_offset = 0;
+
+    for (; block_offset + 16 <= size; block_offset += 16)
+    {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + block_offset));
+        __m128i delimiters = _mm_or_si128(_mm_cmpeq_epi8(block, colons), _mm_cmpeq_epi8(block, semicolons));
+
+        position_count = store_delimiter_positions(static_cast<std::uint32_t>(_mm_movemask_epi8(delimiters)), block_offset, positions, position_count);
+    }
+
+    if (block_offset < size)
+    {
+        alignas(16) char tail[16] = {};
+        std::memcpy(tail, data + block_offset, size - block_offset);
+
+        __m128i block = _mm_load_si128(reinterpret_cast<const __m128i*>(tail));
+        __m128i delimiters = _mm_or_si128(_mm_cmpeq_epi8(block, colons), _mm_cmpeq_epi8(block, semicolons));
+
+        position_count = store_delimiter_positions(static_cast<std::uint32_t>(_mm_movemask_epi8(delimiters)), block_offset, positions, position_count);
+    }
+
+    return position_count;
+}
+#endif
+
+#if defined(TELLO_DELIMITER_SCANNER_AVX2)
+__attribute__((target("avx2")))
+inline std::size_t scan_delimiters_avx2(const char *data, const std::size_t &size, std::uint16_t *positions)
+{
+    const __m256i colons = _mm256_set1_epi8(':');
+    const __m256i semicolons = _mm256_set1_epi8(';');
+
+    std::size_t position_count = 0;
+    std::size_t block_offset = 0;
+
+    for (; block_offset + 32 <= size; block_offset += 32)
+    {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + block_offset));
+        __m256i delimiters = _mm256_or_si256(_mm256_cmpeq_epi8(block, colons), _mm256_cmpeq_epi8(block, semicolons));
+
+        position_count = store_delimiter_positions(static_cast<std::uint32_t>(_mm256_movemask_epi8(delimiters)), block_offset, positions, position_count);
+    }
+
+    if (block_offset < size)
+    {
+        alignas(32) char tail[32] = {};
+        std::memcpy(tail, data + block_offset, size - block_offset);
+
+        __m256i block = _mm256_load_si256(reinterpret_cast<const __m256i*>(tail));
+        __m256i delimiters = _mm256_or_si256(_mm256_cmpeq_epi8(block, colons), _mm256_cmpeq_epi8(block, semicolons));
+
+        position_count = store_delimiter_positions(static_cast<std::uint32_t>(_mm256_movemask_epi8(delimiters)), block_offset, positions, position_count);
+    }
+
+    return position_count;
+}
+#endif
+
+inline DelimiterScannerKind detect_delimiter_scanner_kind()
+{
+#if defined(TELLO_DELIMITER_SCANNER_AVX2)
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return DelimiterScannerKind::avx2;
+    }
+#endif
+
+#if defined(TELLO_DELIMITER_SCANNER_SSE2)
+    return DelimiterScannerKind::sse2;
+#else
+    return DelimiterScannerKind::scalar;
+#endif
+}
+
+inline DelimiterScanner get_delimiter_scanner(const DelimiterScannerKind &delimiter_scanner_kind)
+{
+    switch (delimiter_scanner_kind)
+    {
+#if defined(TELLO_DELIMITER_SCANNER_AVX2)
+        case DelimiterScannerKind::avx2:
+            return scan_delimiters_avx2;
+#endif
+#if defined(TELLO_DELIMITER_SCANNER_SSE2)
+        case DelimiterScannerKind::sse2:
+            return scan_delimiters_sse2;
+#endif
+        default:
+            return scan_delimiters_scalar;
+    }
+}
+
+inline DelimiterScanner get_delimiter_scanner()
+{
+    static const DelimiterScanner delimiter_scanner = get_delimiter_scanner(detect_delimiter_scanner_kind());
+    return delimiter_scanner;
+}
\ No newline at end of file
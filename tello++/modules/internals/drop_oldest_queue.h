@@ -0,0 +1,123 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+template<typename Item>
+class DropOldestQueue
+{
+    public:
+        DropOldestQueue(const std::size_t &queue_capacity) :
+        items(queue_capacity)
+        {
+            if (queue_capacity == 0)
+            {
+                throw std::invalid_argument("Sorry, your queue has to hold at least one item.");
+            }
+        }
+
+        DropOldestQueue(DropOldestQueue const&) = delete;
+        void operator = (DropOldestQueue const&) = delete;
+
+        bool push(Item item)
+        {
+            bool dropped_oldest = false;
+
+            // Holds a dropped item so that it is destroyed after the lock is released.
+            Item oldest_item;
+
+            {
+                std::lock_guard<std::mutex> queue_lock(this->queue_mutex);
+
+                if (this->item_count == this->items.size())
+                {
+                    oldest_item = std::move(this->items[this->head]);
+                    this->head = (this->head + 1) % this->items.size();
+                    this->item_count--;
+                    this->dropped_count++;
+                    dropped_oldest = true;
+                }
+
+                this->items[(this->head + this->item_count) % this->items.size()] = std::move(item);
+                this->item_count++;
+            }
+
+            (void)oldest_item;
+            this->item_available.notify_one();
+
+            return !dropped_oldest;
+        }
+
+        bool pop(Item &item, const std::chrono::milliseconds &timeout)
+        {
+            std::unique_lock<std::mutex> queue_lock(this->queue_mutex);
+
+            if (!this->item_available.wait_for(queue_lock, timeout, [this] { return this->item_count > 0 || this->closed; }) || this->item_count == 0)
+            {
+                return false;
+            }
+
+            item = std::move(this->items[this->head]);
+            this->head = (this->head + 1) % this->items.size();
+            this->item_count--;
+
+            return true;
+        }
+
+        void close()
+        {
+            {
+                std::lock_guard<std::mutex> queue_lock(this->queue_mutex);
+                this->closed = true;
+            }
+
+            this->item_available.notify_all();
+        }
+
+        void clear()
+        {
+            std::lock_guard<std::mutex> queue_lock(this->queue_mutex);
+
+            while (this->item_count > 0)
+            {
+                this->items[this->head] = Item{};
+                this->head = (this->head + 1) % this->items.size();
+                this->item_count--;
+            }
+
+            this->closed = false;
+        }
+
+        std::size_t size() const
+        {
+            std::lock_guard<std::mutex> queue_lock(this->queue_mutex);
+            return this->item_count;
+        }
+
+        std::size_t capacity() const
+        {
+            return this->items.size();
+        }
+
+        std::uint64_t get_dropped_count() const
+        {
+            std::lock_guard<std::mutex> queue_lock(this->queue_mutex);
+            return this->dropped_count;
+        }
+
+    private:
+        mutable std::mutex queue_mutex;
+        std::condition_variable item_available;
+
+        std::vector<Item> items;
+        std::size_t head = 0;
+        std::size_t item_count = 0;
+        std::uint64_t dropped_count = 0;
+        bool closed = false;
+};
\ No newline at end of file
@@ -0,0 +1,242 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+class FramePool;
+
+struct Frame
+{
+    std::byte *data = nullptr;
+    std::size_t capacity = 0;
+    std::size_t size = 0;
+    std::uint64_t sequence_number = 0;
+    std::chrono::steady_clock::time_point received_at{};
+    int width = 0;
+    int height = 0;
+
+    std::span<std::byte> get_bytes()
+    {
+        return std::span<std::byte>(this->data, this->size);
+    }
+
+    std::span<const std::byte> get_bytes() const
+    {
+        return std::span<const std::byte>(this->data, this->size);
+    }
+};
+
+class FrameHandle
+{
+    public:
+        FrameHandle() = default;
+
+        FrameHandle(const FrameHandle &other) :
+        frame_pool{other.frame_pool},
+        frame_index{other.frame_index}
+        {
+            this->retain();
+        }
+
+        FrameHandle(FrameHandle &&other) noexcept :
+        frame_pool{other.frame_pool},
+        frame_index{other.frame_index}
+        {
+            other.frame_pool = nullptr;
+        }
+
+        FrameHandle &operator = (const FrameHandle &other)
+        {
+            if (this != &other)
+            {
+                FrameHandle(other).swap(*this);
+            }
+
+            return *this;
+        }
+
+        FrameHandle &operator = (FrameHandle &&other) noexcept
+        {
+            if (this != &other)
+            {
+                this->reset();
+                this->swap(other);
+            }
+
+            return *this;
+        }
+
+        ~FrameHandle()
+        {
+            this->reset();
+        }
+
+        explicit operator bool() const
+        {
+            return this->frame_pool != nullptr;
+        }
+
+        Frame &operator * () const;
+        Frame *operator -> () const;
+
+        void reset();
+
+        void swap(FrameHandle &other) noexcept
+        {
+            std::swap(this->frame_pool, other.frame_pool);
+            std::swap(this->frame_index, other.frame_index);
+        }
+
+        int get_reference_count() const;
+
+    private:
+        friend class FramePool;
+
+        FrameHandle(FramePool *frame_pool, const std::uint32_t &frame_index) :
+        frame_pool{frame_pool},
+        frame_index{frame_index}
+        {}
+
+        void retain();
+
+        FramePool *frame_pool = nullptr;
+        std::uint32_t frame_index = 0;
+};
+
+class FramePool
+{
+    public:
+        FramePool(const std::size_t &frame_count, const std::size_t &frame_capacity) :
+        frame_capacity{frame_capacity},
+        frame_storage{std::make_unique<std::byte[]>(frame_count * frame_capacity)},
+        frames(frame_count),
+        reference_counts(frame_count)
+        {
+            if (frame_count == 0 || frame_capacity == 0)
+            {
+                throw std::invalid_argument("Sorry, your frame pool needs at least one frame with room for some bytes.");
+            }
+
+            this->free_frames.reserve(frame_count);
+
+            for (std::size_t frame_index = frame_count; frame_index-- > 0;)
+            {
+                this->frames[frame_index].data = this->frame_storage.get() + (frame_index * frame_capacity);
+                this->frames[frame_index].capacity = frame_capacity;
+                this->free_frames.push_back(static_cast<std::uint32_t>(frame_index));
+            }
+        }
+
+        FramePool(FramePool const&) = delete;
+        void operator = (FramePool const&) = delete;
+
+        FrameHandle try_acquire()
+        {
+            std::lock_guard<std::mutex> free_frames_lock(this->free_frames_mutex);
+
+            if (this->free_frames.empty())
+            {
+                this->exhausted_count++;
+                return FrameHandle();
+            }
+
+            std::uint32_t frame_index = this->free_frames.back();
+            this->free_frames.pop_back();
+
+            Frame &frame = this->frames[frame_index];
+            frame.size = 0;
+            frame.width = 0;
+            frame.height = 0;
+
+            this->reference_counts[frame_index].store(1, std::memory_order_relaxed);
+
+            return FrameHandle(this, frame_index);
+        }
+
+        std::size_t get_frame_count() const
+        {
+            return this->frames.size();
+        }
+
+        std::size_t get_frame_capacity() const
+        {
+            return this->frame_capacity;
+        }
+
+        std::size_t get_free_frame_count() const
+        {
+            std::lock_guard<std::mutex> free_frames_lock(this->free_frames_mutex);
+            return this->free_frames.size();
+        }
+
+        std::uint64_t get_exhausted_count() const
+        {
+            std::lock_guard<std::mutex> free_frames_lock(this->free_frames_mutex);
+            return this->exhausted_count;
+        }
+
+    private:
+        friend class FrameHandle;
+
+        void retain(const std::uint32_t &frame_index)
+        {
+            this->reference_counts[frame_index].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void release(const std::uint32_t &frame_index)
+        {
+            if (this->reference_counts[frame_index].fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                std::lock_guard<std::mutex> free_frames_lock(this->free_frames_mutex);
+                this->free_frames.push_back(frame_index);
+            }
+        }
+
+        std::size_t frame_capacity;
+        std::unique_ptr<std::byte[]> frame_storage;
+        std::vector<Frame> frames;
+        std::vector<std::atomic<int>> reference_counts;
+
+        mutable std::mutex free_frames_mutex;
+        std::vector<std::uint32_t> free_frames;
+        std::uint64_t exhausted_count = 0;
+};
+
+inline Frame &FrameHandle::operator * () const
+{
+    return this->frame_pool->frames[this->frame_index];
+}
+
+inline Frame *FrameHandle::operator -> () const
+{
+    return &this->frame_pool->frames[this->frame_index];
+}
+
+inline void FrameHandle::reset()
+{
+    if (this->frame_pool)
+    {
+        this->frame_pool->release(this->frame_index);
+        this->frame_pool = nullptr;
+    }
+}
+
+inline void FrameHandle::retain()
+{
+    if (this->frame_pool)
+    {
+        this->frame_pool->retain(this->frame_index);
+    }
+}
+
+inline int FrameHandle::get_reference_count() const
+{
+    return this->frame_pool ? this->frame_pool->reference_counts[this->frame_index].load(std::memory_order_relaxed) : 0;
+}
\ No newline at end of file
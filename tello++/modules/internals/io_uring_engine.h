@@ -0,0 +1,466 @@
+#pragma once
+
+#if defined(TELLO_IO_URING) && defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define TELLO_IO_URING_ENGINE
+#endif
+#endif
+
+#if defined(TELLO_IO_URING_ENGINE)
+
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <linux/io_uring.h>
+#include <linux/time_types.h>
+#include <netinet/in.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "socket_util.h"
+
+class IoUringEngine
+{
+    public:
+        IoUringEngine(const unsigned &submission_queue_entries = 256, const unsigned &buffer_count = 512, const unsigned &buffer_size = 2048) :
+        buffer_count{buffer_count},
+        buffer_size{buffer_size}
+        {
+            if (buffer_count == 0 || (buffer_count & (buffer_count - 1)) != 0 || buffer_count > 32768)
+            {
+                throw std::invalid_argument("Sorry, your io_uring engine needs a power of two number of buffers, up to 32768.");
+            }
+
+            io_uring_params ring_parameters{};
+            this->ring_file = static_cast<int>(syscall(__NR_io_uring_setup, submission_queue_entries, &ring_parameters));
+
+            if (this->ring_file < 0)
+            {
+                throw_socket_error("Sorry, io_uring isn't available on this system.");
+            }
+
+            try
+            {
+                if (!(ring_parameters.features & IORING_FEAT_EXT_ARG))
+                {
+                    throw std::runtime_error("Sorry, this kernel's io_uring can't wait with a timeout.");
+                }
+
+                this->probe_operations();
+                this->map_rings(ring_parameters);
+                this->register_buffers();
+            }
+            catch(...)
+            {
+                this->release();
+                throw;
+            }
+        }
+
+        IoUringEngine(IoUringEngine const&) = delete;
+        void operator = (IoUringEngine const&) = delete;
+
+        void watch_socket(const NativeSocket &native_socket, const std::uint64_t &watch_key)
+        {
+            std::unique_ptr<WatchedSocket> watched_socket = std::make_unique<WatchedSocket>();
+            watched_socket->native_socket = native_socket;
+            watched_socket->watch_key = watch_key;
+            watched_socket->message_header.msg_namelen = sizeof(sockaddr_in);
+
+            this->watched_sockets.push_back(std::move(watched_socket));
+            this->arm_receive(this->watched_sockets.size() - 1);
+        }
+
+        template<typename CompletionHandler>
+        int poll_completions(const int &timeout_millis, CompletionHandler &&completion_handler)
+        {
+            __kernel_timespec wait_timeout{timeout_millis / 1000, static_cast<long long>(timeout_millis % 1000) * 1000000};
+            io_uring_getevents_arg wait_arguments{0, _NSIG / 8, 0, reinterpret_cast<std::uint64_t>(&wait_timeout)};
+
+            unsigned minimum_completions = this->has_completions() ? 0 : 1;
+
+            int enter_result = static_cast<int>(syscall(__NR_io_uring_enter, this->ring_file, this->get_unsubmitted_count(), minimum_completions, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &wait_arguments, sizeof(wait_arguments)));
+
+            if (enter_result < 0 && errno != EINTR && errno != ETIME && errno != EBUSY)
+            {
+                throw_socket_error("Sorry, we couldn't wait on your io_uring.");
+            }
+
+            return this->reap_completions(completion_handler);
+        }
+
+        std::uint64_t get_completion_count() const
+        {
+            return this->completion_count;
+        }
+
+        std::uint64_t get_dropped_datagram_count() const
+        {
+            return this->dropped_datagram_count;
+        }
+
+        bool has_registered_buffers() const
+        {
+            return this->buffers_registered;
+        }
+
+        bool has_failed() const
+        {
+            return this->failed;
+        }
+
+        ~IoUringEngine()
+        {
+            this->release();
+        }
+
+    private:
+        static constexpr std::uint16_t buffer_group = 0;
+        static constexpr int max_consecutive_errors = 8;
+
+        struct WatchedSocket
+        {
+            NativeSocket native_socket;
+            std::uint64_t watch_key;
+            msghdr message_header{};
+            int consecutive_errors = 0;
+        };
+
+        static constexpr std::pair<int, const char*> required_operations[]{{IORING_OP_RECVMSG, "IORING_OP_RECVMSG"}};
+
+        void probe_operations()
+        {
+            std::vector<char> probe_memory(sizeof(io_uring_probe) + IORING_OP_LAST * sizeof(io_uring_probe_op));
+            io_uring_probe *probe = reinterpret_cast<io_uring_probe*>(probe_memory.data());
+
+            if (syscall(__NR_io_uring_register, this->ring_file, IORING_REGISTER_PROBE, probe, IORING_OP_LAST) != 0)
+            {
+                throw_socket_error("Sorry, this kernel's io_uring can't tell us which operations it supports.");
+            }
+
+            for (const auto &[operation, operation_name] : required_operations)
+            {
+                if (!is_operation_supported(*probe, operation))
+                {
+                    throw std::runtime_error(format_string("Sorry, this kernel's io_uring doesn't support %s.", operation_name));
+                }
+            }
+        }
+
+        static bool is_operation_supported(const io_uring_probe &probe, const int &operation)
+        {
+            return operation <= probe.last_op && (probe.ops[operation].flags & IO_URING_OP_SUPPORTED);
+        }
+
+        void map_rings(const io_uring_params &ring_parameters)
+        {
+            this->submission_ring_size = ring_parameters.sq_off.array + ring_parameters.sq_entries * sizeof(unsigned);
+            this->completion_ring_size = ring_parameters.cq_off.cqes + ring_parameters.cq_entries * sizeof(io_uring_cqe);
+
+            if (ring_parameters.features & IORING_FEAT_SINGLE_MMAP)
+            {
+                this->submission_ring_size = this->completion_ring_size = this->submission_ring_size > this->completion_ring_size ? this->submission_ring_size : this->completion_ring_size;
+            }
+
+            this->submission_ring = this->map_memory(this->submission_ring_size, this->ring_file, IORING_OFF_SQ_RING);
+            this->completion_ring = (ring_parameters.features & IORING_FEAT_SINGLE_MMAP) ? this->submission_ring : this->map_memory(this->completion_ring_size, this->ring_file, IORING_OFF_CQ_RING);
+
+            this->submission_entries_size = ring_parameters.sq_entries * sizeof(io_uring_sqe);
+            this->submission_entries = static_cast<io_uring_sqe*>(this->map_memory(this->submission_entries_size, this->ring_file, IORING_OFF_SQES));
+
+            char *submission_ring = static_cast<char*>(this->submission_ring);
+            char *completion_ring = static_cast<char*>(this->completion_ring);
+
+            this->submission_head = reinterpret_cast<unsigned*>(submission_ring + ring_parameters.sq_off.head);
+            this->submission_tail = reinterpret_cast<unsigned*>(submission_ring + ring_parameters.sq_off.tail);
+            this->submission_mask = *reinterpret_cast<unsigned*>(submission_ring + ring_parameters.sq_off.ring_mask);
+            this->submission_entry_count = ring_parameters.sq_entries;
+
+            unsigned *submission_array = reinterpret_cast<unsigned*>(submission_ring + ring_parameters.sq_off.array);
+
+            for (unsigned entry_index = 0; entry_index < ring_parameters.sq_entries; entry_index++)
+            {
+                submission_array[entry_index] = entry_index;
+            }
+
+            this->completion_head = reinterpret_cast<unsigned*>(completion_ring + ring_parameters.cq_off.head);
+            this->completion_tail = reinterpret_cast<unsigned*>(completion_ring + ring_parameters.cq_off.tail);
+            this->completion_mask = *reinterpret_cast<unsigned*>(completion_ring + ring_parameters.cq_off.ring_mask);
+            this->completions = reinterpret_cast<io_uring_cqe*>(completion_ring + ring_parameters.cq_off.cqes);
+        }
+
+        void register_buffers()
+        {
+            this->buffer_pool_size = static_cast<std::size_t>(this->buffer_count) * this->buffer_size;
+            this->buffer_pool = static_cast<char*>(this->map_memory(this->buffer_pool_size, -1, 0));
+
+            iovec buffer_pool_vector{this->buffer_pool, this->buffer_pool_size};
+            this->buffers_registered = syscall(__NR_io_uring_register, this->ring_file, IORING_REGISTER_BUFFERS, &buffer_pool_vector, 1) == 0;
+
+            this->buffer_ring_size = this->buffer_count * sizeof(io_uring_buf);
+            this->buffer_ring = static_cast<io_uring_buf_ring*>(this->map_memory(this->buffer_ring_size, -1, 0));
+
+            io_uring_buf_reg buffer_ring_registration{};
+            buffer_ring_registration.ring_addr = reinterpret_cast<std::uint64_t>(this->buffer_ring);
+            buffer_ring_registration.ring_entries = this->buffer_count;
+            buffer_ring_registration.bgid = buffer_group;
+
+            if (syscall(__NR_io_uring_register, this->ring_file, IORING_REGISTER_PBUF_RING, &buffer_ring_registration, 1) != 0)
+            {
+                throw_socket_error("Sorry, this kernel's io_uring doesn't support provided buffer rings.");
+            }
+
+            for (unsigned buffer_id = 0; buffer_id < this->buffer_count; buffer_id++)
+            {
+                this->recycle_buffer(static_cast<std::uint16_t>(buffer_id));
+            }
+
+            this->publish_recycled_buffers();
+        }
+
+        void *map_memory(const std::size_t &size, const int &file, const std::uint64_t &offset)
+        {
+            void *mapped_memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, file == -1 ? (MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE) : (MAP_SHARED | MAP_POPULATE), file, static_cast<off_t>(offset));
+
+            if (mapped_memory == MAP_FAILED)
+            {
+                throw_socket_error("Sorry, we couldn't map your io_uring's memory.");
+            }
+
+            return mapped_memory;
+        }
+
+        io_uring_sqe &get_submission_entry()
+        {
+            unsigned tail = *this->submission_tail;
+
+            if (tail - __atomic_load_n(this->submission_head, __ATOMIC_ACQUIRE) >= this->submission_entry_count)
+            {
+                this->submit_pending();
+                tail = *this->submission_tail;
+            }
+
+            io_uring_sqe &submission_entry = this->submission_entries[tail & this->submission_mask];
+            std::memset(&submission_entry, 0, sizeof(submission_entry));
+
+            return submission_entry;
+        }
+
+        void commit_submission_entry()
+        {
+            __atomic_store_n(this->submission_tail, *this->submission_tail + 1, __ATOMIC_RELEASE);
+        }
+
+        unsigned get_unsubmitted_count() const
+        {
+            return *this->submission_tail - __atomic_load_n(this->submission_head, __ATOMIC_ACQUIRE);
+        }
+
+        void submit_pending()
+        {
+            if (syscall(__NR_io_uring_enter, this->ring_file, this->get_unsubmitted_count(), 0, 0, nullptr, 0) < 0)
+            {
+                throw_socket_error("Sorry, we couldn't submit to your io_uring.");
+            }
+        }
+
+        void arm_receive(const std::size_t &watch_index)
+        {
+            WatchedSocket &watched_socket = *this->watched_sockets[watch_index];
+            io_uring_sqe &submission_entry = this->get_submission_entry();
+
+            submission_entry.opcode = IORING_OP_RECVMSG;
+            submission_entry.fd = watched_socket.native_socket;
+            submission_entry.addr = reinterpret_cast<std::uint64_t>(&watched_socket.message_header);
+            submission_entry.flags = IOSQE_BUFFER_SELECT;
+            submission_entry.ioprio = IORING_RECV_MULTISHOT;
+            submission_entry.buf_group = buffer_group;
+            submission_entry.user_data = watch_index;
+
+            this->commit_submission_entry();
+        }
+
+        bool has_completions() const
+        {
+            return *this->completion_head != __atomic_load_n(this->completion_tail, __ATOMIC_ACQUIRE);
+        }
+
+        template<typename CompletionHandler>
+        int reap_completions(CompletionHandler &completion_handler)
+        {
+            unsigned head = *this->completion_head;
+            unsigned tail = __atomic_load_n(this->completion_tail, __ATOMIC_ACQUIRE);
+            int reaped_count = 0;
+
+            for (; head != tail; head++, reaped_count++)
+            {
+                const io_uring_cqe &completion = this->completions[head & this->completion_mask];
+                std::size_t watch_index = static_cast<std::size_t>(completion.user_data);
+                WatchedSocket &watched_socket = *this->watched_sockets[watch_index];
+
+                if (completion.flags & IORING_CQE_F_BUFFER)
+                {
+                    watched_socket.consecutive_errors = 0;
+
+                    std::uint16_t buffer_id = static_cast<std::uint16_t>(completion.flags >> IORING_CQE_BUFFER_SHIFT);
+
+                    if (completion.res >= static_cast<int>(sizeof(io_uring_recvmsg_out)))
+                    {
+                        this->dispatch_message(watched_socket, this->buffer_pool + static_cast<std::size_t>(buffer_id) * this->buffer_size, static_cast<std::size_t>(completion.res), completion_handler);
+                    }
+
+                    this->recycle_buffer(buffer_id);
+                }
+                else if (completion.res < 0 && completion.res != -ENOBUFS)
+                {
+                    this->dropped_datagram_count++;
+
+                    if (++watched_socket.consecutive_errors >= max_consecutive_errors)
+                    {
+                        this->failed = true;
+                    }
+                }
+
+                if (!(completion.flags & IORING_CQE_F_MORE) && !this->failed)
+                {
+                    this->arm_receive(watch_index);
+                }
+            }
+
+            __atomic_store_n(this->completion_head, head, __ATOMIC_RELEASE);
+            this->publish_recycled_buffers();
+            this->completion_count += reaped_count;
+
+            return reaped_count;
+        }
+
+        template<typename CompletionHandler>
+        void dispatch_message(const WatchedSocket &watched_socket, const char *buffer, const std::size_t &received_size, CompletionHandler &completion_handler)
+        {
+            io_uring_recvmsg_out message_out;
+            std::memcpy(&message_out, buffer, sizeof(message_out));
+
+            std::size_t payload_offset = sizeof(io_uring_recvmsg_out) + watched_socket.message_header.msg_namelen + watched_socket.message_header.msg_controllen;
+
+            if (payload_offset > received_size || message_out.namelen < sizeof(sockaddr_in))
+            {
+                this->dropped_datagram_count++;
+                return;
+            }
+
+            std::size_t payload_size = received_size - payload_offset < message_out.payloadlen ? received_size - payload_offset : message_out.payloadlen;
+
+            if (message_out.flags & MSG_TRUNC)
+            {
+                this->dropped_datagram_count++;
+                return;
+            }
+
+            sockaddr_in source_address;
+            std::memcpy(&source_address, buffer + sizeof(io_uring_recvmsg_out), sizeof(source_address));
+
+            completion_handler(watched_socket.watch_key, std::string_view(buffer + payload_offset, payload_size), source_address);
+        }
+
+        void recycle_buffer(const std::uint16_t &buffer_id)
+        {
+            io_uring_buf &ring_buffer = reinterpret_cast<io_uring_buf*>(this->buffer_ring)[this->buffer_ring_tail & (this->buffer_count - 1)];
+
+            ring_buffer.addr = reinterpret_cast<std::uint64_t>(this->buffer_pool + static_cast<std::size_t>(buffer_id) * this->buffer_size);
+            ring_buffer.len = this->buffer_size;
+            ring_buffer.bid = buffer_id;
+
+            this->buffer_ring_tail++;
+        }
+
+        void publish_recycled_buffers()
+        {
+            __atomic_store_n(&this->buffer_ring->tail, this->buffer_ring_tail, __ATOMIC_RELEASE);
+        }
+
+        void release()
+        {
+            if (this->ring_file >= 0)
+            {
+                close(this->ring_file);
+                this->ring_file = -1;
+            }
+
+            if (this->buffer_ring)
+            {
+                munmap(this->buffer_ring, this->buffer_ring_size);
+            }
+
+            if (this->buffer_pool)
+            {
+                munmap(this->buffer_pool, this->buffer_pool_size);
+            }
+
+            if (this->submission_entries)
+            {
+                munmap(this->submission_entries, this->submission_entries_size);
+            }
+
+            if (this->completion_ring && this->completion_ring != this->submission_ring)
+            {
+                munmap(this->completion_ring, this->completion_ring_size);
+            }
+
+            if (this->submission_ring)
+            {
+                munmap(this->submission_ring, this->submission_ring_size);
+            }
+
+            this->buffer_ring = nullptr;
+            this->buffer_pool = nullptr;
+            this->submission_entries = nullptr;
+            this->completion_ring = nullptr;
+            this->submission_ring = nullptr;
+        }
+
+        int ring_file = -1;
+
+        void *submission_ring = nullptr;
+        void *completion_ring = nullptr;
+        std::size_t submission_ring_size = 0;
+        std::size_t completion_ring_size = 0;
+
+        io_uring_sqe *submission_entries = nullptr;
+        std::size_t submission_entries_size = 0;
+        unsigned *submission_head = nullptr;
+        unsigned *submission_tail = nullptr;
+        unsigned submission_mask = 0;
+        unsigned submission_entry_count = 0;
+
+        unsigned *completion_head = nullptr;
+        unsigned *completion_tail = nullptr;
+        unsigned completion_mask = 0;
+        io_uring_cqe *completions = nullptr;
+
+        unsigned buffer_count;
+        unsigned buffer_size;
+        char *buffer_pool = nullptr;
+        std::size_t buffer_pool_size = 0;
+        bool buffers_registered = false;
+
+        io_uring_buf_ring *buffer_ring = nullptr;
+        std::size_t buffer_ring_size = 0;
+        std::uint16_t buffer_ring_tail = 0;
+
+        std::vector<std::unique_ptr<WatchedSocket>> watched_sockets;
+        std::uint64_t completion_count = 0;
+        std::uint64_t dropped_datagram_count = 0;
+        bool failed = false;
+};
+
+#endif
\ No newline at end of file
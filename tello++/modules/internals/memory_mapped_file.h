@@ -0,0 +1,202 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+class MemoryMappedFile
+{
+    public:
+        MemoryMappedFile(const std::string &file_location, const bool &writable, const std::size_t &minimum_size = 0) :
+        writable{writable}
+        {
+#if defined(_WIN32)
+            this->file = CreateFileA
+            (
+                file_location.c_str(),
+                writable ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ,
+                FILE_SHARE_READ,
+                nullptr,
+                writable ? CREATE_ALWAYS : OPEN_EXISTING,
+                FILE_ATTRIBUTE_NORMAL,
+                nullptr
+            );
+
+            if (this->file == INVALID_HANDLE_VALUE)
+            {
+                throw std::runtime_error("Sorry, we couldn't open '" + file_location + "'.");
+            }
+
+            LARGE_INTEGER file_size;
+            GetFileSizeEx(this->file, &file_size);
+            this->mapped_size = static_cast<std::size_t>(file_size.QuadPart);
+#else
+            this->file = open(file_location.c_str(), writable ? (O_RDWR | O_CREAT | O_TRUNC) : O_RDONLY, 0644);
+
+            if (this->file == -1)
+            {
+                throw std::runtime_error("Sorry, we couldn't open '" + file_location + "'.");
+            }
+
+            struct stat file_status;
+            fstat(this->file, &file_status);
+            this->mapped_size = static_cast<std::size_t>(file_status.st_size);
+#endif
+
+            try
+            {
+                this->remap(this->mapped_size > minimum_size ? this->mapped_size : minimum_size);
+            }
+            catch(...)
+            {
+                this->close_file();
+                throw;
+            }
+        }
+
+        MemoryMappedFile(MemoryMappedFile const&) = delete;
+        void operator = (MemoryMappedFile const&) = delete;
+
+        void resize(const std::size_t &new_size)
+        {
+            this->remap(new_size);
+        }
+
+        void flush()
+        {
+            if (this->mapped_data == nullptr)
+            {
+                return;
+            }
+
+#if defined(_WIN32)
+            FlushViewOfFile(this->mapped_data, this->mapped_size);
+#else
+            msync(this->mapped_data, this->mapped_size, MS_ASYNC);
+#endif
+        }
+
+        std::byte *data()
+        {
+            return this->mapped_data;
+        }
+
+        const std::byte *data() const
+        {
+            return this->mapped_data;
+        }
+
+        std::size_t size() const
+        {
+            return this->mapped_size;
+        }
+
+        ~MemoryMappedFile()
+        {
+            this->close_file();
+        }
+
+    private:
+        void close_file()
+        {
+            this->unmap();
+
+#if defined(_WIN32)
+            if (this->file_mapping != nullptr)
+            {
+                CloseHandle(this->file_mapping);
+                this->file_mapping = nullptr;
+            }
+
+            CloseHandle(this->file);
+#else
+            close(this->file);
+#endif
+        }
+
+        void unmap()
+        {
+            if (this->mapped_data == nullptr)
+            {
+                return;
+            }
+
+#if defined(_WIN32)
+            UnmapViewOfFile(this->mapped_data);
+            CloseHandle(this->file_mapping);
+            this->file_mapping = nullptr;
+#else
+            munmap(this->mapped_data, this->mapped_size);
+#endif
+
+            this->mapped_data = nullptr;
+        }
+
+        void remap(const std::size_t &new_size)
+        {
+            this->unmap();
+            this->mapped_size = new_size;
+
+            if (new_size == 0)
+            {
+                return;
+            }
+
+#if defined(_WIN32)
+            LARGE_INTEGER file_size;
+            file_size.QuadPart = static_cast<LONGLONG>(new_size);
+
+            if (this->writable && (!SetFilePointerEx(this->file, file_size, nullptr, FILE_BEGIN) || !SetEndOfFile(this->file)))
+            {
+                throw std::runtime_error("Sorry, we couldn't resize your memory mapped file.");
+            }
+
+            this->file_mapping = CreateFileMappingA(this->file, nullptr, this->writable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+
+            if (this->file_mapping == nullptr)
+            {
+                throw std::runtime_error("Sorry, we couldn't map your file into memory.");
+            }
+
+            this->mapped_data = static_cast<std::byte*>(MapViewOfFile(this->file_mapping, this->writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, new_size));
+#else
+            if (this->writable && ftruncate(this->file, static_cast<off_t>(new_size)) == -1)
+            {
+                throw std::runtime_error("Sorry, we couldn't resize your memory mapped file.");
+            }
+
+            void *mapped_data = mmap(nullptr, new_size, this->writable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, this->file, 0);
+            this->mapped_data = mapped_data == MAP_FAILED ? nullptr : static_cast<std::byte*>(mapped_data);
+#endif
+
+            if (this->mapped_data == nullptr)
+            {
+                throw std::runtime_error("Sorry, we couldn't map your file into memory.");
+            }
+        }
+
+        bool writable;
+
+#if defined(_WIN32)
+        HANDLE file = INVALID_HANDLE_VALUE;
+        HANDLE file_mapping = nullptr;
+#else
+        int file = -1;
+#endif
+
+        std::byte *mapped_data = nullptr;
+        std::size_t mapped_size = 0;
+};
\ No newline at end of file
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+template<typename Value>
+class SeqLock
+{
+    static_assert(std::is_trivially_copyable_v<Value>, "SeqLock values are copied byte by byte.");
+
+    public:
+        void store(const Value &value)
+        {
+            std::uint64_t current_sequence = this->sequence.load(std::memory_order_relaxed);
+
+            this->sequence.store(current_sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            std::memcpy(&this->value, &value, sizeof(Value));
+
+            this->sequence.store(current_sequence + 2, std::memory_order_release);
+        }
+
+        bool load(Value &value) const
+        {
+            while (true)
+            {
+                std::uint64_t sequence_before = this->sequence.load(std::memory_order_acquire);
+
+                if (sequence_before == 0)
+                {
+                    return false;
+                }
+
+                if (sequence_before & 1)
+                {
+                    continue;
+                }
+
+                std::memcpy(&value, &this->value, sizeof(Value));
+                std::atomic_thread_fence(std::memory_order_acquire);
+
+                if (this->sequence.load(std::memory_order_relaxed) == sequence_before)
+                {
+                    return true;
+                }
+            }
+        }
+
+        std::uint64_t get_version() const
+        {
+            return this->sequence.load(std::memory_order_acquire) / 2;
+        }
+
+    private:
+        alignas(64) std::atomic<std::uint64_t> sequence{0};
+        Value value{};
+};
\ No newline at end of file
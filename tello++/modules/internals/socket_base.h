@@ -1,5 +1,7 @@
 #pragma once
 
+#if defined(_WIN32)
+
 #undef NTDDI_VERSION
 #undef WINVER
 #undef _WIN32_WINNT
@@ -9,6 +11,90 @@
 #define _WIN32_WINNT _WIN32_WINNT_VISTA
 
 #include <WS2tcpip.h>
+
+using NativeSocket = SOCKET;
+using SocketLength = int;
+
+constexpr NativeSocket invalid_native_socket = INVALID_SOCKET;
+constexpr int native_socket_error = SOCKET_ERROR;
+
+inline int get_last_socket_error()
+{
+    return WSAGetLastError();
+}
+
+inline int close_native_socket(NativeSocket native_socket)
+{
+    return closesocket(native_socket);
+}
+
+inline int set_native_socket_non_blocking(NativeSocket native_socket, bool non_blocking)
+{
+    u_long non_blocking_mode = non_blocking ? 1 : 0;
+    return ioctlsocket(native_socket, FIONBIO, &non_blocking_mode);
+}
+
+inline bool is_socket_would_block(int socket_error)
+{
+    return socket_error == WSAEWOULDBLOCK || socket_error == WSAETIMEDOUT;
+}
+
+inline int poll_native_sockets(pollfd *watched_sockets, unsigned long watched_socket_count, int timeout_millis)
+{
+    return WSAPoll(watched_sockets, watched_socket_count, timeout_millis);
+}
+
+#else
+
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+using NativeSocket = int;
+using SocketLength = socklen_t;
+
+constexpr NativeSocket invalid_native_socket = -1;
+constexpr int native_socket_error = -1;
+
+inline int get_last_socket_error()
+{
+    return errno;
+}
+
+inline int close_native_socket(NativeSocket native_socket)
+{
+    return close(native_socket);
+}
+
+inline int set_native_socket_non_blocking(NativeSocket native_socket, bool non_blocking)
+{
+    int socket_flags = fcntl(native_socket, F_GETFL, 0);
+
+    if (socket_flags == -1)
+    {
+        return -1;
+    }
+
+    return fcntl(native_socket, F_SETFL, non_blocking ? (socket_flags | O_NONBLOCK) : (socket_flags & ~O_NONBLOCK));
+}
+
+inline bool is_socket_would_block(int socket_error)
+{
+    return socket_error == EAGAIN || socket_error == EWOULDBLOCK;
+}
+
+inline int poll_native_sockets(pollfd *watched_sockets, unsigned long watched_socket_count, int timeout_millis)
+{
+    return poll(watched_sockets, static_cast<nfds_t>(watched_socket_count), timeout_millis);
+}
+
+#endif
+
 #include <stdexcept>
 
 class SocketBase 
@@ -24,6 +110,7 @@ class SocketBase
         void operator = (SocketBase const&) = delete;
 
     private:
+#if defined(_WIN32)
         SocketBase() 
         {
             WSADATA winsock_data;
@@ -41,4 +128,8 @@ class SocketBase
         {
             WSACleanup();
         }
+#else
+        SocketBase() = default;
+        ~SocketBase() = default;
+#endif
 };
\ No newline at end of file
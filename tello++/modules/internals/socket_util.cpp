@@ -0,0 +1,52 @@
+#include "socket_util.h"
+
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+
+void throw_socket_error(std::string error_message) 
+{
+#if defined(_WIN32)
+    throw std::runtime_error(format_string("%s Winsock Error Code: '%i'", error_message.c_str(), get_last_socket_error()));
+#else
+    int socket_error = get_last_socket_error();
+    throw std::runtime_error(format_string("%s Socket Error: '%s' (%i)", error_message.c_str(), std::strerror(socket_error), socket_error));
+#endif
+}
+
+int set_socket_timeout(const NativeSocket &native_socket, const int &timeout_option, const int &timeout_millis) 
+{
+#if defined(_WIN32)
+    DWORD socket_timeout = timeout_millis;
+#else
+    timeval socket_timeout{timeout_millis / 1000, (timeout_millis % 1000) * 1000};
+#endif
+
+    return setsockopt(native_socket, SOL_SOCKET, timeout_option, (char*)&socket_timeout, sizeof(socket_timeout));
+}
+
+in_addr encode_ip_address(const int &ip_address_family, const std::string &ip_address) 
+{    
+    in_addr converted_ip_address;
+    inet_pton(ip_address_family, ip_address.c_str(), &converted_ip_address);
+    return converted_ip_address;
+}
+
+sockaddr_in make_socket_address(const std::string &ip_address, const int &port) 
+{
+    sockaddr_in socket_address;
+    std::memset(&socket_address, 0, sizeof(socket_address));
+
+    socket_address.sin_family = AF_INET;
+    socket_address.sin_port = htons(port);
+    socket_address.sin_addr = encode_ip_address(AF_INET, ip_address);
+
+    return socket_address;
+}
+
+std::string decode_ip_address(const int &ip_address_family, in_addr &to_decode, const int &buffer_size) 
+{
+    std::unique_ptr<char[]> decoded_client_ip = std::make_unique<char[]>(buffer_size);
+    inet_ntop(ip_address_family, &to_decode, decoded_client_ip.get(), buffer_size);
+    return decoded_client_ip.get(); 
+}
\ No newline at end of file
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "socket_base.h"
+#include "util.h"
+
+#include <string>
+
+void throw_socket_error(std::string error_message);
+
+int set_socket_timeout(const NativeSocket &native_socket, const int &timeout_option, const int &timeout_millis);
+
+in_addr encode_ip_address(const int &ip_address_family, const std::string &ip_address);
+
+sockaddr_in make_socket_address(const std::string &ip_address, const int &port);
+
+std::string decode_ip_address(const int &ip_address_family, in_addr &to_decode, const int &buffer_size);
\ No newline at end of file
@@ -0,0 +1,35 @@
+#include "util.h"
+
+std::string_view left_strip(std::string_view to_strip) 
+{
+    std::size_t strip_begin = 0;
+
+    while (strip_begin < to_strip.size() && is_whitespace(to_strip[strip_begin])) 
+    {
+        strip_begin++;
+    }
+
+    return to_strip.substr(strip_begin);
+}
+
+std::string_view right_strip(std::string_view to_strip) 
+{
+    std::size_t strip_end = to_strip.size();
+
+    while (strip_end > 0 && is_whitespace(to_strip[strip_end - 1])) 
+    {
+        strip_end--;
+    }
+
+    return to_strip.substr(0, strip_end);
+}
+
+std::string_view strip(std::string_view to_strip) 
+{
+    return left_strip(right_strip(to_strip));
+}
+
+template std::string_view parse_number_with_units<int>(std::string_view to_parse, int &number);
+template std::string_view parse_number_with_units<float>(std::string_view to_parse, float &number);
+template int parse_keyed_number<int>(std::string_view to_parse, std::string_view key);
+template float parse_keyed_number<float>(std::string_view to_parse, std::string_view key);
\ No newline at end of file
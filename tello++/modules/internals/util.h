@@ -2,12 +2,12 @@
 
 #define get_variable_name(name) #name
 
-#include "socket_base.h"
+#include <charconv>
+#include <cstdio>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <memory>
-#include <regex>
-
-static const std::string whitespace = "";
 
 template<typename ... Args>
 std::string format_string(const std::string &to_be_formatted, Args ...arguments)
@@ -27,36 +27,52 @@ std::string format_string(const std::string &to_be_formatted, Args ...arguments)
     return std::string(string_buffer.get()); 
 }
 
-std::string left_strip(const std::string &to_strip) 
+inline bool is_whitespace(const char &character) 
 {
-    return std::regex_replace(to_strip, std::regex(R"(^\s+)"), whitespace);
+    return character == ' ' || (character >= '\t' && character <= '\r');
 }
 
-std::string right_strip(const std::string &to_strip) 
-{
-    return std::regex_replace(to_strip, std::regex(R"(\s+$)"), whitespace);
-}
+std::string_view left_strip(std::string_view to_strip);
+std::string_view right_strip(std::string_view to_strip);
+std::string_view strip(std::string_view to_strip);
 
-std::string strip(const std::string &to_strip) 
+template<typename Number>
+std::string_view parse_number_with_units(std::string_view to_parse, Number &number) 
 {
-    return left_strip(right_strip(to_strip));
+    const char *to_parse_end = to_parse.data() + to_parse.size();
+    std::from_chars_result parse_result = std::from_chars(to_parse.data(), to_parse_end, number);
+
+    if (parse_result.ec != std::errc{}) 
+    {
+        throw std::runtime_error(format_string("Sorry, we couldn't read a number from '%.*s'.", static_cast<int>(to_parse.size()), to_parse.data()));
+    }
+
+    return std::string_view(parse_result.ptr, to_parse_end - parse_result.ptr);
 }
 
-void throw_winsock_error(std::string error_message) 
+template<typename Number>
+Number parse_keyed_number(std::string_view to_parse, std::string_view key) 
 {
-    throw std::runtime_error(format_string("%s Winsock Error Code: '%i'", error_message.c_str(), WSAGetLastError()));
-}
+    std::size_t key_position = 0;
+
+    while ((key_position = to_parse.find(key, key_position)) != std::string_view::npos) 
+    {
+        std::size_t value_position = key_position + key.size();
+
+        if ((key_position == 0 || to_parse[key_position - 1] == ';') && value_position < to_parse.size() && to_parse[value_position] == ':') 
+        {
+            Number number;
+            parse_number_with_units(to_parse.substr(value_position + 1), number);
+            return number;
+        }
 
-IN_ADDR encode_ip_address(const INT &ip_address_family, const std::string &ip_address) 
-{    
-    IN_ADDR converted_ip_address;
-    inet_pton(ip_address_family, ip_address.c_str(), &converted_ip_address);
-    return converted_ip_address;
+        key_position = value_position;
+    }
+
+    throw std::runtime_error(format_string("Sorry, we couldn't find '%.*s' in '%.*s'.", static_cast<int>(key.size()), key.data(), static_cast<int>(to_parse.size()), to_parse.data()));
 }
 
-std::string decode_ip_address(const INT &ip_address_family, IN_ADDR &to_decode, const int &buffer_size) 
-{
-    std::unique_ptr<char[]> decoded_client_ip = std::make_unique<char[]>(buffer_size);
-    inet_ntop(ip_address_family, &to_decode, decoded_client_ip.get(), buffer_size);
-    return decoded_client_ip.get(); 
-}
\ No newline at end of file
+extern template std::string_view parse_number_with_units<int>(std::string_view to_parse, int &number);
+extern template std::string_view parse_number_with_units<float>(std::string_view to_parse, float &number);
+extern template int parse_keyed_number<int>(std::string_view to_parse, std::string_view key);
+extern template float parse_keyed_number<float>(std::string_view to_parse, std::string_view key);
\ No newline at end of file
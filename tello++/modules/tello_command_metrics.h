@@ -0,0 +1,428 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "internals/util.h"
+
+#include "tello_commands.h"
+
+class LatencyHistogram
+{
+    public:
+        static constexpr int sub_bucket_bits = 6;
+        static constexpr std::uint64_t sub_bucket_count = 1ull << sub_bucket_bits;
+        static constexpr std::uint64_t sub_bucket_half_count = sub_bucket_count / 2;
+        static constexpr int max_magnitude = 36;
+        static constexpr std::uint64_t max_trackable_micros = (1ull << (max_magnitude + 1)) - 1;
+        static constexpr std::size_t bucket_count = sub_bucket_count + (max_magnitude - sub_bucket_bits + 1) * sub_bucket_half_count;
+
+        LatencyHistogram() = default;
+
+        LatencyHistogram(LatencyHistogram const&) = delete;
+        void operator = (LatencyHistogram const&) = delete;
+
+        void record(const std::uint64_t &latency_micros)
+        {
+            std::uint64_t clamped_micros = latency_micros < max_trackable_micros ? latency_micros : max_trackable_micros;
+
+            this->buckets[get_bucket_index(clamped_micros)].fetch_add(1, std::memory_order_relaxed);
+            this->total_count.fetch_add(1, std::memory_order_relaxed);
+            this->total_micros.fetch_add(clamped_micros, std::memory_order_relaxed);
+
+            std::uint64_t min_micros = this->min_micros.load(std::memory_order_relaxed);
+
+            while (clamped_micros < min_micros && !this->min_micros.compare_exchange_weak(min_micros, clamped_micros, std::memory_order_relaxed))
+            {
+
+            }
+
+            std::uint64_t max_micros = this->max_micros.load(std::memory_order_relaxed);
+
+            while (clamped_micros > max_micros && !this->max_micros.compare_exchange_weak(max_micros, clamped_micros, std::memory_order_relaxed))
+            {
+
+            }
+        }
+
+        std::uint64_t get_count() const
+        {
+            return this->total_count.load(std::memory_order_relaxed);
+        }
+
+        std::uint64_t get_min_micros() const
+        {
+            return this->get_count() > 0 ? this->min_micros.load(std::memory_order_relaxed) : 0;
+        }
+
+        std::uint64_t get_max_micros() const
+        {
+            return this->max_micros.load(std::memory_order_relaxed);
+        }
+
+        double get_mean_micros() const
+        {
+            std::uint64_t count = this->get_count();
+            return count > 0 ? static_cast<double>(this->total_micros.load(std::memory_order_relaxed)) / count : 0;
+        }
+
+        std::uint64_t get_sum_micros() const
+        {
+            return this->total_micros.load(std::memory_order_relaxed);
+        }
+
+        std::uint64_t get_value_at_percentile(const double &percentile) const
+        {
+            std::uint64_t count = this->get_count();
+
+            if (count == 0)
+            {
+                return 0;
+            }
+
+            double clamped_percentile = percentile < 0 ? 0 : (percentile > 100 ? 100 : percentile);
+            std::uint64_t target_count = static_cast<std::uint64_t>((clamped_percentile / 100) * count + 0.5);
+            target_count = target_count > 0 ? target_count : 1;
+
+            std::uint64_t seen_count = 0;
+
+            for (std::size_t bucket_index = 0; bucket_index < bucket_count; bucket_index++)
+            {
+                seen_count += this->buckets[bucket_index].load(std::memory_order_relaxed);
+
+                if (seen_count >= target_count)
+                {
+                    std::uint64_t highest_equivalent_micros = get_highest_equivalent_value(bucket_index);
+                    std::uint64_t max_micros = this->get_max_micros();
+
+                    return highest_equivalent_micros < max_micros ? highest_equivalent_micros : max_micros;
+                }
+            }
+
+            return this->get_max_micros();
+        }
+
+        void reset()
+        {
+            for (std::atomic<std::uint64_t> &bucket : this->buckets)
+            {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+
+            this->total_count.store(0, std::memory_order_relaxed);
+            this->total_micros.store(0, std::memory_order_relaxed);
+            this->min_micros.store(UINT64_MAX, std::memory_order_relaxed);
+            this->max_micros.store(0, std::memory_order_relaxed);
+        }
+
+        static std::size_t get_bucket_index(const std::uint64_t &value_micros)
+        {
+            if (value_micros < sub_bucket_count)
+            {
+                return static_cast<std::size_t>(value_micros);
+            }
+
+            int magnitude = std::bit_width(value_micros) - 1;
+            std::uint64_t sub_bucket = value_micros >> (magnitude - sub_bucket_bits + 1);
+
+            return static_cast<std::size_t>(sub_bucket_count + (magnitude - sub_bucket_bits) * sub_bucket_half_count + (sub_bucket - sub_bucket_half_count));
+        }
+
+        static std::uint64_t get_highest_equivalent_value(const std::size_t &bucket_index)
+        {
+            if (bucket_index < sub_bucket_count)
+            {
+                return bucket_index;
+            }
+
+            std::uint64_t offset = bucket_index - sub_bucket_count;
+            int magnitude = static_cast<int>(offset / sub_bucket_half_count) + sub_bucket_bits;
+            std::uint64_t sub_bucket = (offset % sub_bucket_half_count) + sub_bucket_half_count;
+            int shift = magnitude - sub_bucket_bits + 1;
+
+            return ((sub_bucket + 1) << shift) - 1;
+        }
+
+    private:
+        std::array<std::atomic<std::uint64_t>, bucket_count> buckets{};
+        std::atomic<std::uint64_t> total_count{0};
+        std::atomic<std::uint64_t> total_micros{0};
+        std::atomic<std::uint64_t> min_micros{UINT64_MAX};
+        std::atomic<std::uint64_t> max_micros{0};
+};
+
+struct TelloCommandStatistics
+{
+    std::string_view command_name;
+    std::uint64_t sent_count;
+    std::uint64_t response_count;
+    std::uint64_t timeout_count;
+    std::uint64_t error_count;
+    std::chrono::steady_clock::time_point last_sent_at;
+    std::chrono::steady_clock::time_point last_response_at;
+    std::uint64_t min_latency_micros;
+    double mean_latency_micros;
+    std::uint64_t p50_latency_micros;
+    std::uint64_t p90_latency_micros;
+    std::uint64_t p99_latency_micros;
+    std::uint64_t p999_latency_micros;
+    std::uint64_t max_latency_micros;
+};
+
+class TelloCommandMetrics
+{
+    public:
+        static constexpr std::array<std::string_view, 31> command_names
+        {
+            TelloCommands::Command::command_name,
+            TelloCommands::Takeoff::command_name,
+            TelloCommands::Land::command_name,
+            TelloCommands::Emergency::command_name,
+            TelloCommands::Up::command_name,
+            TelloCommands::Down::command_name,
+            TelloCommands::Left::command_name,
+            TelloCommands::Right::command_name,
+            TelloCommands::Forward::command_name,
+            TelloCommands::Back::command_name,
+            TelloCommands::Clockwise::command_name,
+            TelloCommands::Counterclockwise::command_name,
+            "flip",
+            TelloCommands::Go::command_name,
+            TelloCommands::Curve::command_name,
+            TelloCommands::Speed::command_name,
+            TelloCommands::RemoteControl::command_name,
+            "wifi",
+            "streamon",
+            "streamoff",
+            TelloCommands::SpeedQuery::command_name,
+            TelloCommands::BatteryQuery::command_name,
+            TelloCommands::TimeQuery::command_name,
+            TelloCommands::HeightQuery::command_name,
+            TelloCommands::TempratureQuery::command_name,
+            TelloCommands::AttitudeQuery::command_name,
+            TelloCommands::BarometerQuery::command_name,
+            TelloCommands::AccelerationQuery::command_name,
+            TelloCommands::DistanceFromTakeoffQuery::command_name,
+            TelloCommands::WifiQuery::command_name,
+            "other"
+        };
+
+        TelloCommandMetrics() :
+        command_slots{std::make_unique<CommandSlot[]>(command_names.size())}
+        {}
+
+        TelloCommandMetrics(TelloCommandMetrics const&) = delete;
+        void operator = (TelloCommandMetrics const&) = delete;
+
+        static std::size_t get_command_index(std::string_view command)
+        {
+            std::string_view command_name = command.substr(0, command.find(' '));
+
+            for (std::size_t command_index = 0; command_index + 1 < command_names.size(); command_index++)
+            {
+                if (command_names[command_index] == command_name)
+                {
+                    return command_index;
+                }
+            }
+
+            return command_names.size() - 1;
+        }
+
+        std::chrono::steady_clock::time_point record_sent(std::string_view command)
+        {
+            std::chrono::steady_clock::time_point sent_at = std::chrono::steady_clock::now();
+            CommandSlot &command_slot = this->command_slots[get_command_index(command)];
+
+            command_slot.sent_count.fetch_add(1, std::memory_order_relaxed);
+            command_slot.last_sent_nanos.store(sent_at.time_since_epoch().count(), std::memory_order_relaxed);
+
+            return sent_at;
+        }
+
+        void record_response(std::string_view command, const std::chrono::steady_clock::time_point &sent_at, std::string_view response)
+        {
+            std::chrono::steady_clock::time_point responded_at = std::chrono::steady_clock::now();
+            CommandSlot &command_slot = this->command_slots[get_command_index(command)];
+
+            command_slot.response_count.fetch_add(1, std::memory_order_relaxed);
+            command_slot.last_response_nanos.store(responded_at.time_since_epoch().count(), std::memory_order_relaxed);
+            command_slot.latency_histogram.record(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(responded_at - sent_at).count()));
+
+            if (response.substr(0, 5) == "error")
+            {
+                command_slot.error_count.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        void record_timeout(std::string_view command)
+        {
+            this->command_slots[get_command_index(command)].timeout_count.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void record_error(std::string_view command)
+        {
+            this->command_slots[get_command_index(command)].error_count.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        const LatencyHistogram &get_latency_histogram(std::string_view command) const
+        {
+            return this->command_slots[get_command_index(command)].latency_histogram;
+        }
+
+        TelloCommandStatistics get_command_statistics(std::string_view command) const
+        {
+            std::size_t command_index = get_command_index(command);
+            const CommandSlot &command_slot = this->command_slots[command_index];
+            const LatencyHistogram &latency_histogram = command_slot.latency_histogram;
+
+            return TelloCommandStatistics
+            {
+                command_names[command_index],
+                command_slot.sent_count.load(std::memory_order_relaxed),
+                command_slot.response_count.load(std::memory_order_relaxed),
+                command_slot.timeout_count.load(std::memory_order_relaxed),
+                command_slot.error_count.load(std::memory_order_relaxed),
+                std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(command_slot.last_sent_nanos.load(std::memory_order_relaxed))),
+                std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(command_slot.last_response_nanos.load(std::memory_order_relaxed))),
+                latency_histogram.get_min_micros(),
+                latency_histogram.get_mean_micros(),
+                latency_histogram.get_value_at_percentile(50),
+                latency_histogram.get_value_at_percentile(90),
+                latency_histogram.get_value_at_percentile(99),
+                latency_histogram.get_value_at_percentile(99.9),
+                latency_histogram.get_max_micros()
+            };
+        }
+
+        std::vector<TelloCommandStatistics> get_all_command_statistics() const
+        {
+            std::vector<TelloCommandStatistics> all_command_statistics;
+
+            for (std::size_t command_index = 0; command_index < command_names.size(); command_index++)
+            {
+                if (this->command_slots[command_index].sent_count.load(std::memory_order_relaxed) > 0)
+                {
+                    all_command_statistics.push_back(this->get_command_statistics(command_names[command_index]));
+                }
+            }
+
+            return all_command_statistics;
+        }
+
+        std::string to_prometheus_text() const
+        {
+            std::vector<TelloCommandStatistics> all_command_statistics = this->get_all_command_statistics();
+            std::string prometheus_text;
+
+            prometheus_text += "# HELP tello_command_latency_seconds Time between sending a Tello SDK command and receiving its response.\n";
+            prometheus_text += "# TYPE tello_command_latency_seconds summary\n";
+
+            for (const TelloCommandStatistics &command_statistics : all_command_statistics)
+            {
+                const LatencyHistogram &latency_histogram = this->get_latency_histogram(command_statistics.command_name);
+                int name_size = static_cast<int>(command_statistics.command_name.size());
+                const char *name = command_statistics.command_name.data();
+
+                if (latency_histogram.get_count() > 0)
+                {
+                    prometheus_text += format_string("tello_command_latency_seconds{command=\"%.*s\",quantile=\"0.5\"} %.6f\n", name_size, name, command_statistics.p50_latency_micros / 1e6);
+                    prometheus_text += format_string("tello_command_latency_seconds{command=\"%.*s\",quantile=\"0.9\"} %.6f\n", name_size, name, command_statistics.p90_latency_micros / 1e6);
+                    prometheus_text += format_string("tello_command_latency_seconds{command=\"%.*s\",quantile=\"0.99\"} %.6f\n", name_size, name, command_statistics.p99_latency_micros / 1e6);
+                    prometheus_text += format_string("tello_command_latency_seconds{command=\"%.*s\",quantile=\"0.999\"} %.6f\n", name_size, name, command_statistics.p999_latency_micros / 1e6);
+                }
+
+                prometheus_text += format_string("tello_command_latency_seconds_sum{command=\"%.*s\"} %.6f\n", name_size, name, latency_histogram.get_sum_micros() / 1e6);
+                prometheus_text += format_string("tello_command_latency_seconds_count{command=\"%.*s\"} %llu\n", name_size, name, static_cast<unsigned long long>(latency_histogram.get_count()));
+            }
+
+            append_prometheus_counter(prometheus_text, all_command_statistics, "tello_commands_sent_total", "Tello SDK commands sent.", &TelloCommandStatistics::sent_count);
+            append_prometheus_counter(prometheus_text, all_command_statistics, "tello_command_responses_total", "Responses received for Tello SDK commands.", &TelloCommandStatistics::response_count);
+            append_prometheus_counter(prometheus_text, all_command_statistics, "tello_command_timeouts_total", "Tello SDK commands that timed out before a response.", &TelloCommandStatistics::timeout_count);
+            append_prometheus_counter(prometheus_text, all_command_statistics, "tello_command_errors_total", "Tello SDK commands that failed or were answered with an error.", &TelloCommandStatistics::error_count);
+
+            return prometheus_text;
+        }
+
+        std::string to_json() const
+        {
+            std::string json = "{\"commands\":[";
+            bool first_command = true;
+
+            for (const TelloCommandStatistics &command_statistics : this->get_all_command_statistics())
+            {
+                json += first_command ? "" : ",";
+                first_command = false;
+
+                json += format_string
+                (
+                    "{\"command\":\"%.*s\",\"sent\":%llu,\"responses\":%llu,\"timeouts\":%llu,\"errors\":%llu,\"latency_micros\":{\"min\":%llu,\"mean\":%.1f,\"p50\":%llu,\"p90\":%llu,\"p99\":%llu,\"p999\":%llu,\"max\":%llu}}",
+                    static_cast<int>(command_statistics.command_name.size()), command_statistics.command_name.data(),
+                    static_cast<unsigned long long>(command_statistics.sent_count),
+                    static_cast<unsigned long long>(command_statistics.response_count),
+                    static_cast<unsigned long long>(command_statistics.timeout_count),
+                    static_cast<unsigned long long>(command_statistics.error_count),
+                    static_cast<unsigned long long>(command_statistics.min_latency_micros),
+                    command_statistics.mean_latency_micros,
+                    static_cast<unsigned long long>(command_statistics.p50_latency_micros),
+                    static_cast<unsigned long long>(command_statistics.p90_latency_micros),
+                    static_cast<unsigned long long>(command_statistics.p99_latency_micros),
+                    static_cast<unsigned long long>(command_statistics.p999_latency_micros),
+                    static_cast<unsigned long long>(command_statistics.max_latency_micros)
+                );
+            }
+
+            return json + "]}";
+        }
+
+        void reset()
+        {
+            for (std::size_t command_index = 0; command_index < command_names.size(); command_index++)
+            {
+                CommandSlot &command_slot = this->command_slots[command_index];
+
+                command_slot.sent_count.store(0, std::memory_order_relaxed);
+                command_slot.response_count.store(0, std::memory_order_relaxed);
+                command_slot.timeout_count.store(0, std::memory_order_relaxed);
+                command_slot.error_count.store(0, std::memory_order_relaxed);
+                command_slot.latency_histogram.reset();
+            }
+        }
+
+    private:
+        struct CommandSlot
+        {
+            std::atomic<std::uint64_t> sent_count{0};
+            std::atomic<std::uint64_t> response_count{0};
+            std::atomic<std::uint64_t> timeout_count{0};
+            std::atomic<std::uint64_t> error_count{0};
+            std::atomic<std::int64_t> last_sent_nanos{0};
+            std::atomic<std::int64_t> last_response_nanos{0};
+            LatencyHistogram latency_histogram;
+        };
+
+        static void append_prometheus_counter(std::string &prometheus_text, const std::vector<TelloCommandStatistics> &all_command_statistics, const char *metric_name, const char *metric_help, std::uint64_t TelloCommandStatistics::*counter)
+        {
+            prometheus_text += format_string("# HELP %s %s\n# TYPE %s counter\n", metric_name, metric_help, metric_name);
+
+            for (const TelloCommandStatistics &command_statistics : all_command_statistics)
+            {
+                prometheus_text += format_string
+                (
+                    "%s{command=\"%.*s\"} %llu\n",
+                    metric_name,
+                    static_cast<int>(command_statistics.command_name.size()), command_statistics.command_name.data(),
+                    static_cast<unsigned long long>(command_statistics.*counter)
+                );
+            }
+        }
+
+        std::unique_ptr<CommandSlot[]> command_slots;
+};
\ No newline at end of file
@@ -0,0 +1,349 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "internals/util.h"
+
+#include "tello_command_metrics.h"
+#include "tello_reliable_commands.h"
+#include "tello_rtt_estimator.h"
+#include "tello_socket.h"
+
+class TelloCommandPipeline
+{
+    public:
+        TelloCommandPipeline(TelloSocket &tello_client, const int &poll_timeout_millis = 20) :
+        tello_client{tello_client},
+        poll_timeout_millis{poll_timeout_millis},
+        blocking_timeout_millis{tello_client.get_receive_timeout()}
+        {}
+
+        TelloCommandPipeline(TelloCommandPipeline const&) = delete;
+        void operator = (TelloCommandPipeline const&) = delete;
+
+        void start()
+        {
+            std::lock_guard<std::mutex> lifecycle_lock(this->lifecycle_mutex);
+
+            if (this->running.load(std::memory_order_relaxed))
+            {
+                return;
+            }
+
+            this->blocking_timeout_millis = this->tello_client.get_receive_timeout();
+            this->tello_client.set_receive_timeout(this->poll_timeout_millis);
+
+            this->running.store(true, std::memory_order_release);
+            this->receiver_thread = std::thread(&TelloCommandPipeline::receive_responses, this);
+        }
+
+        void stop()
+        {
+            std::lock_guard<std::mutex> lifecycle_lock(this->lifecycle_mutex);
+
+            if (!this->running.exchange(false))
+            {
+                return;
+            }
+
+            this->receiver_thread.join();
+            this->tello_client.set_receive_timeout(this->blocking_timeout_millis);
+
+            std::lock_guard<std::mutex> pending_lock(this->pending_mutex);
+
+            while (!this->pending_commands.empty())
+            {
+                this->fail_command(this->pending_commands.front(), "Sorry, the command pipeline stopped before your Tello responded to '%s'.");
+                this->pending_commands.pop_front();
+            }
+        }
+
+        bool is_running() const
+        {
+            return this->running.load(std::memory_order_acquire);
+        }
+
+        int get_default_response_timeout() const
+        {
+            return this->blocking_timeout_millis;
+        }
+
+        void set_command_metrics(TelloCommandMetrics *command_metrics)
+        {
+            std::lock_guard<std::mutex> pending_lock(this->pending_mutex);
+            this->command_metrics = command_metrics;
+        }
+
+        std::future<std::string> send_command(std::string_view to_send, const std::chrono::milliseconds &response_timeout, const int &max_retransmissions = 0)
+        {
+            std::lock_guard<std::mutex> pending_lock(this->pending_mutex);
+
+            auto sent_at = this->command_metrics ? this->command_metrics->record_sent(to_send) : std::chrono::steady_clock::now();
+
+            this->pending_commands.push_back
+            (
+                PendingCommand
+                {
+                    std::string(to_send), 
+                    std::promise<std::string>{}, 
+                    sent_at, 
+                    sent_at + response_timeout, 
+                    sent_at + this->rtt_estimator.get_retransmission_timeout(), 
+                    max_retransmissions, 
+                    {sent_at}
+                }
+            );
+            std::future<std::string> response = this->pending_commands.back().response.get_future();
+
+            try
+            {
+                this->tello_client.send_data(to_send);
+            }
+            catch(...)
+            {
+                if (this->command_metrics)
+                {
+                    this->command_metrics->record_error(to_send);
+                }
+
+                this->pending_commands.pop_back();
+                throw;
+            }
+
+            return response;
+        }
+
+        std::size_t get_pending_command_count() const
+        {
+            std::lock_guard<std::mutex> pending_lock(this->pending_mutex);
+            return this->pending_commands.size();
+        }
+
+        const TelloRttEstimator &get_rtt_estimator() const
+        {
+            return this->rtt_estimator;
+        }
+
+        std::uint64_t get_retransmission_count() const
+        {
+            return this->retransmissions.load(std::memory_order_relaxed);
+        }
+
+        std::uint64_t get_stale_response_count() const
+        {
+            return this->stale_responses.load(std::memory_order_relaxed);
+        }
+
+        ~TelloCommandPipeline()
+        {
+            try
+            {
+                this->stop();
+            }
+            catch(...)
+            {
+
+            }
+        }
+
+    private:
+        struct PendingCommand
+        {
+            std::string command;
+            std::promise<std::string> response;
+            std::chrono::steady_clock::time_point sent_at;
+            std::chrono::steady_clock::time_point deadline;
+            std::chrono::steady_clock::time_point retransmit_at;
+            int retransmissions_left;
+            std::vector<std::chrono::steady_clock::time_point> attempts;
+        };
+
+        struct OwedResponse
+        {
+            std::string command;
+            std::chrono::steady_clock::time_point expires_at;
+        };
+
+        void receive_responses()
+        {
+            while (this->running.load(std::memory_order_relaxed))
+            {
+                try
+                {
+                    std::string_view response = this->tello_client.receive_data_view();
+
+                    auto received_at = std::chrono::steady_clock::now();
+
+                    std::lock_guard<std::mutex> pending_lock(this->pending_mutex);
+
+                    std::erase_if(this->owed_responses, [&received_at](const OwedResponse &owed_response) { return owed_response.expires_at < received_at; });
+
+                    auto owed_response = std::find_if(this->owed_responses.begin(), this->owed_responses.end(), [&response](const OwedResponse &owed_response) { return is_plausible_tello_response(owed_response.command, response); });
+
+                    if (owed_response != this->owed_responses.end())
+                    {
+                        this->owed_responses.erase(owed_response);
+                        this->stale_responses.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    else if (!this->pending_commands.empty() && !is_plausible_tello_response(this->pending_commands.front().command, response))
+                    {
+                        this->stale_responses.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    else if (!this->pending_commands.empty())
+                    {
+                        PendingCommand &pending_command = this->pending_commands.front();
+
+                        if (this->command_metrics)
+                        {
+                            this->command_metrics->record_response(pending_command.command, pending_command.sent_at, response);
+                        }
+
+                        if (pending_command.attempts.size() == 1)
+                        {
+                            this->rtt_estimator.add_sample(std::chrono::duration_cast<std::chrono::microseconds>(received_at - std::max(pending_command.sent_at, this->last_response_at)));
+                        }
+                        else
+                        {
+                            this->rtt_estimator.reset_back_off();
+                            this->expect_later_attempt_responses(pending_command, received_at);
+                        }
+
+                        pending_command.response.set_value(std::string(response));
+                        this->pending_commands.pop_front();
+
+                        if (!this->pending_commands.empty())
+                        {
+                            this->pending_commands.front().retransmit_at = std::max(this->pending_commands.front().retransmit_at, received_at + this->rtt_estimator.get_retransmission_timeout());
+                        }
+                    }
+
+                    this->last_response_at = received_at;
+                }
+                catch(const std::runtime_error&)
+                {
+
+                }
+
+                this->expire_commands();
+            }
+        }
+
+        void expire_commands()
+        {
+            auto now = std::chrono::steady_clock::now();
+
+            std::lock_guard<std::mutex> pending_lock(this->pending_mutex);
+
+            this->retransmit_front_command(now);
+
+            for (auto pending_command = this->pending_commands.begin(); pending_command != this->pending_commands.end();)
+            {
+                if (pending_command->deadline <= now)
+                {
+                    if (this->command_metrics)
+                    {
+                        this->command_metrics->record_timeout(pending_command->command);
+                    }
+
+                    for (std::size_t attempt = 0; attempt < pending_command->attempts.size(); attempt++)
+                    {
+                        this->owed_responses.push_back(OwedResponse{pending_command->command, now + this->rtt_estimator.get_retransmission_timeout()});
+                    }
+
+                    this->fail_command(*pending_command, "Sorry, your Tello didn't respond to '%s' in time.");
+                    pending_command = this->pending_commands.erase(pending_command);
+                }
+                else
+                {
+                    pending_command++;
+                }
+            }
+        }
+
+        void retransmit_front_command(const std::chrono::steady_clock::time_point &now)
+        {
+            if (this->pending_commands.empty())
+            {
+                return;
+            }
+
+            PendingCommand &pending_command = this->pending_commands.front();
+
+            if (pending_command.retransmissions_left <= 0 || pending_command.retransmit_at > now || pending_command.deadline <= now)
+            {
+                return;
+            }
+
+            this->rtt_estimator.back_off();
+
+            pending_command.retransmissions_left--;
+            pending_command.retransmit_at = now + this->rtt_estimator.get_retransmission_timeout();
+
+            try
+            {
+                this->tello_client.send_data(pending_command.command);
+                pending_command.attempts.push_back(now);
+                this->retransmissions.fetch_add(1, std::memory_order_relaxed);
+            }
+            catch(const std::runtime_error&)
+            {
+
+            }
+        }
+
+        void expect_later_attempt_responses(const PendingCommand &pending_command, const std::chrono::steady_clock::time_point &received_at)
+        {
+            bool has_round_trip_time = this->rtt_estimator.get_sample_count() > 0;
+            std::chrono::microseconds minimum_round_trip_time = this->rtt_estimator.get_smoothed_rtt() / 2;
+
+            std::size_t answered_attempt = pending_command.attempts.size() - 1;
+
+            while (answered_attempt > 0 && (!has_round_trip_time || received_at - pending_command.attempts[answered_attempt] < minimum_round_trip_time))
+            {
+                answered_attempt--;
+            }
+
+            auto round_trip_time = received_at - pending_command.attempts[answered_attempt];
+
+            for (std::size_t attempt = answered_attempt + 1; attempt < pending_command.attempts.size(); attempt++)
+            {
+                this->owed_responses.push_back(OwedResponse{pending_command.command, pending_command.attempts[attempt] + round_trip_time + this->rtt_estimator.get_retransmission_timeout()});
+            }
+        }
+
+        void fail_command(PendingCommand &pending_command, const std::string &error_message)
+        {
+            pending_command.response.set_exception
+            (
+                std::make_exception_ptr(std::runtime_error(format_string(error_message, pending_command.command.c_str())))
+            );
+        }
+
+        TelloSocket &tello_client;
+        int poll_timeout_millis;
+        int blocking_timeout_millis = 0;
+
+        std::mutex lifecycle_mutex;
+        std::atomic<bool> running{false};
+        std::thread receiver_thread;
+
+        mutable std::mutex pending_mutex;
+        std::deque<PendingCommand> pending_commands;
+        TelloCommandMetrics *command_metrics = nullptr;
+
+        TelloRttEstimator rtt_estimator;
+        std::deque<OwedResponse> owed_responses;
+        std::chrono::steady_clock::time_point last_response_at{};
+        std::atomic<std::uint64_t> retransmissions{0};
+        std::atomic<std::uint64_t> stale_responses{0};
+};
\ No newline at end of file
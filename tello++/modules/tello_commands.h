@@ -0,0 +1,183 @@
+#pragma once
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+struct CommandArgumentRange
+{
+    int minimum;
+    int maximum;
+
+    constexpr bool contains(const int &argument) const
+    {
+        return argument >= this->minimum && argument <= this->maximum;
+    }
+
+    constexpr std::size_t get_encoded_width() const
+    {
+        return 1 + (get_character_count(this->minimum) > get_character_count(this->maximum) ? get_character_count(this->minimum) : get_character_count(this->maximum));
+    }
+
+    static constexpr std::size_t get_character_count(int argument)
+    {
+        std::size_t character_count = argument < 0 ? 2 : 1;
+
+        while (argument / 10 != 0)
+        {
+            argument /= 10;
+            character_count++;
+        }
+
+        return character_count;
+    }
+};
+
+template<std::size_t name_size>
+struct CommandName
+{
+    char value[name_size];
+
+    constexpr CommandName(const char (&name)[name_size])
+    {
+        for (std::size_t character = 0; character < name_size; character++)
+        {
+            this->value[character] = name[character];
+        }
+    }
+
+    constexpr std::string_view view() const
+    {
+        return std::string_view(this->value, name_size - 1);
+    }
+};
+
+class TelloCommandBuffer
+{
+    public:
+        static constexpr std::size_t capacity = 64;
+
+        void append(std::string_view text)
+        {
+            std::memcpy(this->characters.data() + this->length, text.data(), text.size());
+            this->length += text.size();
+        }
+
+        void append_argument(const int &argument)
+        {
+            this->characters[this->length++] = ' ';
+            this->length = std::to_chars(this->characters.data() + this->length, this->characters.data() + capacity, argument).ptr - this->characters.data();
+        }
+
+        std::string_view view() const
+        {
+            return std::string_view(this->characters.data(), this->length);
+        }
+
+        operator std::string_view() const
+        {
+            return this->view();
+        }
+
+    private:
+        std::array<char, capacity> characters;
+        std::size_t length = 0;
+};
+
+template<CommandName name, CommandArgumentRange ... argument_ranges>
+class TelloCommand
+{
+    public:
+        static constexpr std::string_view command_name = name.view();
+        static constexpr std::size_t argument_count = sizeof...(argument_ranges);
+
+        static_assert(command_name.size() + (argument_ranges.get_encoded_width() + ... + 0) <= TelloCommandBuffer::capacity, "Sorry, this command doesn't fit in a command buffer.");
+
+        template<int ... arguments>
+        static TelloCommandBuffer encode()
+        {
+            static_assert(sizeof...(arguments) == argument_count, "Sorry, you gave this command the wrong number of arguments.");
+            static_assert((argument_ranges.contains(arguments) && ...), "Sorry, one of your arguments is out of range for this command.");
+
+            TelloCommandBuffer command_buffer;
+            command_buffer.append(command_name);
+            (command_buffer.append_argument(arguments), ...);
+
+            return command_buffer;
+        }
+
+        template<typename ... Arguments>
+        requires (sizeof...(Arguments) > 0 && sizeof...(Arguments) == argument_count)
+        static TelloCommandBuffer encode(const Arguments &...arguments)
+        {
+            (check_argument(argument_ranges, arguments), ...);
+
+            TelloCommandBuffer command_buffer;
+            command_buffer.append(command_name);
+            (command_buffer.append_argument(arguments), ...);
+
+            return command_buffer;
+        }
+
+    private:
+        static void check_argument(const CommandArgumentRange &argument_range, const int &argument)
+        {
+            if (!argument_range.contains(argument))
+            {
+                throw std::out_of_range
+                (
+                    "Sorry, '" + std::to_string(argument) + "' is outside '[" + std::to_string(argument_range.minimum) + ", " + std::to_string(argument_range.maximum) + "]' for '" + std::string(command_name) + "'."
+                );
+            }
+        }
+};
+
+struct TelloCommands
+{
+    static constexpr CommandArgumentRange distance_cm{20, 500};
+    static constexpr CommandArgumentRange angle_degrees{1, 360};
+    static constexpr CommandArgumentRange coordinate_cm{-500, 500};
+    static constexpr CommandArgumentRange go_speed_cm_per_sec{10, 100};
+    static constexpr CommandArgumentRange curve_speed_cm_per_sec{10, 60};
+    static constexpr CommandArgumentRange speed_cm_per_sec{10, 100};
+    static constexpr CommandArgumentRange stick{-100, 100};
+
+    using Command = TelloCommand<"command">;
+    using Takeoff = TelloCommand<"takeoff">;
+    using Land = TelloCommand<"land">;
+    using Emergency = TelloCommand<"emergency">;
+
+    using Forward = TelloCommand<"forward", distance_cm>;
+    using Back = TelloCommand<"back", distance_cm>;
+    using Up = TelloCommand<"up", distance_cm>;
+    using Down = TelloCommand<"down", distance_cm>;
+    using Left = TelloCommand<"left", distance_cm>;
+    using Right = TelloCommand<"right", distance_cm>;
+    using Clockwise = TelloCommand<"cw", angle_degrees>;
+    using Counterclockwise = TelloCommand<"ccw", angle_degrees>;
+
+    using FlipFront = TelloCommand<"flip f">;
+    using FlipBack = TelloCommand<"flip b">;
+    using FlipLeft = TelloCommand<"flip l">;
+    using FlipRight = TelloCommand<"flip r">;
+
+    using Go = TelloCommand<"go", coordinate_cm, coordinate_cm, coordinate_cm, go_speed_cm_per_sec>;
+    using Curve = TelloCommand<"curve", coordinate_cm, coordinate_cm, coordinate_cm, coordinate_cm, coordinate_cm, coordinate_cm, curve_speed_cm_per_sec>;
+    using Speed = TelloCommand<"speed", speed_cm_per_sec>;
+    using RemoteControl = TelloCommand<"rc", stick, stick, stick, stick>;
+
+    using SpeedQuery = TelloCommand<"speed?">;
+    using BatteryQuery = TelloCommand<"battery?">;
+    using TimeQuery = TelloCommand<"time?">;
+    using HeightQuery = TelloCommand<"height?">;
+    using TempratureQuery = TelloCommand<"temp?">;
+    using AttitudeQuery = TelloCommand<"attitude?">;
+    using BarometerQuery = TelloCommand<"baro?">;
+    using AccelerationQuery = TelloCommand<"acceleration?">;
+    using DistanceFromTakeoffQuery = TelloCommand<"tof?">;
+    using WifiQuery = TelloCommand<"wifi?">;
+};
\ No newline at end of file
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <string>
+
+struct TelloEndpoint
+{
+    static constexpr int no_receiver = -1;
+
+    std::string tello_ip = "192.168.10.1";
+    int tello_port = 8889;
+    std::string tello_client_ip = "0.0.0.0";
+    int tello_client_port = 9000;
+    std::string tello_state_receiver_ip = "0.0.0.0";
+    int tello_state_receiver_port = 8890;
+    std::string tello_video_receiver_ip = "0.0.0.0";
+    int tello_video_receiver_port = 11111;
+};
\ No newline at end of file
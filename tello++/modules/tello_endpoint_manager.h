@@ -0,0 +1,285 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "internals/socket_base.h"
+#include "internals/socket_util.h"
+
+#include "tello_endpoint.h"
+#include "tello_logger.h"
+#include "tello_state_listener.h"
+
+struct TelloEndpointManagerSettings
+{
+    std::string tello_client_ip = "0.0.0.0";
+    int first_tello_client_port = 9000;
+    int tello_client_port_count = 256;
+
+    std::string tello_video_receiver_ip = "0.0.0.0";
+    int first_tello_video_receiver_port = 11111;
+    int tello_video_receiver_port_count = 256;
+
+    std::string tello_state_receiver_ip = "0.0.0.0";
+    int tello_state_receiver_port = 8890;
+    int tello_state_worker_count = 1;
+};
+
+class TelloEndpointLease;
+
+class TelloEndpointManager
+{
+    public:
+        bool tello_logging;
+
+        TelloEndpointManager(const TelloEndpointManagerSettings &endpoint_manager_settings = TelloEndpointManagerSettings{}, const bool &tello_logging = false) :
+        tello_logging{tello_logging},
+        tello_logger{TelloLogger(this->tello_logging)},
+        endpoint_manager_settings{endpoint_manager_settings},
+        tello_state_listener{tello_logger, endpoint_manager_settings.tello_state_receiver_ip, endpoint_manager_settings.tello_state_receiver_port, endpoint_manager_settings.tello_state_worker_count},
+        leased_tello_client_ports(std::max(endpoint_manager_settings.tello_client_port_count, 0)),
+        leased_tello_video_receiver_ports(std::max(endpoint_manager_settings.tello_video_receiver_port_count, 0))
+        {}
+
+        TelloEndpointManager(TelloEndpointManager const&) = delete;
+        void operator = (TelloEndpointManager const&) = delete;
+
+        TelloEndpoint allocate_endpoint(const std::string &tello_ip, const int &tello_port = 8889)
+        {
+            std::lock_guard<std::mutex> endpoint_lock(this->endpoint_mutex);
+
+            int tello_client_port = this->lease_port(this->endpoint_manager_settings.tello_client_ip, this->endpoint_manager_settings.first_tello_client_port, this->leased_tello_client_ports, this->next_tello_client_port);
+
+            try
+            {
+                int tello_video_receiver_port = this->lease_port(this->endpoint_manager_settings.tello_video_receiver_ip, this->endpoint_manager_settings.first_tello_video_receiver_port, this->leased_tello_video_receiver_ports, this->next_tello_video_receiver_port);
+                this->leased_endpoint_count++;
+
+                return TelloEndpoint
+                {
+                    tello_ip,
+                    tello_port,
+                    this->endpoint_manager_settings.tello_client_ip,
+                    tello_client_port,
+                    this->endpoint_manager_settings.tello_state_receiver_ip,
+                    TelloEndpoint::no_receiver,
+                    this->endpoint_manager_settings.tello_video_receiver_ip,
+                    tello_video_receiver_port
+                };
+            }
+            catch(...)
+            {
+                release_port(tello_client_port, this->endpoint_manager_settings.first_tello_client_port, this->leased_tello_client_ports);
+                throw;
+            }
+        }
+
+        void release_endpoint(const TelloEndpoint &tello_endpoint)
+        {
+            std::lock_guard<std::mutex> endpoint_lock(this->endpoint_mutex);
+
+            if (release_port(tello_endpoint.tello_client_port, this->endpoint_manager_settings.first_tello_client_port, this->leased_tello_client_ports))
+            {
+                this->leased_endpoint_count--;
+            }
+
+            release_port(tello_endpoint.tello_video_receiver_port, this->endpoint_manager_settings.first_tello_video_receiver_port, this->leased_tello_video_receiver_ports);
+        }
+
+        TelloEndpointLease lease_endpoint(const std::string &tello_ip, const int &tello_port = 8889);
+
+        std::size_t get_leased_endpoint_count() const
+        {
+            std::lock_guard<std::mutex> endpoint_lock(this->endpoint_mutex);
+            return this->leased_endpoint_count;
+        }
+
+        void subscribe_tello_state(const std::string &tello_ip, const TelloStateListener::TelloStateHandler &tello_state_handler)
+        {
+            this->tello_state_listener.subscribe(tello_ip, tello_state_handler);
+            this->tello_state_listener.start();
+        }
+
+        void unsubscribe_tello_state(const std::string &tello_ip)
+        {
+            this->tello_state_listener.unsubscribe(tello_ip);
+        }
+
+        TelloStateListener &get_tello_state_listener()
+        {
+            return this->tello_state_listener;
+        }
+
+        void write_log(const std::string &log_location) const
+        {
+            this->tello_logger.write_log(log_location);
+        }
+
+    private:
+        int lease_port(const std::string &receiver_ip, const int &first_port, std::vector<bool> &leased_ports, std::size_t &next_port)
+        {
+            for (std::size_t probed_count = 0; probed_count < leased_ports.size(); probed_count++)
+            {
+                std::size_t port_index = (next_port + probed_count) % leased_ports.size();
+                int port = first_port + static_cast<int>(port_index);
+
+                if (leased_ports[port_index] || !this->is_port_free(receiver_ip, port))
+                {
+                    continue;
+                }
+
+                leased_ports[port_index] = true;
+                next_port = (port_index + 1) % leased_ports.size();
+
+                return port;
+            }
+
+            throw std::runtime_error(format_string("Sorry, all '%zu' ports from '%i' on '%s' are taken.", leased_ports.size(), first_port, receiver_ip.c_str()));
+        }
+
+        static bool release_port(const int &port, const int &first_port, std::vector<bool> &leased_ports)
+        {
+            std::size_t port_index = static_cast<std::size_t>(port - first_port);
+
+            if (port < first_port || port_index >= leased_ports.size() || !leased_ports[port_index])
+            {
+                return false;
+            }
+
+            leased_ports[port_index] = false;
+
+            return true;
+        }
+
+        bool is_port_free(const std::string &receiver_ip, const int &port) const
+        {
+            NativeSocket probe_socket = socket(AF_INET, SOCK_DGRAM, 0);
+
+            if (probe_socket == invalid_native_socket)
+            {
+                throw_socket_error("Sorry, we couldn't create a socket to check your ports.");
+            }
+
+            sockaddr_in probe_address = make_socket_address(receiver_ip, port);
+            bool port_free = bind(probe_socket, (sockaddr*)&probe_address, sizeof(probe_address)) != native_socket_error;
+
+            close_native_socket(probe_socket);
+
+            return port_free;
+        }
+
+        TelloLogger tello_logger;
+        TelloEndpointManagerSettings endpoint_manager_settings;
+        TelloStateListener tello_state_listener;
+
+        mutable std::mutex endpoint_mutex;
+        std::vector<bool> leased_tello_client_ports;
+        std::vector<bool> leased_tello_video_receiver_ports;
+        std::size_t next_tello_client_port = 0;
+        std::size_t next_tello_video_receiver_port = 0;
+        std::size_t leased_endpoint_count = 0;
+};
+
+class TelloEndpointLease
+{
+    public:
+        TelloEndpointLease() = default;
+
+        TelloEndpointLease(TelloEndpointManager &endpoint_manager, const std::string &tello_ip, const int &tello_port = 8889) :
+        endpoint_manager{&endpoint_manager},
+        tello_endpoint{endpoint_manager.allocate_endpoint(tello_ip, tello_port)}
+        {}
+
+        TelloEndpointLease(TelloEndpointLease const&) = delete;
+        void operator = (TelloEndpointLease const&) = delete;
+
+        TelloEndpointLease(TelloEndpointLease &&endpoint_lease) noexcept :
+        endpoint_manager{std::exchange(endpoint_lease.endpoint_manager, nullptr)},
+        tello_endpoint{std::move(endpoint_lease.tello_endpoint)},
+        subscribed{std::exchange(endpoint_lease.subscribed, false)}
+        {}
+
+        TelloEndpointLease &operator = (TelloEndpointLease &&endpoint_lease) noexcept
+        {
+            if (this != &endpoint_lease)
+            {
+                this->release();
+
+                this->endpoint_manager = std::exchange(endpoint_lease.endpoint_manager, nullptr);
+                this->tello_endpoint = std::move(endpoint_lease.tello_endpoint);
+                this->subscribed = std::exchange(endpoint_lease.subscribed, false);
+            }
+
+            return *this;
+        }
+
+        const TelloEndpoint &get_endpoint() const
+        {
+            return this->tello_endpoint;
+        }
+
+        bool is_leased() const
+        {
+            return this->endpoint_manager != nullptr;
+        }
+
+        void subscribe_tello_state(const TelloStateListener::TelloStateHandler &tello_state_handler)
+        {
+            if (!this->endpoint_manager)
+            {
+                throw std::runtime_error("Sorry, you can't listen to the state of a Tello whose endpoint was released.");
+            }
+
+            this->endpoint_manager->subscribe_tello_state(this->tello_endpoint.tello_ip, tello_state_handler);
+            this->subscribed = true;
+        }
+
+        void unsubscribe_tello_state()
+        {
+            if (this->subscribed)
+            {
+                this->endpoint_manager->unsubscribe_tello_state(this->tello_endpoint.tello_ip);
+                this->subscribed = false;
+            }
+        }
+
+        void release() noexcept
+        {
+            if (!this->endpoint_manager)
+            {
+                return;
+            }
+
+            try
+            {
+                this->unsubscribe_tello_state();
+                this->endpoint_manager->release_endpoint(this->tello_endpoint);
+            }
+            catch(...)
+            {
+
+            }
+
+            this->endpoint_manager = nullptr;
+        }
+
+        ~TelloEndpointLease()
+        {
+            this->release();
+        }
+
+    private:
+        TelloEndpointManager *endpoint_manager = nullptr;
+        TelloEndpoint tello_endpoint;
+        bool subscribed = false;
+};
+
+inline TelloEndpointLease TelloEndpointManager::lease_endpoint(const std::string &tello_ip, const int &tello_port)
+{
+    return TelloEndpointLease(*this, tello_ip, tello_port);
+}
\ No newline at end of file
@@ -0,0 +1,347 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "internals/memory_mapped_file.h"
+
+#include "tello_state.h"
+
+enum class TelloStateColumn : std::uint8_t
+{
+    pitch,
+    roll,
+    yaw,
+    x_velocity,
+    y_velocity,
+    z_velocity,
+    average_temprature,
+    distance_from_takeoff,
+    height,
+    battery,
+    barometer_reading,
+    flight_time,
+    x_acceleration,
+    y_acceleration,
+    z_acceleration,
+    count
+};
+
+template<TelloStateColumn column>
+using TelloStateColumnType = std::conditional_t
+<
+    column == TelloStateColumn::average_temprature ||
+    column == TelloStateColumn::barometer_reading ||
+    column == TelloStateColumn::x_acceleration ||
+    column == TelloStateColumn::y_acceleration ||
+    column == TelloStateColumn::z_acceleration,
+    float,
+    std::int32_t
+>;
+
+struct TelloFlightRecordingHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t block_capacity;
+    std::uint64_t sample_count;
+    std::uint8_t reserved[40];
+};
+
+class TelloFlightRecordingLayout
+{
+    public:
+        static constexpr char magic[8] = {'T', 'E', 'L', 'L', 'O', 'F', 'R', '\0'};
+        static constexpr std::uint32_t version = 2;
+        static constexpr std::size_t header_size = sizeof(TelloFlightRecordingHeader);
+        static constexpr std::size_t column_count = static_cast<std::size_t>(TelloStateColumn::count);
+
+        static_assert(header_size == 64, "Sorry, the flight recording header has to stay 64 bytes.");
+
+        static std::size_t get_block_size(const std::size_t &block_capacity)
+        {
+            return block_capacity * (2 * sizeof(std::int64_t) + sizeof(std::uint32_t) + column_count * sizeof(std::int32_t));
+        }
+
+        static std::size_t get_block_offset(const std::size_t &block_capacity, const std::size_t &block_index)
+        {
+            return header_size + block_index * get_block_size(block_capacity);
+        }
+
+        static std::size_t get_timestamp_offset(const std::size_t &)
+        {
+            return 0;
+        }
+
+        static std::size_t get_steady_timestamp_offset(const std::size_t &block_capacity)
+        {
+            return block_capacity * sizeof(std::int64_t);
+        }
+
+        static std::size_t get_tello_id_offset(const std::size_t &block_capacity)
+        {
+            return block_capacity * 2 * sizeof(std::int64_t);
+        }
+
+        static std::size_t get_column_offset(const std::size_t &block_capacity, const TelloStateColumn &column)
+        {
+            return block_capacity * (2 * sizeof(std::int64_t) + sizeof(std::uint32_t) + static_cast<std::size_t>(column) * sizeof(std::int32_t));
+        }
+};
+
+class TelloFlightRecorder
+{
+    public:
+        TelloFlightRecorder(const std::string &recording_location, const std::size_t &block_capacity = 4096, const std::size_t &initial_block_count = 4) :
+        block_capacity{block_capacity},
+        mapped_block_count{initial_block_count > 0 ? initial_block_count : 1},
+        recording_file{recording_location, true, TelloFlightRecordingLayout::get_block_offset(block_capacity, initial_block_count > 0 ? initial_block_count : 1)}
+        {
+            if (block_capacity == 0)
+            {
+                throw std::invalid_argument("Sorry, your flight recording blocks have to hold at least one sample.");
+            }
+
+            TelloFlightRecordingHeader recording_header{};
+            std::memcpy(recording_header.magic, TelloFlightRecordingLayout::magic, sizeof(recording_header.magic));
+            recording_header.version = TelloFlightRecordingLayout::version;
+            recording_header.block_capacity = static_cast<std::uint32_t>(block_capacity);
+            recording_header.sample_count = 0;
+
+            std::memcpy(this->recording_file.data(), &recording_header, sizeof(recording_header));
+        }
+
+        TelloFlightRecorder(TelloFlightRecorder const&) = delete;
+        void operator = (TelloFlightRecorder const&) = delete;
+
+        void record(const TelloState &tello_state, const std::int64_t &timestamp_nanos, const std::uint32_t &tello_id = 0)
+        {
+            std::lock_guard<std::mutex> record_lock(this->record_mutex);
+
+            std::int64_t steady_timestamp_nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+            std::size_t block_index = this->sample_count / this->block_capacity;
+            std::size_t block_slot = this->sample_count % this->block_capacity;
+
+            if (block_index >= this->mapped_block_count)
+            {
+                this->mapped_block_count *= 2;
+                this->recording_file.resize(TelloFlightRecordingLayout::get_block_offset(this->block_capacity, this->mapped_block_count));
+            }
+
+            std::byte *block = this->recording_file.data() + TelloFlightRecordingLayout::get_block_offset(this->block_capacity, block_index);
+
+            store(block, TelloFlightRecordingLayout::get_timestamp_offset(this->block_capacity), block_slot, timestamp_nanos);
+            store(block, TelloFlightRecordingLayout::get_steady_timestamp_offset(this->block_capacity), block_slot, steady_timestamp_nanos);
+            store(block, TelloFlightRecordingLayout::get_tello_id_offset(this->block_capacity), block_slot, tello_id);
+
+            this->store_column<TelloStateColumn::pitch>(block, block_slot, tello_state.imu_attitude.pitch);
+            this->store_column<TelloStateColumn::roll>(block, block_slot, tello_state.imu_attitude.roll);
+            this->store_column<TelloStateColumn::yaw>(block, block_slot, tello_state.imu_attitude.yaw);
+            this->store_column<TelloStateColumn::x_velocity>(block, block_slot, tello_state.imu_velocity.x_velocity);
+            this->store_column<TelloStateColumn::y_velocity>(block, block_slot, tello_state.imu_velocity.y_velocity);
+            this->store_column<TelloStateColumn::z_velocity>(block, block_slot, tello_state.imu_velocity.z_velocity);
+            this->store_column<TelloStateColumn::average_temprature>(block, block_slot, tello_state.average_temprature);
+            this->store_column<TelloStateColumn::distance_from_takeoff>(block, block_slot, tello_state.distance_from_takeoff);
+            this->store_column<TelloStateColumn::height>(block, block_slot, tello_state.height);
+            this->store_column<TelloStateColumn::battery>(block, block_slot, tello_state.battery);
+            this->store_column<TelloStateColumn::barometer_reading>(block, block_slot, tello_state.barometer_reading);
+            this->store_column<TelloStateColumn::flight_time>(block, block_slot, tello_state.flight_time);
+            this->store_column<TelloStateColumn::x_acceleration>(block, block_slot, tello_state.imu_acceleration.x_acceleration);
+            this->store_column<TelloStateColumn::y_acceleration>(block, block_slot, tello_state.imu_acceleration.y_acceleration);
+            this->store_column<TelloStateColumn::z_acceleration>(block, block_slot, tello_state.imu_acceleration.z_acceleration);
+
+            this->sample_count++;
+            reinterpret_cast<TelloFlightRecordingHeader*>(this->recording_file.data())->sample_count = this->sample_count;
+        }
+
+        void record(const TelloState &tello_state, const std::uint32_t &tello_id = 0)
+        {
+            this->record(tello_state, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count(), tello_id);
+        }
+
+        std::size_t get_sample_count() const
+        {
+            std::lock_guard<std::mutex> record_lock(this->record_mutex);
+            return this->sample_count;
+        }
+
+        void flush()
+        {
+            std::lock_guard<std::mutex> record_lock(this->record_mutex);
+            this->recording_file.flush();
+        }
+
+        ~TelloFlightRecorder()
+        {
+            try
+            {
+                std::size_t used_block_count = (this->sample_count + this->block_capacity - 1) / this->block_capacity;
+                this->recording_file.resize(TelloFlightRecordingLayout::get_block_offset(this->block_capacity, used_block_count));
+            }
+            catch(...)
+            {
+
+            }
+        }
+
+    private:
+        template<typename Value>
+        static void store(std::byte *block, const std::size_t &column_offset, const std::size_t &block_slot, const Value &value)
+        {
+            std::memcpy(block + column_offset + block_slot * sizeof(Value), &value, sizeof(Value));
+        }
+
+        template<TelloStateColumn column>
+        void store_column(std::byte *block, const std::size_t &block_slot, const TelloStateColumnType<column> &value)
+        {
+            store(block, TelloFlightRecordingLayout::get_column_offset(this->block_capacity, column), block_slot, value);
+        }
+
+        mutable std::mutex record_mutex;
+        std::size_t block_capacity;
+        std::size_t mapped_block_count;
+        std::size_t sample_count = 0;
+        MemoryMappedFile recording_file;
+};
+
+class TelloFlightRecording
+{
+    public:
+        TelloFlightRecording(const std::string &recording_location) :
+        recording_file{recording_location, false}
+        {
+            if (this->recording_file.size() < TelloFlightRecordingLayout::header_size)
+            {
+                throw std::runtime_error("Sorry, '" + recording_location + "' is too small to be a flight recording.");
+            }
+
+            TelloFlightRecordingHeader recording_header;
+            std::memcpy(&recording_header, this->recording_file.data(), sizeof(recording_header));
+
+            if (std::memcmp(recording_header.magic, TelloFlightRecordingLayout::magic, sizeof(recording_header.magic)) != 0 || recording_header.version != TelloFlightRecordingLayout::version)
+            {
+                throw std::runtime_error("Sorry, '" + recording_location + "' isn't a flight recording we can read.");
+            }
+
+            this->block_capacity = recording_header.block_capacity;
+            this->sample_count = recording_header.sample_count;
+
+            if (this->block_capacity == 0 || TelloFlightRecordingLayout::get_block_offset(this->block_capacity, this->get_block_count()) > this->recording_file.size())
+            {
+                throw std::runtime_error("Sorry, '" + recording_location + "' is truncated.");
+            }
+        }
+
+        std::size_t get_sample_count() const
+        {
+            return this->sample_count;
+        }
+
+        std::size_t get_block_capacity() const
+        {
+            return this->block_capacity;
+        }
+
+        std::size_t get_block_count() const
+        {
+            return (this->sample_count + this->block_capacity - 1) / this->block_capacity;
+        }
+
+        std::size_t get_block_sample_count(const std::size_t &block_index) const
+        {
+            std::size_t block_start = block_index * this->block_capacity;
+            return block_start >= this->sample_count ? 0 : std::min(this->block_capacity, this->sample_count - block_start);
+        }
+
+        std::span<const std::int64_t> get_timestamps(const std::size_t &block_index) const
+        {
+            return this->get_block_column<std::int64_t>(block_index, TelloFlightRecordingLayout::get_timestamp_offset(this->block_capacity));
+        }
+
+        std::span<const std::int64_t> get_steady_timestamps(const std::size_t &block_index) const
+        {
+            return this->get_block_column<std::int64_t>(block_index, TelloFlightRecordingLayout::get_steady_timestamp_offset(this->block_capacity));
+        }
+
+        std::span<const std::uint32_t> get_tello_ids(const std::size_t &block_index) const
+        {
+            return this->get_block_column<std::uint32_t>(block_index, TelloFlightRecordingLayout::get_tello_id_offset(this->block_capacity));
+        }
+
+        template<TelloStateColumn column>
+        std::span<const TelloStateColumnType<column>> get_column(const std::size_t &block_index) const
+        {
+            return this->get_block_column<TelloStateColumnType<column>>(block_index, TelloFlightRecordingLayout::get_column_offset(this->block_capacity, column));
+        }
+
+        std::int64_t get_timestamp(const std::size_t &sample_index) const
+        {
+            return this->get_timestamps(sample_index / this->block_capacity)[sample_index % this->block_capacity];
+        }
+
+        std::int64_t get_steady_timestamp(const std::size_t &sample_index) const
+        {
+            return this->get_steady_timestamps(sample_index / this->block_capacity)[sample_index % this->block_capacity];
+        }
+
+        std::size_t seek(const std::int64_t &steady_timestamp_nanos) const
+        {
+            std::size_t first_sample = 0;
+            std::size_t last_sample = this->sample_count;
+
+            while (first_sample < last_sample)
+            {
+                std::size_t middle_sample = first_sample + (last_sample - first_sample) / 2;
+
+                if (this->get_steady_timestamp(middle_sample) < steady_timestamp_nanos)
+                {
+                    first_sample = middle_sample + 1;
+                }
+                else
+                {
+                    last_sample = middle_sample;
+                }
+            }
+
+            return first_sample;
+        }
+
+        TelloState get_tello_state(const std::size_t &sample_index) const
+        {
+            std::size_t block_index = sample_index / this->block_capacity;
+            std::size_t block_slot = sample_index % this->block_capacity;
+
+            return TelloState
+            {
+            {this->get_column<TelloStateColumn::pitch>(block_index)[block_slot], this->get_column<TelloStateColumn::roll>(block_index)[block_slot], this->get_column<TelloStateColumn::yaw>(block_index)[block_slot]},
+            {this->get_column<TelloStateColumn::x_velocity>(block_index)[block_slot], this->get_column<TelloStateColumn::y_velocity>(block_index)[block_slot], this->get_column<TelloStateColumn::z_velocity>(block_index)[block_slot]},
+            this->get_column<TelloStateColumn::average_temprature>(block_index)[block_slot],
+            this->get_column<TelloStateColumn::distance_from_takeoff>(block_index)[block_slot],
+            this->get_column<TelloStateColumn::height>(block_index)[block_slot],
+            this->get_column<TelloStateColumn::battery>(block_index)[block_slot],
+            this->get_column<TelloStateColumn::barometer_reading>(block_index)[block_slot],
+            this->get_column<TelloStateColumn::flight_time>(block_index)[block_slot],
+            {this->get_column<TelloStateColumn::x_acceleration>(block_index)[block_slot], this->get_column<TelloStateColumn::y_acceleration>(block_index)[block_slot], this->get_column<TelloStateColumn::z_acceleration>(block_index)[block_slot]}
+            };
+        }
+
+    private:
+        template<typename Value>
+        std::span<const Value> get_block_column(const std::size_t &block_index, const std::size_t &column_offset) const
+        {
+            const std::byte *block = this->recording_file.data() + TelloFlightRecordingLayout::get_block_offset(this->block_capacity, block_index);
+            return std::span<const Value>(reinterpret_cast<const Value*>(block + column_offset), this->get_block_sample_count(block_index));
+        }
+
+        MemoryMappedFile recording_file;
+        std::size_t block_capacity = 0;
+        std::size_t sample_count = 0;
+};
\ No newline at end of file
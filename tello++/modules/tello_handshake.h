@@ -0,0 +1,23 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+enum class TelloConnectMode
+{
+    blocking,
+    deferred
+};
+
+struct TelloHandshakeReport
+{
+    std::vector<std::size_t> responsive_tellos;
+    std::vector<std::size_t> unresponsive_tellos;
+    std::chrono::steady_clock::duration elapsed{};
+
+    bool all_responded() const
+    {
+        return this->unresponsive_tellos.empty();
+    }
+};
\ No newline at end of file
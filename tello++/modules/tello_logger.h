@@ -1,32 +1,328 @@
 #pragma once
 
+#include<algorithm>
+#include<atomic>
+#include<chrono>
+#include<cstdint>
+#include<cstdio>
+#include<cstring>
 #include<fstream>
 #include<iostream>
+#include<memory>
+#include<mutex>
+#include<string>
+#include<string_view>
+#include<thread>
+
+enum class TelloLogEvent : std::uint8_t
+{
+    message,
+    sent_data,
+    received_data,
+    flight_time_units,
+    height_units,
+    temprature_units,
+    distance_from_takeoff_units
+};
+
+struct TelloLogRecord
+{
+    std::int64_t timestamp_nanos;
+    TelloLogEvent event;
+    std::uint16_t text_size;
+    std::uint16_t port;
+    std::uint32_t ip_address;
+    std::int32_t data_size;
+    char text[256];
+};
 
 class TelloLogger
 {
     public:
+        static constexpr std::uint64_t ring_capacity = 4096;
+        static constexpr std::size_t history_capacity = 1024 * 1024;
+
         TelloLogger(bool &tello_logging) : tello_logging{tello_logging} {}
 
+        TelloLogger(TelloLogger const&) = delete;
+        void operator = (TelloLogger const&) = delete;
+
         void write_log(const std::string &log_location) const
         {
+            this->flush();
+
+            std::string history;
+            bool history_wrapped = false;
+
+            {
+                std::lock_guard<std::mutex> history_lock(this->history_mutex);
+
+                if (this->log_history)
+                {
+                    std::size_t history_size = static_cast<std::size_t>(std::min<std::uint64_t>(this->history_written, history_capacity));
+                    std::size_t history_start = static_cast<std::size_t>((this->history_written - history_size) % history_capacity);
+                    std::size_t first_part_size = std::min(history_size, history_capacity - history_start);
+
+                    history.resize(history_size);
+                    std::memcpy(history.data(), this->log_history.get() + history_start, first_part_size);
+                    std::memcpy(history.data() + first_part_size, this->log_history.get(), history_size - first_part_size);
+
+                    history_wrapped = this->history_written > history_capacity;
+                }
+            }
+
+            std::size_t first_line = history_wrapped ? std::min(history.find('\n'), history.size() - 1) + 1 : 0;
+
             std::ofstream log_file;
-            log_file.open(log_location);
-            log_file << log;
+            log_file.open(log_location, std::ios::binary);
+            log_file.write(history.data() + first_line, static_cast<std::streamsize>(history.size() - first_line));
             log_file.close();
         }
 
-        void log_data(const std::string &to_log) const
+        void log_data(std::string_view to_log) const
+        {
+            this->log_event(TelloLogEvent::message, to_log);
+        }
+
+        void log_event(const TelloLogEvent &event, std::string_view text, const std::int32_t &data_size = 0, const std::uint32_t &ip_address = 0, const std::uint16_t &port = 0) const
+        {
+            if (!this->tello_logging)
+            {
+                return;
+            }
+
+            std::call_once(this->start_once, [this]() { this->start_draining(); });
+
+            std::uint64_t ticket = this->next_ticket.fetch_add(1, std::memory_order_acq_rel);
+            LogSlot &log_slot = this->log_ring[ticket % ring_capacity];
+
+            std::uint64_t slot_sequence = log_slot.sequence.load(std::memory_order_relaxed);
+
+            if ((slot_sequence & 1) || slot_sequence > 2 * ticket || !log_slot.sequence.compare_exchange_strong(slot_sequence, 2 * ticket + 1, std::memory_order_acquire))
+            {
+                this->dropped_records.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            std::atomic_thread_fence(std::memory_order_release);
+
+            TelloLogRecord &log_record = log_slot.record;
+            log_record.timestamp_nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+            log_record.event = event;
+            log_record.text_size = static_cast<std::uint16_t>(text.size() < sizeof(log_record.text) ? text.size() : sizeof(log_record.text));
+            log_record.port = port;
+            log_record.ip_address = ip_address;
+            log_record.data_size = data_size;
+            std::memcpy(log_record.text, text.data(), log_record.text_size);
+
+            log_slot.sequence.store(2 * ticket + 2, std::memory_order_release);
+        }
+
+        std::uint64_t get_dropped_record_count() const
         {
-            if(this->tello_logging) 
+            return this->dropped_records.load(std::memory_order_relaxed);
+        }
+
+        void flush() const
+        {
+            while (this->drained_ticket.load(std::memory_order_acquire) < this->next_ticket.load(std::memory_order_acquire))
             {
-                std::string log_string_newline = to_log + '\n';
-                this->log += log_string_newline;
-                std::cout << log_string_newline;
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+
+        ~TelloLogger()
+        {
+            if (this->drain_thread.joinable())
+            {
+                this->draining.store(false, std::memory_order_release);
+                this->drain_thread.join();
             }
         }
 
     private:
+        enum class RecordState
+        {
+            ready,
+            pending,
+            lost
+        };
+
+        struct LogSlot
+        {
+            std::atomic<std::uint64_t> sequence{0};
+            TelloLogRecord record;
+        };
+
+        static constexpr int max_pending_polls = 8;
+
+        void start_draining() const
+        {
+            this->log_ring = std::make_unique<LogSlot[]>(ring_capacity);
+            this->log_history = std::make_unique<char[]>(history_capacity);
+            this->draining.store(true, std::memory_order_release);
+            this->drain_thread = std::thread(&TelloLogger::drain_records, this);
+        }
+
+        RecordState read_record(const std::uint64_t &ticket, TelloLogRecord &log_record) const
+        {
+            const LogSlot &log_slot = this->log_ring[ticket % ring_capacity];
+
+            std::uint64_t sequence_before = log_slot.sequence.load(std::memory_order_acquire);
+
+            if (sequence_before > 2 * ticket + 2)
+            {
+                return RecordState::lost;
+            }
+
+            if (sequence_before != 2 * ticket + 2)
+            {
+                return RecordState::pending;
+            }
+
+            std::memcpy(&log_record, &log_slot.record, sizeof(TelloLogRecord));
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            return log_slot.sequence.load(std::memory_order_relaxed) == sequence_before ? RecordState::ready : RecordState::lost;
+        }
+
+        void drain_records() const
+        {
+            TelloLogRecord log_record;
+            char formatted_record[512];
+
+            std::uint64_t ticket = 0;
+            int pending_polls = 0;
+
+            while (true)
+            {
+                bool still_draining = this->draining.load(std::memory_order_acquire);
+                std::uint64_t head_ticket = this->next_ticket.load(std::memory_order_acquire);
+
+                if (head_ticket > ticket + ring_capacity)
+                {
+                    this->dropped_records.fetch_add(head_ticket - ring_capacity - ticket, std::memory_order_relaxed);
+                    ticket = head_ticket - ring_capacity;
+                }
+
+                bool wrote_records = false;
+                std::unique_lock<std::mutex> history_lock(this->history_mutex);
+
+                while (ticket < head_ticket)
+                {
+                    RecordState record_state = this->read_record(ticket, log_record);
+
+                    if (record_state == RecordState::pending && pending_polls++ < max_pending_polls)
+                    {
+                        break;
+                    }
+
+                    if (record_state == RecordState::pending)
+                    {
+                        this->dropped_records.fetch_add(1, std::memory_order_relaxed);
+                    }
+
+                    if (record_state == RecordState::ready)
+                    {
+                        std::size_t formatted_size = format_record(log_record, formatted_record, sizeof(formatted_record));
+
+                        std::fwrite(formatted_record, 1, formatted_size, stdout);
+                        this->append_history(formatted_record, formatted_size);
+
+                        wrote_records = true;
+                    }
+
+                    pending_polls = 0;
+                    ticket++;
+                }
+
+                history_lock.unlock();
+                this->drained_ticket.store(ticket, std::memory_order_release);
+
+                if (wrote_records)
+                {
+                    std::fflush(stdout);
+                }
+
+                if (!still_draining && ticket >= head_ticket)
+                {
+                    return;
+                }
+
+                if (ticket >= head_ticket || pending_polls > 0)
+                {
+                    std::this_thread::sleep_for(std::chrono::microseconds(500));
+                }
+            }
+        }
+
+        void append_history(const char *formatted_record, const std::size_t &formatted_size) const
+        {
+            std::size_t history_end = static_cast<std::size_t>(this->history_written % history_capacity);
+            std::size_t first_part_size = std::min(formatted_size, history_capacity - history_end);
+
+            std::memcpy(this->log_history.get() + history_end, formatted_record, first_part_size);
+            std::memcpy(this->log_history.get(), formatted_record + first_part_size, formatted_size - first_part_size);
+
+            this->history_written += formatted_size;
+        }
+
+        static std::size_t format_record(const TelloLogRecord &log_record, char *formatted_record, const std::size_t &formatted_record_size)
+        {
+            std::int64_t seconds = log_record.timestamp_nanos / 1000000000;
+            std::int64_t micros = (log_record.timestamp_nanos % 1000000000) / 1000;
+
+            int text_size = log_record.text_size;
+            const char *text = log_record.text;
+
+            const unsigned char *ip_octets = reinterpret_cast<const unsigned char*>(&log_record.ip_address);
+
+            int formatted_size = 0;
+
+            switch (log_record.event)
+            {
+                case TelloLogEvent::sent_data:
+                    formatted_size = std::snprintf(formatted_record, formatted_record_size, "[%lld.%06lld] Sent '%.*s' with the size '%i' to '(%u.%u.%u.%u, %u)'\n", static_cast<long long>(seconds), static_cast<long long>(micros), text_size, text, log_record.data_size, ip_octets[0], ip_octets[1], ip_octets[2], ip_octets[3], log_record.port);
+                    break;
+                case TelloLogEvent::received_data:
+                    formatted_size = std::snprintf(formatted_record, formatted_record_size, "[%lld.%06lld] Received '%.*s' with the size '%i' from '(%u.%u.%u.%u, %u)'\n", static_cast<long long>(seconds), static_cast<long long>(micros), text_size, text, log_record.data_size, ip_octets[0], ip_octets[1], ip_octets[2], ip_octets[3], log_record.port);
+                    break;
+                case TelloLogEvent::flight_time_units:
+                    formatted_size = std::snprintf(formatted_record, formatted_record_size, "[%lld.%06lld] Tello Flight Time Units: '%.*s'\n", static_cast<long long>(seconds), static_cast<long long>(micros), text_size, text);
+                    break;
+                case TelloLogEvent::height_units:
+                    formatted_size = std::snprintf(formatted_record, formatted_record_size, "[%lld.%06lld] Tello Height Units: '%.*s'\n", static_cast<long long>(seconds), static_cast<long long>(micros), text_size, text);
+                    break;
+                case TelloLogEvent::temprature_units:
+                    formatted_size = std::snprintf(formatted_record, formatted_record_size, "[%lld.%06lld] Tello Temprature Unit: '%.*s'\n", static_cast<long long>(seconds), static_cast<long long>(micros), text_size, text);
+                    break;
+                case TelloLogEvent::distance_from_takeoff_units:
+                    formatted_size = std::snprintf(formatted_record, formatted_record_size, "[%lld.%06lld] Tello Distance Form Takeoff Units: '%.*s'\n", static_cast<long long>(seconds), static_cast<long long>(micros), text_size, text);
+                    break;
+                default:
+                    formatted_size = std::snprintf(formatted_record, formatted_record_size, "[%lld.%06lld] %.*s\n", static_cast<long long>(seconds), static_cast<long long>(micros), text_size, text);
+                    break;
+            }
+
+            if (formatted_size < 0)
+            {
+                return 0;
+            }
+
+            return static_cast<std::size_t>(formatted_size) < formatted_record_size ? static_cast<std::size_t>(formatted_size) : formatted_record_size - 1;
+        }
+
         bool &tello_logging;
-        mutable std::string log;
+
+        mutable std::once_flag start_once;
+        mutable std::unique_ptr<LogSlot[]> log_ring;
+        mutable std::thread drain_thread;
+        mutable std::atomic<bool> draining{false};
+        mutable std::mutex history_mutex;
+        mutable std::unique_ptr<char[]> log_history;
+        mutable std::uint64_t history_written = 0;
+
+        alignas(64) mutable std::atomic<std::uint64_t> next_ticket{0};
+        alignas(64) mutable std::atomic<std::uint64_t> drained_ticket{0};
+        mutable std::atomic<std::uint64_t> dropped_records{0};
 };
\ No newline at end of file
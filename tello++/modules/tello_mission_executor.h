@@ -0,0 +1,235 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "tello_command_pipeline.h"
+#include "tello_commands.h"
+#include "tello_mission_plan.h"
+#include "tello_reliable_commands.h"
+#include "tello_state_stream.h"
+
+class TelloMissionExecutor
+{
+    public:
+        TelloMissionExecutor(TelloCommandPipeline &tello_command_pipeline, const TelloStateStream *tello_state_stream = nullptr, const MissionRetryPolicy &retry_policy = MissionRetryPolicy{}) :
+        tello_command_pipeline{tello_command_pipeline},
+        tello_state_stream{tello_state_stream},
+        retry_policy{retry_policy}
+        {}
+
+        TelloMissionExecutor(TelloMissionExecutor const&) = delete;
+        void operator = (TelloMissionExecutor const&) = delete;
+
+        MissionResult run(const MissionPlan &mission_plan)
+        {
+            mission_plan.validate();
+
+            MissionResult mission_result{false, 0, 0, ""};
+
+            for (const MissionStep &mission_step : mission_plan.get_mission_steps())
+            {
+                if (this->cancelled.load(std::memory_order_relaxed))
+                {
+                    mission_result.failure_message = "Sorry, your mission was cancelled.";
+                    return this->fail_mission(mission_result);
+                }
+
+                if (mission_step.is_motion() && !this->check_preconditions(mission_step, mission_plan.get_mission_preconditions(), mission_result.failure_message))
+                {
+                    return this->fail_mission(mission_result);
+                }
+
+                if (!this->run_step(mission_step, mission_plan.get_mission_preconditions().max_tello_state_age, mission_result))
+                {
+                    return this->fail_mission(mission_result);
+                }
+
+                mission_result.completed_step_count++;
+            }
+
+            mission_result.completed = true;
+            return mission_result;
+        }
+
+        void cancel()
+        {
+            this->cancelled.store(true, std::memory_order_relaxed);
+        }
+
+    private:
+        bool run_step(const MissionStep &mission_step, const std::chrono::milliseconds &max_tello_state_age, MissionResult &mission_result)
+        {
+            TelloCommandBuffer encoded_step = mission_step.encode();
+
+            bool idempotent_step = is_idempotent_tello_command(encoded_step.view());
+            TelloStateSample tello_state_before;
+            bool has_tello_state_before = !idempotent_step && this->tello_state_stream != nullptr && this->tello_state_stream->is_running() && this->tello_state_stream->try_get_tello_state_sample(tello_state_before) && std::chrono::steady_clock::now() - tello_state_before.received_at <= max_tello_state_age;
+
+            int error_retries = 0;
+            int timeout_retries = 0;
+            std::chrono::duration<double, std::milli> retry_delay = this->retry_policy.retry_delay;
+
+            while (true)
+            {
+                std::string failure;
+
+                try
+                {
+                    std::future<std::string> pending_response = this->tello_command_pipeline.send_command(encoded_step, this->retry_policy.step_timeout);
+
+                    while (pending_response.wait_for(std::chrono::milliseconds(10)) != std::future_status::ready)
+                    {
+                        if (this->cancelled.load(std::memory_order_relaxed))
+                        {
+                            mission_result.failure_message = "Sorry, your mission was cancelled.";
+                            return false;
+                        }
+                    }
+
+                    std::string response = pending_response.get();
+
+                    if (response == "ok")
+                    {
+                        return true;
+                    }
+
+                    failure = "Your Tello answered '" + response + "'.";
+
+                    if (error_retries++ >= this->retry_policy.max_error_retries)
+                    {
+                        mission_result.failure_message = "Sorry, '" + std::string(encoded_step.view()) + "' failed after " + std::to_string(error_retries) + " attempts. " + failure;
+                        return false;
+                    }
+                }
+                catch(const std::runtime_error &error)
+                {
+                    failure = error.what();
+
+                    if (timeout_retries++ >= this->retry_policy.max_timeout_retries)
+                    {
+                        mission_result.failure_message = "Sorry, '" + std::string(encoded_step.view()) + "' failed after " + std::to_string(error_retries + timeout_retries) + " attempts. " + failure;
+                        return false;
+                    }
+
+                    if (!idempotent_step)
+                    {
+                        MotionOutcome motion_outcome = has_tello_state_before ? this->get_motion_outcome(encoded_step.view(), tello_state_before.tello_state, max_tello_state_age) : MotionOutcome::unknown;
+
+                        if (motion_outcome == MotionOutcome::taken_effect)
+                        {
+                            return true;
+                        }
+
+                        if (motion_outcome != MotionOutcome::not_started)
+                        {
+                            mission_result.failure_message = "Sorry, '" + std::string(encoded_step.view()) + "' timed out and we can't tell from your Tello's telemetry whether it moved, so we won't resend it. " + failure;
+                            return false;
+                        }
+                    }
+                }
+
+                mission_result.retry_count++;
+
+                std::this_thread::sleep_for(retry_delay);
+                retry_delay *= this->retry_policy.retry_backoff;
+            }
+        }
+
+        MotionOutcome get_motion_outcome(std::string_view encoded_step, const TelloState &tello_state_before, const std::chrono::milliseconds &max_tello_state_age) const
+        {
+            TelloMotionGuard motion_guard(encoded_step, tello_state_before);
+            TelloStateSample tello_state_after;
+
+            auto timed_out_at = std::chrono::steady_clock::now();
+            auto deadline = timed_out_at + max_tello_state_age;
+
+            while (std::chrono::steady_clock::now() < deadline)
+            {
+                if (this->tello_state_stream->try_get_tello_state_sample(tello_state_after) && tello_state_after.received_at > timed_out_at)
+                {
+                    return motion_guard.evaluate(tello_state_after.tello_state);
+                }
+
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+
+            return MotionOutcome::unknown;
+        }
+
+        bool check_preconditions(const MissionStep &mission_step, const MissionPreconditions &mission_preconditions, std::string &failure_message) const
+        {
+            if (mission_preconditions.minimum_battery <= 0 && mission_preconditions.minimum_height_cm <= 0 && mission_preconditions.maximum_height_cm <= 0)
+            {
+                return true;
+            }
+
+            TelloStateSample tello_state_sample;
+            auto deadline = std::chrono::steady_clock::now() + mission_preconditions.max_tello_state_age;
+
+            while (this->tello_state_stream != nullptr && (!this->tello_state_stream->try_get_tello_state_sample(tello_state_sample) || std::chrono::steady_clock::now() - tello_state_sample.received_at > mission_preconditions.max_tello_state_age) && std::chrono::steady_clock::now() < deadline)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+
+            if (this->tello_state_stream == nullptr || !this->tello_state_stream->try_get_tello_state_sample(tello_state_sample) || std::chrono::steady_clock::now() - tello_state_sample.received_at > mission_preconditions.max_tello_state_age)
+            {
+                failure_message = "Sorry, we don't have fresh enough telemetry from your Tello to check your mission's preconditions.";
+                return false;
+            }
+
+            const TelloState &tello_state = tello_state_sample.tello_state;
+
+            if (tello_state.battery < mission_preconditions.minimum_battery)
+            {
+                failure_message = "Sorry, your Tello's battery is at '" + std::to_string(tello_state.battery) + "%', below your mission's minimum of '" + std::to_string(mission_preconditions.minimum_battery) + "%'.";
+                return false;
+            }
+
+            if (mission_step.kind == MissionStepKind::takeoff)
+            {
+                return true;
+            }
+
+            if (tello_state.height < mission_preconditions.minimum_height_cm)
+            {
+                failure_message = "Sorry, your Tello is at '" + std::to_string(tello_state.height) + "cm', below your mission's minimum of '" + std::to_string(mission_preconditions.minimum_height_cm) + "cm'.";
+                return false;
+            }
+
+            if (mission_preconditions.maximum_height_cm > 0 && tello_state.height > mission_preconditions.maximum_height_cm)
+            {
+                failure_message = "Sorry, your Tello is at '" + std::to_string(tello_state.height) + "cm', above your mission's maximum of '" + std::to_string(mission_preconditions.maximum_height_cm) + "cm'.";
+                return false;
+            }
+
+            return true;
+        }
+
+        MissionResult &fail_mission(MissionResult &mission_result)
+        {
+            if (this->retry_policy.land_on_failure)
+            {
+                try
+                {
+                    this->tello_command_pipeline.send_command(TelloCommands::Land::command_name, this->retry_policy.step_timeout).get();
+                }
+                catch(...)
+                {
+
+                }
+            }
+
+            return mission_result;
+        }
+
+        TelloCommandPipeline &tello_command_pipeline;
+        const TelloStateStream *tello_state_stream;
+        MissionRetryPolicy retry_policy;
+        std::atomic<bool> cancelled{false};
+};
\ No newline at end of file
@@ -0,0 +1,291 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "tello_commands.h"
+
+enum class MissionStepKind
+{
+    takeoff,
+    land,
+    forward,
+    back,
+    up,
+    down,
+    left,
+    right,
+    clockwise,
+    counterclockwise,
+    flip_front,
+    flip_back,
+    flip_left,
+    flip_right,
+    go,
+    curve,
+    speed
+};
+
+struct MissionStep
+{
+    MissionStepKind kind;
+    std::array<int, 7> arguments{};
+
+    bool is_linear_move() const
+    {
+        return this->kind == MissionStepKind::forward || this->kind == MissionStepKind::back || this->kind == MissionStepKind::up || this->kind == MissionStepKind::down || this->kind == MissionStepKind::left || this->kind == MissionStepKind::right;
+    }
+
+    bool is_rotation() const
+    {
+        return this->kind == MissionStepKind::clockwise || this->kind == MissionStepKind::counterclockwise;
+    }
+
+    bool is_motion() const
+    {
+        return this->kind != MissionStepKind::speed && this->kind != MissionStepKind::land;
+    }
+
+    TelloCommandBuffer encode() const
+    {
+        const std::array<int, 7> &argument = this->arguments;
+
+        switch (this->kind)
+        {
+            case MissionStepKind::takeoff: return TelloCommands::Takeoff::encode();
+            case MissionStepKind::land: return TelloCommands::Land::encode();
+            case MissionStepKind::forward: return TelloCommands::Forward::encode(argument[0]);
+            case MissionStepKind::back: return TelloCommands::Back::encode(argument[0]);
+            case MissionStepKind::up: return TelloCommands::Up::encode(argument[0]);
+            case MissionStepKind::down: return TelloCommands::Down::encode(argument[0]);
+            case MissionStepKind::left: return TelloCommands::Left::encode(argument[0]);
+            case MissionStepKind::right: return TelloCommands::Right::encode(argument[0]);
+            case MissionStepKind::clockwise: return TelloCommands::Clockwise::encode(argument[0]);
+            case MissionStepKind::counterclockwise: return TelloCommands::Counterclockwise::encode(argument[0]);
+            case MissionStepKind::flip_front: return TelloCommands::FlipFront::encode();
+            case MissionStepKind::flip_back: return TelloCommands::FlipBack::encode();
+            case MissionStepKind::flip_left: return TelloCommands::FlipLeft::encode();
+            case MissionStepKind::flip_right: return TelloCommands::FlipRight::encode();
+            case MissionStepKind::go: return TelloCommands::Go::encode(argument[0], argument[1], argument[2], argument[3]);
+            case MissionStepKind::curve: return TelloCommands::Curve::encode(argument[0], argument[1], argument[2], argument[3], argument[4], argument[5], argument[6]);
+            case MissionStepKind::speed: return TelloCommands::Speed::encode(argument[0]);
+        }
+
+        throw std::invalid_argument("Sorry, we don't know how to encode that mission step.");
+    }
+};
+
+struct MissionCompileOptions
+{
+    bool merge_moves = true;
+    bool merge_rotations = true;
+    bool merge_moves_into_go = false;
+    int go_speed_cm_per_sec = 0;
+};
+
+struct MissionPreconditions
+{
+    int minimum_battery = 0;
+    int minimum_height_cm = 0;
+    int maximum_height_cm = 0;
+    std::chrono::milliseconds max_tello_state_age{500};
+};
+
+class MissionPlan
+{
+    public:
+        MissionPlan &takeoff() { return this->add_step(MissionStepKind::takeoff); }
+        MissionPlan &land() { return this->add_step(MissionStepKind::land); }
+        MissionPlan &fly_forward(const int &forward_cm) { return this->add_step(MissionStepKind::forward, {forward_cm}); }
+        MissionPlan &fly_backward(const int &backward_cm) { return this->add_step(MissionStepKind::back, {backward_cm}); }
+        MissionPlan &fly_up(const int &up_cm) { return this->add_step(MissionStepKind::up, {up_cm}); }
+        MissionPlan &fly_down(const int &down_cm) { return this->add_step(MissionStepKind::down, {down_cm}); }
+        MissionPlan &fly_left(const int &left_cm) { return this->add_step(MissionStepKind::left, {left_cm}); }
+        MissionPlan &fly_right(const int &right_cm) { return this->add_step(MissionStepKind::right, {right_cm}); }
+        MissionPlan &rotate_clockwise(const int &angle) { return this->add_step(MissionStepKind::clockwise, {angle}); }
+        MissionPlan &rotate_counterclockwise(const int &angle) { return this->add_step(MissionStepKind::counterclockwise, {angle}); }
+        MissionPlan &front_flip() { return this->add_step(MissionStepKind::flip_front); }
+        MissionPlan &back_flip() { return this->add_step(MissionStepKind::flip_back); }
+        MissionPlan &left_flip() { return this->add_step(MissionStepKind::flip_left); }
+        MissionPlan &right_flip() { return this->add_step(MissionStepKind::flip_right); }
+        MissionPlan &set_speed(const int &speed_cm_per_sec) { return this->add_step(MissionStepKind::speed, {speed_cm_per_sec}); }
+
+        MissionPlan &fly_to_position(const int &x_position, const int &y_position, const int &z_position, const int &speed_cm_per_sec)
+        {
+            return this->add_step(MissionStepKind::go, {x_position, y_position, z_position, speed_cm_per_sec});
+        }
+
+        MissionPlan &fly_to_position(const int &x1_position, const int &y1_position, const int &z1_position, const int &x2_position, const int &y2_position, const int &z2_position, const int &speed_cm_per_sec)
+        {
+            return this->add_step(MissionStepKind::curve, {x1_position, y1_position, z1_position, x2_position, y2_position, z2_position, speed_cm_per_sec});
+        }
+
+        MissionPlan &require(const MissionPreconditions &mission_preconditions)
+        {
+            this->mission_preconditions = mission_preconditions;
+            return *this;
+        }
+
+        void validate() const
+        {
+            for (std::size_t step_index = 0; step_index < this->mission_steps.size(); step_index++)
+            {
+                const MissionStep &mission_step = this->mission_steps[step_index];
+
+                try
+                {
+                    mission_step.encode();
+
+                    if (mission_step.kind == MissionStepKind::go)
+                    {
+                        validate_go(mission_step.arguments[0], mission_step.arguments[1], mission_step.arguments[2]);
+                    }
+                }
+                catch(const std::out_of_range &error)
+                {
+                    throw std::out_of_range("Sorry, step '" + std::to_string(step_index) + "' of your mission is invalid. " + error.what());
+                }
+            }
+        }
+
+        MissionPlan compile(const MissionCompileOptions &compile_options = MissionCompileOptions{}) const
+        {
+            this->validate();
+
+            MissionPlan compiled_plan;
+            compiled_plan.mission_preconditions = this->mission_preconditions;
+
+            int current_speed = compile_options.go_speed_cm_per_sec;
+
+            for (const MissionStep &mission_step : this->mission_steps)
+            {
+                if (mission_step.kind == MissionStepKind::speed)
+                {
+                    current_speed = mission_step.arguments[0];
+                }
+
+                if (compiled_plan.mission_steps.empty())
+                {
+                    compiled_plan.mission_steps.push_back(mission_step);
+                    continue;
+                }
+
+                MissionStep &previous_step = compiled_plan.mission_steps.back();
+
+                if (compile_options.merge_moves && mission_step.kind == previous_step.kind && mission_step.is_linear_move() && TelloCommands::distance_cm.contains(previous_step.arguments[0] + mission_step.arguments[0]))
+                {
+                    previous_step.arguments[0] += mission_step.arguments[0];
+                    continue;
+                }
+
+                if (compile_options.merge_rotations && mission_step.kind == previous_step.kind && mission_step.is_rotation() && TelloCommands::angle_degrees.contains(previous_step.arguments[0] + mission_step.arguments[0]))
+                {
+                    previous_step.arguments[0] += mission_step.arguments[0];
+                    continue;
+                }
+
+                if (compile_options.merge_moves_into_go && TelloCommands::go_speed_cm_per_sec.contains(current_speed) && mission_step.is_linear_move() && (previous_step.is_linear_move() || previous_step.kind == MissionStepKind::go))
+                {
+                    std::array<int, 3> previous_offset = previous_step.kind == MissionStepKind::go ? std::array<int, 3>{previous_step.arguments[0], previous_step.arguments[1], previous_step.arguments[2]} : get_go_offset(previous_step);
+                    std::array<int, 3> step_offset = get_go_offset(mission_step);
+                    std::array<int, 3> merged_offset{previous_offset[0] + step_offset[0], previous_offset[1] + step_offset[1], previous_offset[2] + step_offset[2]};
+
+                    bool same_speed = previous_step.kind != MissionStepKind::go || previous_step.arguments[3] == current_speed;
+
+                    if (same_speed && TelloCommands::coordinate_cm.contains(merged_offset[0]) && TelloCommands::coordinate_cm.contains(merged_offset[1]) && TelloCommands::coordinate_cm.contains(merged_offset[2]) && is_valid_go(merged_offset[0], merged_offset[1], merged_offset[2]))
+                    {
+                        previous_step = MissionStep{MissionStepKind::go, {merged_offset[0], merged_offset[1], merged_offset[2], current_speed}};
+                        continue;
+                    }
+                }
+
+                compiled_plan.mission_steps.push_back(mission_step);
+            }
+
+            return compiled_plan;
+        }
+
+        const std::vector<MissionStep> &get_mission_steps() const
+        {
+            return this->mission_steps;
+        }
+
+        const MissionPreconditions &get_mission_preconditions() const
+        {
+            return this->mission_preconditions;
+        }
+
+        std::size_t size() const
+        {
+            return this->mission_steps.size();
+        }
+
+    private:
+        MissionPlan &add_step(const MissionStepKind &kind, std::initializer_list<int> arguments = {})
+        {
+            MissionStep mission_step{kind};
+            std::size_t argument_index = 0;
+
+            for (const int &argument : arguments)
+            {
+                mission_step.arguments[argument_index++] = argument;
+            }
+
+            this->mission_steps.push_back(mission_step);
+            return *this;
+        }
+
+        static std::array<int, 3> get_go_offset(const MissionStep &mission_step)
+        {
+            int distance = mission_step.arguments[0];
+
+            switch (mission_step.kind)
+            {
+                case MissionStepKind::forward: return {distance, 0, 0};
+                case MissionStepKind::back: return {-distance, 0, 0};
+                case MissionStepKind::left: return {0, distance, 0};
+                case MissionStepKind::right: return {0, -distance, 0};
+                case MissionStepKind::up: return {0, 0, distance};
+                case MissionStepKind::down: return {0, 0, -distance};
+                default: return {0, 0, 0};
+            }
+        }
+
+        static bool is_valid_go(const int &x_position, const int &y_position, const int &z_position)
+        {
+            return std::abs(x_position) > 20 || std::abs(y_position) > 20 || std::abs(z_position) > 20;
+        }
+
+        static void validate_go(const int &x_position, const int &y_position, const int &z_position)
+        {
+            if (!is_valid_go(x_position, y_position, z_position))
+            {
+                throw std::out_of_range("Sorry, 'go' needs at least one of x, y and z to be outside '[-20, 20]'.");
+            }
+        }
+
+        std::vector<MissionStep> mission_steps;
+        MissionPreconditions mission_preconditions;
+};
+
+struct MissionRetryPolicy
+{
+    int max_error_retries = 2;
+    int max_timeout_retries = 0;
+    std::chrono::milliseconds retry_delay{200};
+    double retry_backoff = 2;
+    std::chrono::milliseconds step_timeout{12000};
+    bool land_on_failure = false;
+};
+
+struct MissionResult
+{
+    bool completed;
+    std::size_t completed_step_count;
+    std::size_t retry_count;
+    std::string failure_message;
+};
\ No newline at end of file
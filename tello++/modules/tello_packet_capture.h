@@ -0,0 +1,263 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "internals/memory_mapped_file.h"
+
+enum class TelloPacketChannel : std::uint8_t
+{
+    command,
+    state,
+    video,
+    sent_command
+};
+
+struct TelloPacketCaptureHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t reserved_flags;
+    std::uint64_t packet_count;
+    std::uint64_t data_size;
+    std::uint8_t reserved[32];
+};
+
+struct TelloPacketRecordHeader
+{
+    std::int64_t timestamp_nanos;
+    std::uint32_t payload_size;
+    TelloPacketChannel channel;
+    std::uint8_t reserved[3];
+};
+
+struct TelloCapturedPacket
+{
+    std::int64_t timestamp_nanos;
+    TelloPacketChannel channel;
+    std::string_view payload;
+};
+
+class TelloPacketCaptureLayout
+{
+    public:
+        static constexpr char magic[8] = {'T', 'E', 'L', 'L', 'O', 'P', 'C', '\0'};
+        static constexpr std::uint32_t version = 1;
+        static constexpr std::size_t header_size = sizeof(TelloPacketCaptureHeader);
+        static constexpr std::size_t record_header_size = sizeof(TelloPacketRecordHeader);
+
+        static_assert(header_size == 64, "Sorry, the packet capture header has to stay 64 bytes.");
+        static_assert(record_header_size == 16, "Sorry, the packet record header has to stay 16 bytes.");
+
+        static std::size_t get_record_size(const std::size_t &payload_size)
+        {
+            return record_header_size + ((payload_size + 7) & ~static_cast<std::size_t>(7));
+        }
+};
+
+class TelloPacketCapture
+{
+    public:
+        TelloPacketCapture() = default;
+
+        TelloPacketCapture(const std::string &capture_location, const std::size_t &initial_size = 1024 * 1024)
+        {
+            this->open(capture_location, initial_size);
+        }
+
+        TelloPacketCapture(TelloPacketCapture const&) = delete;
+        void operator = (TelloPacketCapture const&) = delete;
+
+        void open(const std::string &capture_location, const std::size_t &initial_size = 1024 * 1024)
+        {
+            std::lock_guard<std::mutex> capture_lock(this->capture_mutex);
+
+            this->close_capture_file();
+
+            this->capture_file = std::make_unique<MemoryMappedFile>(capture_location, true, TelloPacketCaptureLayout::header_size + initial_size);
+            this->data_size = 0;
+            this->packet_count = 0;
+
+            TelloPacketCaptureHeader capture_header{};
+            std::memcpy(capture_header.magic, TelloPacketCaptureLayout::magic, sizeof(capture_header.magic));
+            capture_header.version = TelloPacketCaptureLayout::version;
+
+            std::memcpy(this->capture_file->data(), &capture_header, sizeof(capture_header));
+
+            this->capturing.store(true, std::memory_order_release);
+        }
+
+        void close()
+        {
+            std::lock_guard<std::mutex> capture_lock(this->capture_mutex);
+            this->close_capture_file();
+        }
+
+        bool is_open() const
+        {
+            return this->capturing.load(std::memory_order_acquire);
+        }
+
+        void capture(const TelloPacketChannel &channel, std::string_view payload, const std::int64_t &timestamp_nanos)
+        {
+            if (!this->capturing.load(std::memory_order_relaxed))
+            {
+                return;
+            }
+
+            std::lock_guard<std::mutex> capture_lock(this->capture_mutex);
+
+            if (!this->capture_file)
+            {
+                return;
+            }
+
+            std::size_t record_offset = TelloPacketCaptureLayout::header_size + this->data_size;
+            std::size_t record_size = TelloPacketCaptureLayout::get_record_size(payload.size());
+
+            if (record_offset + record_size > this->capture_file->size())
+            {
+                std::size_t new_size = this->capture_file->size() * 2;
+                this->capture_file->resize(new_size > record_offset + record_size ? new_size : record_offset + record_size);
+            }
+
+            TelloPacketRecordHeader record_header{timestamp_nanos, static_cast<std::uint32_t>(payload.size()), channel, {}};
+
+            std::byte *record = this->capture_file->data() + record_offset;
+            std::memcpy(record, &record_header, sizeof(record_header));
+            std::memcpy(record + sizeof(record_header), payload.data(), payload.size());
+
+            this->data_size += record_size;
+            this->packet_count++;
+
+            TelloPacketCaptureHeader *capture_header = reinterpret_cast<TelloPacketCaptureHeader*>(this->capture_file->data());
+            capture_header->packet_count = this->packet_count;
+            capture_header->data_size = this->data_size;
+        }
+
+        void capture(const TelloPacketChannel &channel, std::string_view payload)
+        {
+            this->capture(channel, payload, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        std::uint64_t get_packet_count() const
+        {
+            std::lock_guard<std::mutex> capture_lock(this->capture_mutex);
+            return this->packet_count;
+        }
+
+        ~TelloPacketCapture()
+        {
+            try
+            {
+                this->close();
+            }
+            catch(...)
+            {
+
+            }
+        }
+
+    private:
+        void close_capture_file()
+        {
+            this->capturing.store(false, std::memory_order_release);
+
+            if (this->capture_file)
+            {
+                this->capture_file->resize(TelloPacketCaptureLayout::header_size + this->data_size);
+                this->capture_file.reset();
+            }
+        }
+
+        mutable std::mutex capture_mutex;
+        std::atomic<bool> capturing{false};
+        std::unique_ptr<MemoryMappedFile> capture_file;
+        std::size_t data_size = 0;
+        std::uint64_t packet_count = 0;
+};
+
+class TelloPacketRecording
+{
+    public:
+        TelloPacketRecording(const std::string &capture_location) :
+        capture_file{capture_location, false}
+        {
+            if (this->capture_file.size() < TelloPacketCaptureLayout::header_size)
+            {
+                throw std::runtime_error("Sorry, '" + capture_location + "' is too small to be a packet capture.");
+            }
+
+            TelloPacketCaptureHeader capture_header;
+            std::memcpy(&capture_header, this->capture_file.data(), sizeof(capture_header));
+
+            if (std::memcmp(capture_header.magic, TelloPacketCaptureLayout::magic, sizeof(capture_header.magic)) != 0 || capture_header.version != TelloPacketCaptureLayout::version)
+            {
+                throw std::runtime_error("Sorry, '" + capture_location + "' isn't a packet capture we can read.");
+            }
+
+            if (TelloPacketCaptureLayout::header_size + capture_header.data_size > this->capture_file.size())
+            {
+                throw std::runtime_error("Sorry, '" + capture_location + "' is truncated.");
+            }
+
+            this->record_offsets.reserve(capture_header.packet_count);
+
+            std::size_t record_offset = TelloPacketCaptureLayout::header_size;
+            std::size_t data_end = TelloPacketCaptureLayout::header_size + capture_header.data_size;
+
+            while (record_offset + TelloPacketCaptureLayout::record_header_size <= data_end)
+            {
+                TelloPacketRecordHeader record_header;
+                std::memcpy(&record_header, this->capture_file.data() + record_offset, sizeof(record_header));
+
+                std::size_t record_size = TelloPacketCaptureLayout::get_record_size(record_header.payload_size);
+
+                if (record_offset + record_size > data_end)
+                {
+                    throw std::runtime_error("Sorry, '" + capture_location + "' is truncated.");
+                }
+
+                this->record_offsets.push_back(record_offset);
+                record_offset += record_size;
+            }
+        }
+
+        std::size_t get_packet_count() const
+        {
+            return this->record_offsets.size();
+        }
+
+        TelloCapturedPacket get_packet(const std::size_t &packet_index) const
+        {
+            if (packet_index >= this->record_offsets.size())
+            {
+                throw std::out_of_range("Sorry, that packet isn't in this capture.");
+            }
+
+            const std::byte *record = this->capture_file.data() + this->record_offsets[packet_index];
+
+            TelloPacketRecordHeader record_header;
+            std::memcpy(&record_header, record, sizeof(record_header));
+
+            return TelloCapturedPacket
+            {
+                record_header.timestamp_nanos,
+                record_header.channel,
+                std::string_view(reinterpret_cast<const char*>(record + sizeof(record_header)), record_header.payload_size)
+            };
+        }
+
+    private:
+        MemoryMappedFile capture_file;
+        std::vector<std::size_t> record_offsets;
+};
\ No newline at end of file
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "tello_endpoint.h"
+#include "tello_logger.h"
+#include "tello_packet_capture.h"
+#include "tello_socket.h"
+
+struct TelloReplayResult
+{
+    std::uint64_t replayed_state_packets;
+    std::uint64_t replayed_video_packets;
+    std::chrono::nanoseconds recorded_duration;
+    std::chrono::nanoseconds replay_duration;
+};
+
+class TelloPacketReplayer
+{
+    public:
+        static constexpr double max_replay_speed = 0;
+        static constexpr int max_replay_batch_size = 64;
+
+        bool tello_logging = false;
+
+        TelloPacketReplayer(const TelloPacketRecording &packet_recording, const TelloEndpoint &tello_endpoint) :
+        packet_recording{packet_recording},
+        tello_logger{TelloLogger(this->tello_logging)},
+        tello_state_sender{tello_logger, 1, get_replay_target_ip(tello_endpoint, tello_endpoint.tello_state_receiver_ip), tello_endpoint.tello_state_receiver_port, tello_endpoint.tello_ip, 0},
+        tello_video_sender{tello_logger, 1, get_replay_target_ip(tello_endpoint, tello_endpoint.tello_video_receiver_ip), tello_endpoint.tello_video_receiver_port, tello_endpoint.tello_ip, 0}
+        {}
+
+        TelloPacketReplayer(TelloPacketReplayer const&) = delete;
+        void operator = (TelloPacketReplayer const&) = delete;
+
+        TelloReplayResult replay(const double &replay_speed = 1)
+        {
+            if (replay_speed < 0)
+            {
+                throw std::invalid_argument("Sorry, you can't replay a capture backwards.");
+            }
+
+            this->stopping.store(false, std::memory_order_relaxed);
+
+            TelloReplayResult replay_result{0, 0, std::chrono::nanoseconds(0), std::chrono::nanoseconds(0)};
+            std::size_t packet_count = this->packet_recording.get_packet_count();
+
+            auto replay_start = std::chrono::steady_clock::now();
+
+            if (packet_count == 0)
+            {
+                return replay_result;
+            }
+
+            std::int64_t first_timestamp_nanos = this->packet_recording.get_packet(0).timestamp_nanos;
+            std::string_view replay_batch[max_replay_batch_size];
+
+            for (std::size_t packet_index = 0; packet_index < packet_count && !this->stopping.load(std::memory_order_relaxed);)
+            {
+                TelloCapturedPacket first_packet = this->packet_recording.get_packet(packet_index);
+
+                if (replay_speed != max_replay_speed)
+                {
+                    std::this_thread::sleep_until(replay_start + this->get_replay_offset(first_packet.timestamp_nanos - first_timestamp_nanos, replay_speed));
+                }
+
+                auto now = std::chrono::steady_clock::now();
+                int batch_size = 0;
+
+                for (; packet_index < packet_count && batch_size < max_replay_batch_size; packet_index++)
+                {
+                    TelloCapturedPacket packet = this->packet_recording.get_packet(packet_index);
+
+                    if (packet.channel != first_packet.channel || (replay_speed != max_replay_speed && replay_start + this->get_replay_offset(packet.timestamp_nanos - first_timestamp_nanos, replay_speed) > now))
+                    {
+                        break;
+                    }
+
+                    replay_batch[batch_size++] = packet.payload;
+                    replay_result.recorded_duration = std::chrono::nanoseconds(packet.timestamp_nanos - first_timestamp_nanos);
+                }
+
+                switch (first_packet.channel)
+                {
+                    case TelloPacketChannel::state:
+                        this->send_replay_batch(this->tello_state_sender, replay_batch, batch_size);
+                        replay_result.replayed_state_packets += batch_size;
+                        break;
+                    case TelloPacketChannel::video:
+                        this->send_replay_batch(this->tello_video_sender, replay_batch, batch_size);
+                        replay_result.replayed_video_packets += batch_size;
+                        break;
+                    default:
+                        break;
+                }
+            }
+
+            replay_result.replay_duration = std::chrono::steady_clock::now() - replay_start;
+
+            return replay_result;
+        }
+
+        void stop()
+        {
+            this->stopping.store(true, std::memory_order_relaxed);
+        }
+
+    private:
+        static std::string get_replay_target_ip(const TelloEndpoint &tello_endpoint, const std::string &receiver_ip)
+        {
+            return receiver_ip == "0.0.0.0" ? tello_endpoint.tello_ip : receiver_ip;
+        }
+
+        static std::chrono::nanoseconds get_replay_offset(const std::int64_t &recorded_offset_nanos, const double &replay_speed)
+        {
+            return std::chrono::nanoseconds(static_cast<std::int64_t>(static_cast<double>(recorded_offset_nanos) / replay_speed));
+        }
+
+        static void send_replay_batch(TelloSocket &tello_sender, const std::string_view *replay_batch, const int &batch_size)
+        {
+            for (int sent_count = 0; sent_count < batch_size;)
+            {
+                sent_count += tello_sender.send_datagrams(replay_batch + sent_count, batch_size - sent_count);
+            }
+        }
+
+        const TelloPacketRecording &packet_recording;
+        TelloLogger tello_logger;
+        TelloSocket tello_state_sender;
+        TelloSocket tello_video_sender;
+        std::atomic<bool> stopping{false};
+};
\ No newline at end of file
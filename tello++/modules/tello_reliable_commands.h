@@ -0,0 +1,124 @@
+#pragma once
+
+#include <charconv>
+#include <string>
+#include <string_view>
+
+#include "internals/util.h"
+
+#include "tello_state.h"
+
+inline bool is_tello_query_command(std::string_view command)
+{
+    return !command.empty() && command.back() == '?';
+}
+
+inline bool is_idempotent_tello_command(std::string_view command)
+{
+    return is_tello_query_command(command) || command == "command" || command == "streamon" || command == "streamoff" || command.starts_with("speed ");
+}
+
+inline bool is_plausible_tello_response(std::string_view command, std::string_view response)
+{
+    if (is_tello_query_command(command))
+    {
+        return response != "ok";
+    }
+
+    return response == "ok" || response.starts_with("error");
+}
+
+enum class MotionOutcome
+{
+    taken_effect,
+    not_started,
+    unknown
+};
+
+class TelloMotionGuard
+{
+    public:
+        static constexpr int height_tolerance_cm = 5;
+        static constexpr int yaw_tolerance_degrees = 3;
+
+        TelloMotionGuard(std::string_view command, const TelloState &tello_state_before) :
+        tello_state_before{tello_state_before}
+        {
+            std::size_t separator = command.find(' ');
+
+            this->command_name = std::string(command.substr(0, separator));
+
+            if (separator != std::string_view::npos)
+            {
+                std::string_view argument_view = strip(command.substr(separator + 1));
+                std::from_chars(argument_view.data(), argument_view.data() + argument_view.size(), this->argument);
+            }
+        }
+
+        MotionOutcome evaluate(const TelloState &tello_state_after) const
+        {
+            int height_change = tello_state_after.height - this->tello_state_before.height;
+            int yaw_change = normalize_yaw_change(tello_state_after.imu_attitude.yaw - this->tello_state_before.imu_attitude.yaw);
+
+            if (this->command_name == "takeoff")
+            {
+                return this->classify(this->tello_state_before.height <= height_tolerance_cm && height_change >= 2 * height_tolerance_cm, height_change, height_tolerance_cm);
+            }
+
+            if (this->command_name == "land")
+            {
+                return this->classify(this->tello_state_before.height > height_tolerance_cm && tello_state_after.height <= height_tolerance_cm, height_change, height_tolerance_cm);
+            }
+
+            if (this->command_name == "up" && this->argument > 0)
+            {
+                return this->classify(height_change >= this->argument / 2, height_change, height_tolerance_cm);
+            }
+
+            if (this->command_name == "down" && this->argument > 0)
+            {
+                return this->classify(-height_change >= this->argument / 2 || tello_state_after.height <= height_tolerance_cm, height_change, height_tolerance_cm);
+            }
+
+            if ((this->command_name == "cw" || this->command_name == "ccw") && this->argument % 360 != 0)
+            {
+                int expected_yaw_change = normalize_yaw_change(this->command_name == "cw" ? this->argument : -this->argument);
+                int yaw_error = normalize_yaw_change(yaw_change - expected_yaw_change);
+
+                return this->classify((yaw_error < 0 ? -yaw_error : yaw_error) <= 10, yaw_change, yaw_tolerance_degrees);
+            }
+
+            return MotionOutcome::unknown;
+        }
+
+    private:
+        static int normalize_yaw_change(int yaw_change)
+        {
+            yaw_change %= 360;
+
+            if (yaw_change > 180)
+            {
+                yaw_change -= 360;
+            }
+            else if (yaw_change < -180)
+            {
+                yaw_change += 360;
+            }
+
+            return yaw_change;
+        }
+
+        static MotionOutcome classify(const bool &has_taken_effect, const int &observed_change, const int &tolerance)
+        {
+            if (has_taken_effect)
+            {
+                return MotionOutcome::taken_effect;
+            }
+
+            return (observed_change < 0 ? -observed_change : observed_change) <= tolerance ? MotionOutcome::not_started : MotionOutcome::unknown;
+        }
+
+        std::string command_name;
+        int argument = 0;
+        TelloState tello_state_before;
+};
\ No newline at end of file
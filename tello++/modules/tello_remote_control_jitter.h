@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstdint>
+
+struct RemoteControlJitter
+{
+    std::uint64_t sent_count;
+    std::uint64_t missed_tick_count;
+    double mean_jitter_micros;
+    double jitter_deviation_micros;
+    double max_jitter_micros;
+};
\ No newline at end of file
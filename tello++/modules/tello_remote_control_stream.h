@@ -0,0 +1,184 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+
+#include "tello_commands.h"
+#include "tello_remote_control_jitter.h"
+#include "tello_socket.h"
+
+class TelloRemoteControlStream
+{
+    public:
+        TelloRemoteControlStream(TelloSocket &tello_client, const int &send_rate_hz = 50) :
+        tello_client{tello_client}
+        {
+            this->set_send_rate(send_rate_hz);
+        }
+
+        TelloRemoteControlStream(TelloRemoteControlStream const&) = delete;
+        void operator = (TelloRemoteControlStream const&) = delete;
+
+        void set_send_rate(const int &send_rate_hz)
+        {
+            if (send_rate_hz <= 0 || send_rate_hz > 1000)
+            {
+                throw std::out_of_range("Sorry, your remote control send rate has to be between 1 and 1000 Hz.");
+            }
+
+            this->send_period_micros.store(1000000 / send_rate_hz, std::memory_order_relaxed);
+        }
+
+        void set_sticks(const int &roll, const int &pitch, const int &up_down, const int &yaw)
+        {
+            if (!TelloCommands::stick.contains(roll) || !TelloCommands::stick.contains(pitch) || !TelloCommands::stick.contains(up_down) || !TelloCommands::stick.contains(yaw))
+            {
+                throw std::out_of_range("Sorry, your remote control sticks have to be between -100 and 100.");
+            }
+
+            this->sticks.store(pack_sticks(roll, pitch, up_down, yaw), std::memory_order_relaxed);
+        }
+
+        void start()
+        {
+            if (this->running.exchange(true))
+            {
+                return;
+            }
+
+            this->sticks.store(0, std::memory_order_relaxed);
+            this->sender_thread = std::thread(&TelloRemoteControlStream::send_sticks, this);
+        }
+
+        void stop()
+        {
+            if (!this->running.exchange(false))
+            {
+                return;
+            }
+
+            this->sender_thread.join();
+            this->sticks.store(0, std::memory_order_relaxed);
+
+            try
+            {
+                this->tello_client.send_data(TelloCommands::RemoteControl::encode(0, 0, 0, 0));
+            }
+            catch(const std::runtime_error&)
+            {
+
+            }
+        }
+
+        bool is_running() const
+        {
+            return this->running.load(std::memory_order_relaxed);
+        }
+
+        RemoteControlJitter get_jitter() const
+        {
+            std::uint64_t sent_count = this->sent_count.load(std::memory_order_relaxed);
+            double jitter_sum = this->jitter_sum_micros.load(std::memory_order_relaxed);
+            double jitter_square_sum = this->jitter_square_sum_micros.load(std::memory_order_relaxed);
+
+            double mean_jitter = sent_count > 0 ? jitter_sum / sent_count : 0;
+            double jitter_variance = sent_count > 0 ? (jitter_square_sum / sent_count) - (mean_jitter * mean_jitter) : 0;
+
+            return RemoteControlJitter
+            {
+                sent_count,
+                this->missed_tick_count.load(std::memory_order_relaxed),
+                mean_jitter,
+                std::sqrt(jitter_variance > 0 ? jitter_variance : 0),
+                this->max_jitter_micros.load(std::memory_order_relaxed)
+            };
+        }
+
+        ~TelloRemoteControlStream()
+        {
+            this->stop();
+        }
+
+    private:
+        static std::uint32_t pack_sticks(const int &roll, const int &pitch, const int &up_down, const int &yaw)
+        {
+            return static_cast<std::uint32_t>(static_cast<std::uint8_t>(roll))
+                | (static_cast<std::uint32_t>(static_cast<std::uint8_t>(pitch)) << 8)
+                | (static_cast<std::uint32_t>(static_cast<std::uint8_t>(up_down)) << 16)
+                | (static_cast<std::uint32_t>(static_cast<std::uint8_t>(yaw)) << 24);
+        }
+
+        static int unpack_stick(const std::uint32_t &packed_sticks, const int &stick_index)
+        {
+            return static_cast<std::int8_t>(static_cast<std::uint8_t>(packed_sticks >> (stick_index * 8)));
+        }
+
+        void send_sticks()
+        {
+            auto next_tick = std::chrono::steady_clock::now();
+
+            while (this->running.load(std::memory_order_relaxed))
+            {
+                std::chrono::microseconds send_period(this->send_period_micros.load(std::memory_order_relaxed));
+
+                next_tick += send_period;
+                std::this_thread::sleep_until(next_tick);
+
+                auto woke_at = std::chrono::steady_clock::now();
+
+                std::uint32_t packed_sticks = this->sticks.load(std::memory_order_relaxed);
+
+                try
+                {
+                    this->tello_client.send_data
+                    (
+                        TelloCommands::RemoteControl::encode(unpack_stick(packed_sticks, 0), unpack_stick(packed_sticks, 1), unpack_stick(packed_sticks, 2), unpack_stick(packed_sticks, 3))
+                    );
+                }
+                catch(const std::runtime_error&)
+                {
+
+                }
+
+                this->record_jitter(std::chrono::duration<double, std::micro>(woke_at - next_tick).count());
+
+                if (woke_at - next_tick > send_period)
+                {
+                    std::uint64_t missed_ticks = (woke_at - next_tick) / send_period;
+
+                    this->missed_tick_count.fetch_add(missed_ticks, std::memory_order_relaxed);
+                    next_tick += send_period * missed_ticks;
+                }
+            }
+        }
+
+        void record_jitter(const double &jitter_micros)
+        {
+            this->sent_count.fetch_add(1, std::memory_order_relaxed);
+            this->jitter_sum_micros.store(this->jitter_sum_micros.load(std::memory_order_relaxed) + jitter_micros, std::memory_order_relaxed);
+            this->jitter_square_sum_micros.store(this->jitter_square_sum_micros.load(std::memory_order_relaxed) + jitter_micros * jitter_micros, std::memory_order_relaxed);
+
+            if (jitter_micros > this->max_jitter_micros.load(std::memory_order_relaxed))
+            {
+                this->max_jitter_micros.store(jitter_micros, std::memory_order_relaxed);
+            }
+        }
+
+        TelloSocket &tello_client;
+
+        std::atomic<std::uint32_t> sticks{0};
+        std::atomic<std::int64_t> send_period_micros{20000};
+
+        std::atomic<bool> running{false};
+        std::thread sender_thread;
+
+        std::atomic<std::uint64_t> sent_count{0};
+        std::atomic<std::uint64_t> missed_tick_count{0};
+        std::atomic<double> jitter_sum_micros{0};
+        std::atomic<double> jitter_square_sum_micros{0};
+        std::atomic<double> max_jitter_micros{0};
+};
\ No newline at end of file
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+
+class TelloRttEstimator
+{
+    public:
+        TelloRttEstimator
+        (
+        const std::chrono::microseconds &initial_timeout = std::chrono::milliseconds(200),
+        const std::chrono::microseconds &minimum_timeout = std::chrono::milliseconds(20),
+        const std::chrono::microseconds &maximum_timeout = std::chrono::seconds(2)
+        ) :
+        retransmission_timeout{initial_timeout},
+        initial_timeout{initial_timeout},
+        minimum_timeout{minimum_timeout},
+        maximum_timeout{maximum_timeout}
+        {}
+
+        void add_sample(const std::chrono::microseconds &round_trip_time)
+        {
+            std::lock_guard<std::mutex> estimator_lock(this->estimator_mutex);
+
+            double sample_micros = static_cast<double>(round_trip_time.count());
+
+            if (this->sample_count == 0)
+            {
+                this->smoothed_rtt_micros = sample_micros;
+                this->rtt_variation_micros = sample_micros / 2;
+            }
+            else
+            {
+                double rtt_error = sample_micros - this->smoothed_rtt_micros;
+
+                this->rtt_variation_micros += rtt_variation_gain * ((rtt_error < 0 ? -rtt_error : rtt_error) - this->rtt_variation_micros);
+                this->smoothed_rtt_micros += smoothed_rtt_gain * rtt_error;
+            }
+
+            this->sample_count++;
+            this->retransmission_timeout = this->estimate_timeout();
+        }
+
+        void back_off()
+        {
+            std::lock_guard<std::mutex> estimator_lock(this->estimator_mutex);
+            this->retransmission_timeout = this->clamp_timeout(this->retransmission_timeout * 2);
+        }
+
+        void reset_back_off()
+        {
+            std::lock_guard<std::mutex> estimator_lock(this->estimator_mutex);
+            this->retransmission_timeout = this->estimate_timeout();
+        }
+
+        std::chrono::microseconds get_retransmission_timeout() const
+        {
+            std::lock_guard<std::mutex> estimator_lock(this->estimator_mutex);
+            return this->retransmission_timeout;
+        }
+
+        std::chrono::microseconds get_smoothed_rtt() const
+        {
+            std::lock_guard<std::mutex> estimator_lock(this->estimator_mutex);
+            return std::chrono::microseconds(static_cast<long long>(this->smoothed_rtt_micros));
+        }
+
+        std::chrono::microseconds get_rtt_variation() const
+        {
+            std::lock_guard<std::mutex> estimator_lock(this->estimator_mutex);
+            return std::chrono::microseconds(static_cast<long long>(this->rtt_variation_micros));
+        }
+
+        std::uint64_t get_sample_count() const
+        {
+            std::lock_guard<std::mutex> estimator_lock(this->estimator_mutex);
+            return this->sample_count;
+        }
+
+    private:
+        static constexpr double smoothed_rtt_gain = 1.0 / 8;
+        static constexpr double rtt_variation_gain = 1.0 / 4;
+        static constexpr double variation_multiplier = 4;
+
+        std::chrono::microseconds clamp_timeout(const std::chrono::microseconds &timeout) const
+        {
+            return timeout < this->minimum_timeout ? this->minimum_timeout : (timeout > this->maximum_timeout ? this->maximum_timeout : timeout);
+        }
+
+        std::chrono::microseconds estimate_timeout() const
+        {
+            if (this->sample_count == 0)
+            {
+                return this->initial_timeout;
+            }
+
+            return this->clamp_timeout(std::chrono::microseconds(static_cast<long long>(this->smoothed_rtt_micros + variation_multiplier * this->rtt_variation_micros)));
+        }
+
+        mutable std::mutex estimator_mutex;
+
+        double smoothed_rtt_micros = 0;
+        double rtt_variation_micros = 0;
+        std::uint64_t sample_count = 0;
+
+        std::chrono::microseconds retransmission_timeout;
+        std::chrono::microseconds initial_timeout;
+        std::chrono::microseconds minimum_timeout;
+        std::chrono::microseconds maximum_timeout;
+};
\ No newline at end of file
@@ -0,0 +1,548 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "tello_commands.h"
+#include "tello_endpoint.h"
+#include "tello_logger.h"
+#include "tello_socket.h"
+
+struct TelloNetworkConditions
+{
+    double loss_probability = 0;
+    double reorder_probability = 0;
+    int minimum_delay_micros = 0;
+    int maximum_delay_micros = 0;
+};
+
+struct TelloSimulatorSettings
+{
+    std::string simulator_ip = "127.0.0.1";
+    int simulator_port = 18889;
+    std::string client_ip = "127.0.0.1";
+    int client_port = 19000;
+    int state_port = 18890;
+    int video_port = 11112;
+
+    int state_rate_hz = 10;
+    int video_rate_fps = 30;
+    int video_access_unit_size = 8000;
+    bool simulate_motion_time = false;
+
+    TelloNetworkConditions network_conditions;
+    unsigned int random_seed = 5489;
+};
+
+class TelloSimulator
+{
+    public:
+        bool tello_logging = false;
+
+        TelloSimulator(const TelloSimulatorSettings &simulator_settings = TelloSimulatorSettings{}) :
+        simulator_settings{simulator_settings},
+        tello_logger{TelloLogger(this->tello_logging)},
+        command_socket{tello_logger, 1, simulator_settings.client_ip, simulator_settings.client_port, simulator_settings.simulator_ip, simulator_settings.simulator_port},
+        state_socket{tello_logger, 1, simulator_settings.client_ip, simulator_settings.state_port, simulator_settings.simulator_ip, 0},
+        video_socket{tello_logger, 1, simulator_settings.client_ip, simulator_settings.video_port, simulator_settings.simulator_ip, 0},
+        random_engine{simulator_settings.random_seed}
+        {
+            this->command_socket.set_receive_timeout(50);
+            this->build_video_access_unit();
+        }
+
+        TelloSimulator(TelloSimulator const&) = delete;
+        void operator = (TelloSimulator const&) = delete;
+
+        TelloEndpoint get_tello_endpoint() const
+        {
+            return TelloEndpoint
+            {
+                this->simulator_settings.simulator_ip,
+                this->simulator_settings.simulator_port,
+                this->simulator_settings.client_ip,
+                this->simulator_settings.client_port,
+                this->simulator_settings.client_ip,
+                this->simulator_settings.state_port,
+                this->simulator_settings.client_ip,
+                this->simulator_settings.video_port
+            };
+        }
+
+        void start()
+        {
+            if (this->running.exchange(true))
+            {
+                return;
+            }
+
+            this->command_thread = std::thread(&TelloSimulator::answer_commands, this);
+            this->emitter_thread = std::thread(&TelloSimulator::emit_datagrams, this);
+        }
+
+        void stop()
+        {
+            if (!this->running.exchange(false))
+            {
+                return;
+            }
+
+            this->scheduled_condition.notify_all();
+            this->command_thread.join();
+            this->emitter_thread.join();
+        }
+
+        void set_network_conditions(const TelloNetworkConditions &network_conditions)
+        {
+            std::lock_guard<std::mutex> scheduled_lock(this->scheduled_mutex);
+            this->simulator_settings.network_conditions = network_conditions;
+        }
+
+        void set_video_streaming(const bool &video_streaming)
+        {
+            this->video_streaming.store(video_streaming, std::memory_order_relaxed);
+        }
+
+        std::uint64_t get_received_command_count() const
+        {
+            return this->received_commands.load(std::memory_order_relaxed);
+        }
+
+        std::uint64_t get_sent_state_count() const
+        {
+            return this->sent_states.load(std::memory_order_relaxed);
+        }
+
+        std::uint64_t get_sent_video_access_unit_count() const
+        {
+            return this->sent_video_access_units.load(std::memory_order_relaxed);
+        }
+
+        ~TelloSimulator()
+        {
+            this->stop();
+        }
+
+    private:
+        enum class SimulatorChannel
+        {
+            command,
+            state,
+            video
+        };
+
+        struct ScheduledDatagram
+        {
+            std::chrono::steady_clock::time_point send_at;
+            std::uint64_t sequence;
+            SimulatorChannel channel;
+            std::string payload;
+            sockaddr_in reply_address;
+
+            bool operator > (const ScheduledDatagram &other) const
+            {
+                return this->send_at != other.send_at ? this->send_at > other.send_at : this->sequence > other.sequence;
+            }
+        };
+
+        struct SimulatedTello
+        {
+            bool flying = false;
+            int height = 0;
+            int yaw = 0;
+            int battery = 87;
+            int speed = 10;
+            std::chrono::steady_clock::time_point takeoff_time;
+        };
+
+        void answer_commands()
+        {
+            char command_buffer[256];
+            TelloDatagram command_datagram{command_buffer, sizeof(command_buffer), 0, {}};
+
+            while (this->running.load(std::memory_order_relaxed))
+            {
+                int received_count;
+
+                try
+                {
+                    received_count = this->command_socket.receive_datagrams(&command_datagram, 1);
+                }
+                catch(const std::runtime_error&)
+                {
+                    continue;
+                }
+
+                if (received_count <= 0)
+                {
+                    continue;
+                }
+
+                this->received_commands.fetch_add(1, std::memory_order_relaxed);
+
+                std::string_view command(command_buffer, command_datagram.size);
+                std::string response = this->execute_command(command);
+
+                if (!response.empty())
+                {
+                    this->schedule_datagram(SimulatorChannel::command, std::move(response), command_datagram.source_address);
+                }
+            }
+        }
+
+        std::string execute_command(std::string_view command)
+        {
+            std::unique_lock<std::mutex> simulated_tello_lock(this->simulated_tello_mutex);
+
+            std::string_view command_name = command.substr(0, command.find(' '));
+            int argument = 0;
+
+            if (command_name.size() < command.size())
+            {
+                std::string_view argument_text = command.substr(command_name.size() + 1);
+                std::from_chars(argument_text.data(), argument_text.data() + argument_text.size(), argument);
+            }
+
+            if (command_name == TelloCommands::RemoteControl::command_name)
+            {
+                return "";
+            }
+
+            if (command_name == TelloCommands::BatteryQuery::command_name)
+            {
+                return std::to_string(this->simulated_tello.battery);
+            }
+
+            if (command_name == TelloCommands::SpeedQuery::command_name)
+            {
+                return std::to_string(this->simulated_tello.speed) + ".0";
+            }
+
+            if (command_name == TelloCommands::TimeQuery::command_name)
+            {
+                return std::to_string(this->get_flight_time()) + "s";
+            }
+
+            if (command_name == TelloCommands::HeightQuery::command_name)
+            {
+                return std::to_string(this->simulated_tello.height / 10) + "dm";
+            }
+
+            if (command_name == TelloCommands::TempratureQuery::command_name)
+            {
+                return "62~65C";
+            }
+
+            if (command_name == TelloCommands::AttitudeQuery::command_name)
+            {
+                return "pitch:0;roll:0;yaw:" + std::to_string(this->simulated_tello.yaw) + ";";
+            }
+
+            if (command_name == TelloCommands::BarometerQuery::command_name)
+            {
+                return "-57.82";
+            }
+
+            if (command_name == TelloCommands::AccelerationQuery::command_name)
+            {
+                return "agx:-3.00;agy:-12.00;agz:-999.00;";
+            }
+
+            if (command_name == TelloCommands::DistanceFromTakeoffQuery::command_name)
+            {
+                return std::to_string((this->simulated_tello.height + 10) * 10) + "mm";
+            }
+
+            if (command_name == TelloCommands::WifiQuery::command_name)
+            {
+                return "90";
+            }
+
+
+            int motion_cm = 0;
+
+            if (command_name == TelloCommands::Takeoff::command_name)
+            {
+                this->simulated_tello.flying = true;
+                this->simulated_tello.height = 80;
+                this->simulated_tello.takeoff_time = std::chrono::steady_clock::now();
+                motion_cm = 80;
+            }
+            else if (command_name == TelloCommands::Land::command_name || command_name == TelloCommands::Emergency::command_name)
+            {
+                motion_cm = this->simulated_tello.height;
+                this->simulated_tello.flying = false;
+                this->simulated_tello.height = 0;
+            }
+            else if (command_name == TelloCommands::Up::command_name)
+            {
+                this->simulated_tello.height += argument;
+                motion_cm = argument;
+            }
+            else if (command_name == TelloCommands::Down::command_name)
+            {
+                this->simulated_tello.height = std::max(0, this->simulated_tello.height - argument);
+                motion_cm = argument;
+            }
+            else if (command_name == TelloCommands::Clockwise::command_name)
+            {
+                this->simulated_tello.yaw = (this->simulated_tello.yaw + argument) % 360;
+            }
+            else if (command_name == TelloCommands::Counterclockwise::command_name)
+            {
+                this->simulated_tello.yaw = (this->simulated_tello.yaw + 360 - argument % 360) % 360;
+            }
+            else if (command_name == TelloCommands::Speed::command_name)
+            {
+                this->simulated_tello.speed = argument;
+            }
+            else if (command_name == TelloCommands::Forward::command_name || command_name == TelloCommands::Back::command_name || command_name == TelloCommands::Left::command_name || command_name == TelloCommands::Right::command_name)
+            {
+                motion_cm = argument;
+            }
+            else if (command_name == "streamon")
+            {
+                this->video_streaming.store(true, std::memory_order_relaxed);
+            }
+            else if (command_name == "streamoff")
+            {
+                this->video_streaming.store(false, std::memory_order_relaxed);
+            }
+            else if
+            (
+                command_name != TelloCommands::Command::command_name &&
+                command_name != TelloCommands::Go::command_name &&
+                command_name != TelloCommands::Curve::command_name &&
+                command_name != "flip" &&
+                command_name != "wifi"
+            )
+            {
+                return "error";
+            }
+
+            if (this->simulator_settings.simulate_motion_time && motion_cm > 0)
+            {
+                std::chrono::milliseconds motion_time(motion_cm * 1000 / std::max(this->simulated_tello.speed, 1));
+
+                simulated_tello_lock.unlock();
+                std::this_thread::sleep_for(motion_time);
+            }
+
+            return "ok";
+        }
+
+        int get_flight_time() const
+        {
+            if (!this->simulated_tello.flying)
+            {
+                return 0;
+            }
+
+            return static_cast<int>(std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - this->simulated_tello.takeoff_time).count());
+        }
+
+        std::string format_tello_state()
+        {
+            std::lock_guard<std::mutex> simulated_tello_lock(this->simulated_tello_mutex);
+
+            char tello_state[256];
+            int tello_state_size = std::snprintf
+            (
+                tello_state,
+                sizeof(tello_state),
+                "pitch:0;roll:0;yaw:%i;vgx:0;vgy:0;vgz:0;templ:62;temph:65;tof:%i;h:%i;bat:%i;baro:-57.82;time:%i;agx:-3.00;agy:-12.00;agz:-999.00;\r\n",
+                this->simulated_tello.yaw,
+                this->simulated_tello.height + 10,
+                this->simulated_tello.height,
+                this->simulated_tello.battery,
+                this->get_flight_time()
+            );
+
+            return std::string(tello_state, tello_state_size);
+        }
+
+        void build_video_access_unit()
+        {
+            int access_unit_size = std::max(this->simulator_settings.video_access_unit_size, 5);
+
+            if (access_unit_size % TelloVideoFragmentSize == 0)
+            {
+                access_unit_size++;
+            }
+
+            this->video_access_unit.assign(access_unit_size, '\x55');
+            this->video_access_unit[0] = '\x00';
+            this->video_access_unit[1] = '\x00';
+            this->video_access_unit[2] = '\x00';
+            this->video_access_unit[3] = '\x01';
+        }
+
+        void schedule_datagram(const SimulatorChannel &channel, std::string payload, const sockaddr_in &reply_address = sockaddr_in{})
+        {
+            std::unique_lock<std::mutex> scheduled_lock(this->scheduled_mutex);
+
+            const TelloNetworkConditions &network_conditions = this->simulator_settings.network_conditions;
+
+            if (network_conditions.loss_probability > 0 && this->probability(this->random_engine) < network_conditions.loss_probability)
+            {
+                return;
+            }
+
+            int delay_micros = network_conditions.minimum_delay_micros;
+
+            if (network_conditions.maximum_delay_micros > network_conditions.minimum_delay_micros)
+            {
+                delay_micros = std::uniform_int_distribution<int>(network_conditions.minimum_delay_micros, network_conditions.maximum_delay_micros)(this->random_engine);
+            }
+
+            if (network_conditions.reorder_probability > 0 && this->probability(this->random_engine) < network_conditions.reorder_probability)
+            {
+                delay_micros += std::max(network_conditions.maximum_delay_micros, 1000);
+            }
+
+            if (delay_micros <= 0)
+            {
+                scheduled_lock.unlock();
+                this->send_datagram(channel, payload, reply_address);
+                return;
+            }
+
+            this->scheduled_datagrams.push(ScheduledDatagram{std::chrono::steady_clock::now() + std::chrono::microseconds(delay_micros), this->scheduled_sequence++, channel, std::move(payload), reply_address});
+            this->scheduled_condition.notify_all();
+        }
+
+        void send_datagram(const SimulatorChannel &channel, std::string_view payload, const sockaddr_in &reply_address)
+        {
+            try
+            {
+                switch (channel)
+                {
+                    case SimulatorChannel::command:
+                        if (reply_address.sin_family == AF_INET)
+                        {
+                            this->command_socket.send_data(payload, reply_address);
+                        }
+                        else
+                        {
+                            this->command_socket.send_data(payload);
+                        }
+                        break;
+                    case SimulatorChannel::state:
+                        this->state_socket.send_data(payload);
+                        break;
+                    case SimulatorChannel::video:
+                        this->video_socket.send_data(payload);
+                        break;
+                }
+            }
+            catch(const std::runtime_error&)
+            {
+
+            }
+        }
+
+        void emit_datagrams()
+        {
+            auto now = std::chrono::steady_clock::now();
+            auto next_state_tick = now;
+            auto next_video_tick = now;
+
+            std::chrono::nanoseconds state_period(1000000000 / std::max(this->simulator_settings.state_rate_hz, 1));
+            std::chrono::nanoseconds video_period(1000000000 / std::max(this->simulator_settings.video_rate_fps, 1));
+
+            while (this->running.load(std::memory_order_relaxed))
+            {
+                now = std::chrono::steady_clock::now();
+
+                if (this->simulator_settings.state_rate_hz > 0 && now >= next_state_tick)
+                {
+                    this->schedule_datagram(SimulatorChannel::state, this->format_tello_state());
+                    this->sent_states.fetch_add(1, std::memory_order_relaxed);
+                    next_state_tick = std::max(next_state_tick + state_period, now - state_period);
+                }
+
+                if (this->video_streaming.load(std::memory_order_relaxed) && now >= next_video_tick)
+                {
+                    for (std::size_t fragment_offset = 0; fragment_offset < this->video_access_unit.size(); fragment_offset += TelloVideoFragmentSize)
+                    {
+                        this->schedule_datagram(SimulatorChannel::video, this->video_access_unit.substr(fragment_offset, TelloVideoFragmentSize));
+                    }
+
+                    this->sent_video_access_units.fetch_add(1, std::memory_order_relaxed);
+                    next_video_tick = std::max(next_video_tick + video_period, now - video_period);
+                }
+
+                auto wake_at = now + std::chrono::milliseconds(50);
+
+                if (this->simulator_settings.state_rate_hz > 0)
+                {
+                    wake_at = std::min(wake_at, next_state_tick);
+                }
+
+                if (this->video_streaming.load(std::memory_order_relaxed))
+                {
+                    wake_at = std::min(wake_at, next_video_tick);
+                }
+
+                std::unique_lock<std::mutex> scheduled_lock(this->scheduled_mutex);
+
+                while (!this->scheduled_datagrams.empty() && this->scheduled_datagrams.top().send_at <= std::chrono::steady_clock::now())
+                {
+                    ScheduledDatagram scheduled_datagram = this->scheduled_datagrams.top();
+                    this->scheduled_datagrams.pop();
+
+                    scheduled_lock.unlock();
+                    this->send_datagram(scheduled_datagram.channel, scheduled_datagram.payload, scheduled_datagram.reply_address);
+                    scheduled_lock.lock();
+                }
+
+                if (!this->scheduled_datagrams.empty())
+                {
+                    wake_at = std::min(wake_at, this->scheduled_datagrams.top().send_at);
+                }
+
+                this->scheduled_condition.wait_until(scheduled_lock, wake_at);
+            }
+        }
+
+        static constexpr std::size_t TelloVideoFragmentSize = 1460;
+
+        TelloSimulatorSettings simulator_settings;
+        TelloLogger tello_logger;
+        TelloSocket command_socket;
+        TelloSocket state_socket;
+        TelloSocket video_socket;
+
+        std::mutex simulated_tello_mutex;
+        SimulatedTello simulated_tello;
+        std::string video_access_unit;
+        std::atomic<bool> video_streaming{false};
+
+        std::mutex scheduled_mutex;
+        std::condition_variable scheduled_condition;
+        std::priority_queue<ScheduledDatagram, std::vector<ScheduledDatagram>, std::greater<ScheduledDatagram>> scheduled_datagrams;
+        std::uint64_t scheduled_sequence = 0;
+        std::mt19937 random_engine;
+        std::uniform_real_distribution<double> probability{0.0, 1.0};
+
+        std::atomic<bool> running{false};
+        std::thread command_thread;
+        std::thread emitter_thread;
+
+        std::atomic<std::uint64_t> received_commands{0};
+        std::atomic<std::uint64_t> sent_states{0};
+        std::atomic<std::uint64_t> sent_video_access_units{0};
+};
\ No newline at end of file
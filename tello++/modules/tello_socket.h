@@ -1,9 +1,21 @@
 #pragma once
 
 #include "internals/socket_base.h"
-#include "internals/util.h"
+#include "internals/socket_util.h"
 
 #include "tello_logger.h"
+#include "tello_packet_capture.h"
+
+#include <string_view>
+#include <utility>
+
+struct TelloDatagram 
+{
+    char *data;
+    int capacity;
+    int size;
+    sockaddr_in source_address;
+};
 
 class TelloSocket 
 {
@@ -15,122 +27,441 @@ class TelloSocket
         const std::string &tello_ip = "192.168.10.1", 
         const int &tello_port = 8889, 
         const std::string &tello_client_ip = "0.0.0.0", 
-        const int &tello_client_port = 9000
+        const int &tello_client_port = 9000,
+        const bool &reuse_port = false
         ): 
         socket_base{SocketBase::get_socket_base()},
         tello_logger{tello_logger}, 
-        simple_tello_address{tello_ip, tello_port},
-        tello_address {AF_INET, htons(tello_port), encode_ip_address(AF_INET, tello_ip)},
-        tello_client_address {AF_INET, htons(tello_client_port), encode_ip_address(AF_INET, tello_client_ip)},
-        tello_client{socket(AF_INET, SOCK_DGRAM, 0)}
+        tello_address {make_socket_address(tello_ip, tello_port)},
+        tello_client_address {make_socket_address(tello_client_ip, tello_client_port)},
+        tello_client{socket(AF_INET, SOCK_DGRAM, 0)},
+        receive_timeout_millis{tello_response_timeout_secs * 1000}
         {
-            if (this->tello_client == INVALID_SOCKET) 
+            if (this->tello_client == invalid_native_socket) 
             {
-                throw_winsock_error
+                throw_socket_error
                 (
                     format_string("Sorry, we couldn't create you an '%s' socket with the protocol '%s'.", get_variable_name(AF_INET), get_variable_name(SOCK_DGRAM))
                 );
             }
 
+            if (reuse_port) 
+            {
+                this->enable_port_reuse();
+            }
+
             int bind_result = bind(this->tello_client, (sockaddr*)&this->tello_client_address, sizeof(this->tello_client_address));
 
 
-            if(bind_result == SOCKET_ERROR) 
+            if(bind_result == native_socket_error) 
             {
-                throw_winsock_error
+                close_native_socket(this->tello_client);
+                throw_socket_error
                 (
                     format_string("Sorry, we couldn't bind your socket to '(%s, %i)'.", tello_client_ip.c_str(), tello_client_port)
                 );
             }
 
-            DWORD tello_response_timeout = (tello_response_timeout_secs * 1000);
-            int set_socket_recv_timeout_result = setsockopt(tello_client, SOL_SOCKET, SO_RCVTIMEO, (char*)&tello_response_timeout, sizeof(tello_response_timeout));
-            int set_socket_send_timeout_result = setsockopt(tello_client, SOL_SOCKET, SO_SNDTIMEO, (char*)&tello_response_timeout, sizeof(tello_response_timeout));
+            int tello_response_timeout = (tello_response_timeout_secs * 1000);
+            int set_socket_recv_timeout_result = set_socket_timeout(tello_client, SO_RCVTIMEO, tello_response_timeout);
+            int set_socket_send_timeout_result = set_socket_timeout(tello_client, SO_SNDTIMEO, tello_response_timeout);
 
 
-            if (set_socket_recv_timeout_result < 0 || set_socket_recv_timeout_result < 0) 
+            if (set_socket_recv_timeout_result < 0 || set_socket_send_timeout_result < 0) 
             {
-                throw_winsock_error
+                close_native_socket(this->tello_client);
+                throw_socket_error
                 (
                     format_string("Sorry, we couldn't set the timeout of your socket to '%i'.", tello_response_timeout_secs)
                 );
             }
         }
 
-        std::string send_command(const std::string &to_send, const int &buffer_size = 128) 
+        TelloSocket(TelloSocket const&) = delete;
+        void operator = (TelloSocket const&) = delete;
+
+        void set_receive_timeout(const int &timeout_millis) 
+        {
+            int set_socket_recv_timeout_result = set_socket_timeout(this->tello_client, SO_RCVTIMEO, timeout_millis);
+
+            if (set_socket_recv_timeout_result == native_socket_error) 
+            {
+                throw_socket_error
+                (
+                    format_string("Sorry, we couldn't set the receive timeout of your socket to '%i' milliseconds.", timeout_millis)
+                );
+            }
+
+            this->receive_timeout_millis = timeout_millis;
+        }
+
+        int get_receive_timeout() const 
+        {
+            return this->receive_timeout_millis;
+        }
+
+        void set_receive_buffer_size(const int &buffer_bytes) 
+        {
+            int set_socket_recv_buffer_result = setsockopt(this->tello_client, SOL_SOCKET, SO_RCVBUF, (char*)&buffer_bytes, sizeof(buffer_bytes));
+
+            if (set_socket_recv_buffer_result == native_socket_error) 
+            {
+                throw_socket_error
+                (
+                    format_string("Sorry, we couldn't set the receive buffer of your socket to '%i' bytes.", buffer_bytes)
+                );
+            }
+        }
+
+#if defined(__linux__)
+        void set_busy_poll(const int &busy_poll_micros) 
+        {
+            int set_socket_busy_poll_result = setsockopt(this->tello_client, SOL_SOCKET, SO_BUSY_POLL, &busy_poll_micros, sizeof(busy_poll_micros));
+
+            if (set_socket_busy_poll_result == native_socket_error) 
+            {
+                throw_socket_error
+                (
+                    format_string("Sorry, we couldn't set the busy poll time of your socket to '%i' microseconds.", busy_poll_micros)
+                );
+            }
+        }
+#endif
+
+        void set_non_blocking(const bool &non_blocking) 
+        {
+            if (set_native_socket_non_blocking(this->tello_client, non_blocking) == native_socket_error) 
+            {
+                throw_socket_error
+                (
+                    "Sorry, we couldn't change the blocking mode of your socket."
+                );
+            }
+        }
+
+        NativeSocket get_native_socket() const 
+        {
+            return this->tello_client;
+        }
+
+        const sockaddr_in &get_tello_address() const 
+        {
+            return this->tello_address;
+        }
+
+        void set_packet_capture(TelloPacketCapture *packet_capture, const TelloPacketChannel &packet_channel) 
+        {
+            this->packet_capture = packet_capture;
+            this->packet_channel = packet_channel;
+        }
+
+        std::string send_command(std::string_view to_send, const int &buffer_size = 128) 
         {
             send_data(to_send);
             return receive_data(buffer_size);
         }
 
-        void send_data(const std::string &string_data) 
+        void send_data(std::string_view string_data) 
         {
-            const char* raw_string_data = string_data.c_str();
-            int send_result = sendto(this->tello_client, raw_string_data, strlen(raw_string_data), 0, (sockaddr*)&this->tello_address, sizeof(this->tello_address));
+            this->send_data(string_data, this->tello_address);
+        }
 
-            if (send_result == SOCKET_ERROR) 
+        void send_data(std::string_view string_data, const sockaddr_in &destination_address) 
+        {
+            int string_data_size = static_cast<int>(string_data.size());
+            int send_result = sendto(this->tello_client, string_data.data(), string_data_size, 0, (sockaddr*)&destination_address, sizeof(destination_address));
+
+            if (send_result == native_socket_error) 
             {
-                throw_winsock_error
+                throw_socket_error
                 (
-                    format_string("Sorry, we couldn't send '%s' to to your Tello.", raw_string_data)
+                    format_string("Sorry, we couldn't send '%.*s' to to your Tello.", string_data_size, string_data.data())
                 );
             }
 
-            this->tello_logger.log_data
+            this->tello_logger.log_event
             (
-                format_string("Sent '%s' with the size '%i' to '(%s, %i)'", raw_string_data, string_data.size(), simple_tello_address.ip_address.c_str(), simple_tello_address.port)
+                TelloLogEvent::sent_data, string_data, string_data_size, destination_address.sin_addr.s_addr, ntohs(destination_address.sin_port)
             );
+
+            if (this->packet_capture) 
+            {
+                this->packet_capture->capture(TelloPacketChannel::sent_command, string_data);
+            }
         }
 
         std::string receive_data(const int &buffer_size = 200) 
         {
-            sockaddr_in client_address;
-            int client_byte_size = sizeof(client_address);
-            ZeroMemory(&client_address, client_byte_size);
+            return std::string(this->receive_data_view(buffer_size));
+        }
+
+        std::string_view receive_data_view(const int &buffer_size = 200) 
+        {
+            if (buffer_size > this->receive_buffer_size) 
+            {
+                this->receive_buffer = std::make_unique<char[]>(buffer_size);
+                this->receive_buffer_size = buffer_size;
+            }
 
-            std::unique_ptr<char[]> data_buffer = std::make_unique<char[]>(buffer_size);
-            ZeroMemory(data_buffer.get(), buffer_size);
+            sockaddr_in client_address;
+            SocketLength client_byte_size = sizeof(client_address);
 
-            int receive_result = recvfrom(this->tello_client, data_buffer.get(), buffer_size, 0, (sockaddr*)&client_address, &client_byte_size);
+            int receive_result = recvfrom(this->tello_client, this->receive_buffer.get(), buffer_size, 0, (sockaddr*)&client_address, &client_byte_size);
 
-            if (receive_result == SOCKET_ERROR) 
+            if (receive_result == native_socket_error) 
             {
-                throw_winsock_error
+                throw_socket_error
                 (
                     "Sorry, we couldn't receive data from your Tello."
                 );
             }
 
-            std::string decoded_client_ip = decode_ip_address(AF_INET, client_address.sin_addr, 200);
-            int decoded_client_port = ntohs(client_address.sin_port);
-
-            if (decoded_client_ip != this->simple_tello_address.ip_address) 
+            if (!this->is_from_tello(client_address)) 
             {
-                throw std::runtime_error(format_string("Unknown connection from ip '%s'", decoded_client_ip));
+                throw std::runtime_error(format_string("Unknown connection from ip '%s'", decode_ip_address(AF_INET, client_address.sin_addr, INET_ADDRSTRLEN).c_str()));
             }
 
-            std::string data_buffer_string(data_buffer.get());
+            std::string_view received_data(this->receive_buffer.get(), receive_result);
+
+            if (this->packet_capture) 
+            {
+                this->packet_capture->capture(this->packet_channel, received_data);
+            }
 
-            this->tello_logger.log_data
+            this->tello_logger.log_event
             (
-                format_string("Received '%s' with the size '%i' from '(%s, %i)'", data_buffer_string.c_str(), data_buffer_string.size(), decoded_client_ip.c_str(), decoded_client_port)
+                TelloLogEvent::received_data, received_data, receive_result, client_address.sin_addr.s_addr, ntohs(client_address.sin_port)
             );
 
-            return strip(data_buffer_string);
+            return strip(received_data);
+        }
+
+        int receive_into(char *buffer, const int &buffer_size) 
+        {
+            sockaddr_in client_address;
+            SocketLength client_byte_size = sizeof(client_address);
+
+            int receive_result = recvfrom(this->tello_client, buffer, buffer_size, 0, (sockaddr*)&client_address, &client_byte_size);
+
+            if (receive_result == native_socket_error) 
+            {
+                if (is_socket_would_block(get_last_socket_error())) 
+                {
+                    return -1;
+                }
+
+                throw_socket_error
+                (
+                    "Sorry, we couldn't receive data from your Tello."
+                );
+            }
+
+            if (!this->is_from_tello(client_address)) 
+            {
+                throw std::runtime_error(format_string("Unknown connection from ip '%s'", decode_ip_address(AF_INET, client_address.sin_addr, INET_ADDRSTRLEN).c_str()));
+            }
+
+            if (this->packet_capture) 
+            {
+                this->packet_capture->capture(this->packet_channel, std::string_view(buffer, receive_result));
+            }
+
+            return receive_result;
+        }
+
+        int receive_datagrams(TelloDatagram *datagrams, const int &datagram_count) 
+        {
+#if defined(__linux__)
+            constexpr int max_batch_size = 64;
+
+            mmsghdr messages[max_batch_size];
+            iovec message_buffers[max_batch_size];
+
+            int batch_size = datagram_count < max_batch_size ? datagram_count : max_batch_size;
+
+            for (int datagram_index = 0; datagram_index < batch_size; datagram_index++) 
+            {
+                TelloDatagram &datagram = datagrams[datagram_index];
+
+                message_buffers[datagram_index] = iovec{datagram.data, static_cast<std::size_t>(datagram.capacity)};
+
+                std::memset(&messages[datagram_index], 0, sizeof(mmsghdr));
+                messages[datagram_index].msg_hdr.msg_name = &datagram.source_address;
+                messages[datagram_index].msg_hdr.msg_namelen = sizeof(datagram.source_address);
+                messages[datagram_index].msg_hdr.msg_iov = &message_buffers[datagram_index];
+                messages[datagram_index].msg_hdr.msg_iovlen = 1;
+            }
+
+            int receive_result = recvmmsg(this->tello_client, messages, batch_size, MSG_WAITFORONE, nullptr);
+
+            if (receive_result == native_socket_error) 
+            {
+                if (is_socket_would_block(get_last_socket_error())) 
+                {
+                    return 0;
+                }
+
+                throw_socket_error
+                (
+                    "Sorry, we couldn't receive data from your Tello."
+                );
+            }
+
+            int accepted_count = 0;
+
+            for (int datagram_index = 0; datagram_index < receive_result; datagram_index++) 
+            {
+                datagrams[datagram_index].size = static_cast<int>(messages[datagram_index].msg_len);
+
+                if (!this->accept_datagram(datagrams[datagram_index])) 
+                {
+                    continue;
+                }
+
+                if (datagram_index != accepted_count) 
+                {
+                    std::swap(datagrams[accepted_count], datagrams[datagram_index]);
+                }
+
+                accepted_count++;
+            }
+
+            return accepted_count;
+#else
+            if (datagram_count <= 0) 
+            {
+                return 0;
+            }
+
+            SocketLength source_address_size = sizeof(datagrams[0].source_address);
+            int receive_result = recvfrom(this->tello_client, datagrams[0].data, datagrams[0].capacity, 0, (sockaddr*)&datagrams[0].source_address, &source_address_size);
+
+            if (receive_result == native_socket_error) 
+            {
+                if (is_socket_would_block(get_last_socket_error())) 
+                {
+                    return 0;
+                }
+
+                throw_socket_error
+                (
+                    "Sorry, we couldn't receive data from your Tello."
+                );
+            }
+
+            datagrams[0].size = receive_result;
+
+            return this->accept_datagram(datagrams[0]) ? 1 : 0;
+#endif
+        }
+
+        template<typename Datagram>
+        int send_datagrams(const Datagram *to_send, const int &datagram_count) 
+        {
+#if defined(__linux__)
+            constexpr int max_batch_size = 64;
+
+            mmsghdr messages[max_batch_size];
+            iovec message_buffers[max_batch_size];
+
+            int batch_size = datagram_count < max_batch_size ? datagram_count : max_batch_size;
+
+            for (int datagram_index = 0; datagram_index < batch_size; datagram_index++) 
+            {
+                message_buffers[datagram_index] = iovec{const_cast<char*>(to_send[datagram_index].data()), to_send[datagram_index].size()};
+
+                std::memset(&messages[datagram_index], 0, sizeof(mmsghdr));
+                messages[datagram_index].msg_hdr.msg_name = &this->tello_address;
+                messages[datagram_index].msg_hdr.msg_namelen = sizeof(this->tello_address);
+                messages[datagram_index].msg_hdr.msg_iov = &message_buffers[datagram_index];
+                messages[datagram_index].msg_hdr.msg_iovlen = 1;
+            }
+
+            int send_result = sendmmsg(this->tello_client, messages, batch_size, 0);
+
+            if (send_result == native_socket_error) 
+            {
+                throw_socket_error
+                (
+                    format_string("Sorry, we couldn't send '%i' datagrams to your Tello.", batch_size)
+                );
+            }
+
+            if (this->packet_capture) 
+            {
+                for (int datagram_index = 0; datagram_index < send_result; datagram_index++) 
+                {
+                    this->packet_capture->capture(TelloPacketChannel::sent_command, std::string_view(to_send[datagram_index].data(), to_send[datagram_index].size()));
+                }
+            }
+
+            return send_result;
+#else
+            for (int datagram_index = 0; datagram_index < datagram_count; datagram_index++) 
+            {
+                this->send_data(to_send[datagram_index]);
+            }
+
+            return datagram_count;
+#endif
+        }
+
+        ~TelloSocket() 
+        {
+            close_native_socket(this->tello_client);
         }
 
     private:
-        struct SocketAddress 
+        bool is_from_tello(const sockaddr_in &source_address) const 
+        {
+            return this->tello_address.sin_addr.s_addr == INADDR_ANY || source_address.sin_addr.s_addr == this->tello_address.sin_addr.s_addr;
+        }
+
+        bool accept_datagram(TelloDatagram &datagram) 
         {
-            std::string ip_address;
-            int port;
-        };
+            if (!this->is_from_tello(datagram.source_address)) 
+            {
+                this->tello_logger.log_data(format_string("Unknown connection from ip '%s'", decode_ip_address(AF_INET, datagram.source_address.sin_addr, INET_ADDRSTRLEN).c_str()));
+                return false;
+            }
+
+            if (this->packet_capture) 
+            {
+                this->packet_capture->capture(this->packet_channel, std::string_view(datagram.data, datagram.size));
+            }
+
+            return true;
+        }
+
+        void enable_port_reuse() 
+        {
+#if defined(SO_REUSEPORT)
+            int reuse_port = 1;
+            int set_socket_reuse_port_result = setsockopt(this->tello_client, SOL_SOCKET, SO_REUSEPORT, (char*)&reuse_port, sizeof(reuse_port));
+
+            if (set_socket_reuse_port_result == native_socket_error) 
+            {
+                close_native_socket(this->tello_client);
+                throw_socket_error
+                (
+                    "Sorry, we couldn't let your socket share its port."
+                );
+            }
+#else
+            close_native_socket(this->tello_client);
+            throw std::runtime_error("Sorry, your platform can't share a port between sockets.");
+#endif
+        }
 
         const SocketBase &socket_base;
         const TelloLogger &tello_logger;
 
-        SocketAddress simple_tello_address;
         sockaddr_in tello_address;
         sockaddr_in tello_client_address;
-        SOCKET tello_client;
+        NativeSocket tello_client;
+        std::unique_ptr<char[]> receive_buffer;
+        int receive_buffer_size = 0;
+        int receive_timeout_millis;
+        TelloPacketCapture *packet_capture = nullptr;
+        TelloPacketChannel packet_channel = TelloPacketChannel::command;
 };
\ No newline at end of file
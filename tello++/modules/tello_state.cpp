@@ -0,0 +1,115 @@
+#include "tello_state.h"
+
+template bool store_tello_state_field<FromCharsNumberParser>(TelloStateField field, const char *value_begin, const char *value_end, TelloState &tello_state, float &low_temprature, float &high_temprature);
+template bool store_tello_state_field<DecimalNumberParser>(TelloStateField field, const char *value_begin, const char *value_end, TelloState &tello_state, float &low_temprature, float &high_temprature);
+
+bool try_parse_tello_state_scalar(std::string_view tello_state_packet, TelloState &tello_state)
+{
+    const char *cursor = tello_state_packet.data();
+    const char *const packet_end = cursor + tello_state_packet.size();
+
+    std::uint32_t parsed_fields = 0;
+    float low_temprature = 0;
+    float high_temprature = 0;
+
+    while (cursor < packet_end)
+    {
+        const char *key_end = static_cast<const char*>(std::memchr(cursor, ':', packet_end - cursor));
+
+        if (key_end == nullptr)
+        {
+            break;
+        }
+
+        const char *value_begin = key_end + 1;
+        const char *value_end = static_cast<const char*>(std::memchr(value_begin, ';', packet_end - value_begin));
+
+        if (value_end == nullptr)
+        {
+            value_end = packet_end;
+        }
+
+        TelloStateField field = get_tello_state_field(std::string_view(cursor, key_end - cursor));
+
+        if (field != TelloStateField::unknown)
+        {
+            if (!store_tello_state_field(field, value_begin, value_end, tello_state, low_temprature, high_temprature))
+            {
+                return false;
+            }
+
+            parsed_fields |= 1u << static_cast<std::uint32_t>(field);
+        }
+
+        cursor = value_end + 1;
+    }
+
+    tello_state.average_temprature = (low_temprature + high_temprature) / 2;
+
+    return parsed_fields == all_tello_state_fields;
+}
+
+bool try_parse_tello_state_vectorized(std::string_view tello_state_packet, TelloState &tello_state, DelimiterScanner delimiter_scanner)
+{
+    if (tello_state_packet.size() > max_vectorized_tello_state_size)
+    {
+        return try_parse_tello_state_scalar(tello_state_packet, tello_state);
+    }
+
+    const char *packet = tello_state_packet.data();
+
+    std::uint16_t delimiter_positions[max_vectorized_tello_state_size];
+    std::size_t delimiter_count = delimiter_scanner(packet, tello_state_packet.size(), delimiter_positions);
+
+    std::uint32_t parsed_fields = 0;
+    float low_temprature = 0;
+    float high_temprature = 0;
+
+    std::size_t key_begin = 0;
+
+    for (std::size_t delimiter_index = 0; delimiter_index < delimiter_count; delimiter_index += 2)
+    {
+        std::size_t key_end = delimiter_positions[delimiter_index];
+        std::size_t value_end = delimiter_index + 1 < delimiter_count ? delimiter_positions[delimiter_index + 1] : tello_state_packet.size();
+
+        if (packet[key_end] != ':' || (value_end < tello_state_packet.size() && packet[value_end] != ';'))
+        {
+            return try_parse_tello_state_scalar(tello_state_packet, tello_state);
+        }
+
+        TelloStateField field = get_tello_state_field(std::string_view(packet + key_begin, key_end - key_begin));
+
+        if (field != TelloStateField::unknown)
+        {
+            if (!store_tello_state_field<DecimalNumberParser>(field, packet + key_end + 1, packet + value_end, tello_state, low_temprature, high_temprature))
+            {
+                return false;
+            }
+
+            parsed_fields |= 1u << static_cast<std::uint32_t>(field);
+        }
+
+        key_begin = value_end + 1;
+    }
+
+    tello_state.average_temprature = (low_temprature + high_temprature) / 2;
+
+    return parsed_fields == all_tello_state_fields;
+}
+
+bool try_parse_tello_state(std::string_view tello_state_packet, TelloState &tello_state)
+{
+    return try_parse_tello_state_vectorized(tello_state_packet, tello_state, get_delimiter_scanner());
+}
+
+TelloState parse_tello_state(std::string_view tello_state_packet)
+{
+    TelloState tello_state{};
+
+    if (!try_parse_tello_state(tello_state_packet, tello_state))
+    {
+        throw std::runtime_error("Sorry, we couldn't parse the state your Tello sent.");
+    }
+
+    return tello_state;
+}
\ No newline at end of file
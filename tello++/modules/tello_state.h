@@ -0,0 +1,229 @@
+#pragma once
+
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+
+#include "internals/delimiter_scanner.h"
+
+struct IMUAttitude
+{
+    int pitch;
+    int roll;
+    int yaw;
+};
+
+struct IMUAcceleration
+{
+    float x_acceleration;
+    float y_acceleration;
+    float z_acceleration;
+};
+
+struct IMUVelocity
+{
+    int x_velocity;
+    int y_velocity;
+    int z_velocity;
+};
+
+struct TelloState
+{
+    IMUAttitude imu_attitude;
+    IMUVelocity imu_velocity;
+    float average_temprature;
+    int distance_from_takeoff;
+    int height;
+    int battery;
+    float barometer_reading;
+    int flight_time;
+    IMUAcceleration imu_acceleration;
+};
+
+enum class TelloStateField : std::uint8_t
+{
+    pitch,
+    roll,
+    yaw,
+    vgx,
+    vgy,
+    vgz,
+    templ,
+    temph,
+    tof,
+    h,
+    bat,
+    baro,
+    time,
+    agx,
+    agy,
+    agz,
+    unknown
+};
+
+constexpr std::uint32_t all_tello_state_fields = (1u << static_cast<std::uint32_t>(TelloStateField::unknown)) - 1;
+
+constexpr TelloStateField get_tello_state_field(std::string_view key)
+{
+    switch (key.size())
+    {
+        case 1:
+            return key == "h" ? TelloStateField::h : TelloStateField::unknown;
+        case 3:
+            if (key == "yaw") return TelloStateField::yaw;
+            if (key == "vgx") return TelloStateField::vgx;
+            if (key == "vgy") return TelloStateField::vgy;
+            if (key == "vgz") return TelloStateField::vgz;
+            if (key == "tof") return TelloStateField::tof;
+            if (key == "bat") return TelloStateField::bat;
+            if (key == "agx") return TelloStateField::agx;
+            if (key == "agy") return TelloStateField::agy;
+            if (key == "agz") return TelloStateField::agz;
+            return TelloStateField::unknown;
+        case 4:
+            if (key == "roll") return TelloStateField::roll;
+            if (key == "baro") return TelloStateField::baro;
+            if (key == "time") return TelloStateField::time;
+            return TelloStateField::unknown;
+        case 5:
+            if (key == "pitch") return TelloStateField::pitch;
+            if (key == "templ") return TelloStateField::templ;
+            if (key == "temph") return TelloStateField::temph;
+            return TelloStateField::unknown;
+        default:
+            return TelloStateField::unknown;
+    }
+}
+
+template<typename Number>
+inline bool parse_tello_state_number(const char *value_begin, const char *value_end, Number &number)
+{
+    return std::from_chars(value_begin, value_end, number).ec == std::errc{};
+}
+
+inline bool convert_tello_state_number(const char *value_begin, const char *value_end, int &number)
+{
+    const char *cursor = value_begin;
+    bool negative = cursor < value_end && *cursor == '-';
+    cursor += negative;
+
+    const char *digits_end = cursor + 9 < value_end ? cursor + 9 : value_end;
+    const char *digits_begin = cursor;
+    int value = 0;
+
+    while (cursor < digits_end && static_cast<unsigned char>(*cursor - '0') < 10)
+    {
+        value = value * 10 + (*cursor - '0');
+        cursor++;
+    }
+
+    if (cursor == digits_begin || (cursor < value_end && static_cast<unsigned char>(*cursor - '0') < 10))
+    {
+        return parse_tello_state_number(value_begin, value_end, number);
+    }
+
+    number = negative ? -value : value;
+    return true;
+}
+
+inline bool convert_tello_state_number(const char *value_begin, const char *value_end, float &number)
+{
+    static constexpr double powers_of_ten[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18};
+
+    const char *cursor = value_begin;
+    bool negative = cursor < value_end && *cursor == '-';
+    cursor += negative;
+
+    std::int64_t mantissa = 0;
+    int digit_count = 0;
+    int fraction_digit_count = 0;
+
+    while (cursor < value_end && static_cast<unsigned char>(*cursor - '0') < 10 && digit_count < 18)
+    {
+        mantissa = mantissa * 10 + (*cursor - '0');
+        digit_count++;
+        cursor++;
+    }
+
+    if (cursor < value_end && *cursor == '.')
+    {
+        cursor++;
+
+        while (cursor < value_end && static_cast<unsigned char>(*cursor - '0') < 10 && digit_count < 18)
+        {
+            mantissa = mantissa * 10 + (*cursor - '0');
+            digit_count++;
+            fraction_digit_count++;
+            cursor++;
+        }
+    }
+
+    if (digit_count == 0 || (cursor < value_end && (static_cast<unsigned char>(*cursor - '0') < 10 || *cursor == '.' || *cursor == 'e' || *cursor == 'E')))
+    {
+        return parse_tello_state_number(value_begin, value_end, number);
+    }
+
+    double value = static_cast<double>(mantissa) / powers_of_ten[fraction_digit_count];
+    number = static_cast<float>(negative ? -value : value);
+    return true;
+}
+
+struct FromCharsNumberParser
+{
+    template<typename Number>
+    bool operator () (const char *value_begin, const char *value_end, Number &number) const
+    {
+        return parse_tello_state_number(value_begin, value_end, number);
+    }
+};
+
+struct DecimalNumberParser
+{
+    template<typename Number>
+    bool operator () (const char *value_begin, const char *value_end, Number &number) const
+    {
+        return convert_tello_state_number(value_begin, value_end, number);
+    }
+};
+
+template<typename NumberParser = FromCharsNumberParser>
+bool store_tello_state_field(TelloStateField field, const char *value_begin, const char *value_end, TelloState &tello_state, float &low_temprature, float &high_temprature)
+{
+    NumberParser parse_number;
+
+    switch (field)
+    {
+        case TelloStateField::pitch: return parse_number(value_begin, value_end, tello_state.imu_attitude.pitch);
+        case TelloStateField::roll: return parse_number(value_begin, value_end, tello_state.imu_attitude.roll);
+        case TelloStateField::yaw: return parse_number(value_begin, value_end, tello_state.imu_attitude.yaw);
+        case TelloStateField::vgx: return parse_number(value_begin, value_end, tello_state.imu_velocity.x_velocity);
+        case TelloStateField::vgy: return parse_number(value_begin, value_end, tello_state.imu_velocity.y_velocity);
+        case TelloStateField::vgz: return parse_number(value_begin, value_end, tello_state.imu_velocity.z_velocity);
+        case TelloStateField::templ: return parse_number(value_begin, value_end, low_temprature);
+        case TelloStateField::temph: return parse_number(value_begin, value_end, high_temprature);
+        case TelloStateField::tof: return parse_number(value_begin, value_end, tello_state.distance_from_takeoff);
+        case TelloStateField::h: return parse_number(value_begin, value_end, tello_state.height);
+        case TelloStateField::bat: return parse_number(value_begin, value_end, tello_state.battery);
+        case TelloStateField::baro: return parse_number(value_begin, value_end, tello_state.barometer_reading);
+        case TelloStateField::time: return parse_number(value_begin, value_end, tello_state.flight_time);
+        case TelloStateField::agx: return parse_number(value_begin, value_end, tello_state.imu_acceleration.x_acceleration);
+        case TelloStateField::agy: return parse_number(value_begin, value_end, tello_state.imu_acceleration.y_acceleration);
+        case TelloStateField::agz: return parse_number(value_begin, value_end, tello_state.imu_acceleration.z_acceleration);
+        default: return true;
+    }
+}
+
+extern template bool store_tello_state_field<FromCharsNumberParser>(TelloStateField field, const char *value_begin, const char *value_end, TelloState &tello_state, float &low_temprature, float &high_temprature);
+extern template bool store_tello_state_field<DecimalNumberParser>(TelloStateField field, const char *value_begin, const char *value_end, TelloState &tello_state, float &low_temprature, float &high_temprature);
+
+bool try_parse_tello_state_scalar(std::string_view tello_state_packet, TelloState &tello_state);
+
+constexpr std::size_t max_vectorized_tello_state_size = 512;
+
+bool try_parse_tello_state_vectorized(std::string_view tello_state_packet, TelloState &tello_state, DelimiterScanner delimiter_scanner);
+
+bool try_parse_tello_state(std::string_view tello_state_packet, TelloState &tello_state);
+
+TelloState parse_tello_state(std::string_view tello_state_packet);
\ No newline at end of file
@@ -0,0 +1,226 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "tello_socket.h"
+#include "tello_state.h"
+
+class TelloStateBatch
+{
+    public:
+        TelloStateBatch(const std::size_t &batch_capacity = 64) :
+        pitch(batch_capacity),
+        roll(batch_capacity),
+        yaw(batch_capacity),
+        x_velocity(batch_capacity),
+        y_velocity(batch_capacity),
+        z_velocity(batch_capacity),
+        average_temprature(batch_capacity),
+        distance_from_takeoff(batch_capacity),
+        height(batch_capacity),
+        battery(batch_capacity),
+        barometer_reading(batch_capacity),
+        flight_time(batch_capacity),
+        x_acceleration(batch_capacity),
+        y_acceleration(batch_capacity),
+        z_acceleration(batch_capacity),
+        source_ip_addresses(batch_capacity),
+        received_at_nanos(batch_capacity),
+        batch_capacity{batch_capacity}
+        {
+            if (batch_capacity == 0)
+            {
+                throw std::invalid_argument("Sorry, your Tello state batch has to hold at least one Tello state.");
+            }
+        }
+
+        bool push_back(const TelloState &tello_state, const std::uint32_t &source_ip_address = 0, const std::int64_t &received_nanos = 0)
+        {
+            if (this->is_full())
+            {
+                return false;
+            }
+
+            std::size_t index = this->batch_size++;
+
+            this->pitch[index] = tello_state.imu_attitude.pitch;
+            this->roll[index] = tello_state.imu_attitude.roll;
+            this->yaw[index] = tello_state.imu_attitude.yaw;
+            this->x_velocity[index] = tello_state.imu_velocity.x_velocity;
+            this->y_velocity[index] = tello_state.imu_velocity.y_velocity;
+            this->z_velocity[index] = tello_state.imu_velocity.z_velocity;
+            this->average_temprature[index] = tello_state.average_temprature;
+            this->distance_from_takeoff[index] = tello_state.distance_from_takeoff;
+            this->height[index] = tello_state.height;
+            this->battery[index] = tello_state.battery;
+            this->barometer_reading[index] = tello_state.barometer_reading;
+            this->flight_time[index] = tello_state.flight_time;
+            this->x_acceleration[index] = tello_state.imu_acceleration.x_acceleration;
+            this->y_acceleration[index] = tello_state.imu_acceleration.y_acceleration;
+            this->z_acceleration[index] = tello_state.imu_acceleration.z_acceleration;
+            this->source_ip_addresses[index] = source_ip_address;
+            this->received_at_nanos[index] = received_nanos;
+
+            return true;
+        }
+
+        TelloState get_tello_state(const std::size_t &index) const
+        {
+            if (index >= this->batch_size)
+            {
+                throw std::out_of_range("Sorry, that Tello state isn't in this batch.");
+            }
+
+            return TelloState
+            {
+                {this->pitch[index], this->roll[index], this->yaw[index]},
+                {this->x_velocity[index], this->y_velocity[index], this->z_velocity[index]},
+                this->average_temprature[index],
+                this->distance_from_takeoff[index],
+                this->height[index],
+                this->battery[index],
+                this->barometer_reading[index],
+                this->flight_time[index],
+                {this->x_acceleration[index], this->y_acceleration[index], this->z_acceleration[index]}
+            };
+        }
+
+        void clear()
+        {
+            this->batch_size = 0;
+        }
+
+        std::size_t size() const
+        {
+            return this->batch_size;
+        }
+
+        std::size_t capacity() const
+        {
+            return this->batch_capacity;
+        }
+
+        bool is_full() const
+        {
+            return this->batch_size == this->batch_capacity;
+        }
+
+        std::vector<int> pitch;
+        std::vector<int> roll;
+        std::vector<int> yaw;
+        std::vector<int> x_velocity;
+        std::vector<int> y_velocity;
+        std::vector<int> z_velocity;
+        std::vector<float> average_temprature;
+        std::vector<int> distance_from_takeoff;
+        std::vector<int> height;
+        std::vector<int> battery;
+        std::vector<float> barometer_reading;
+        std::vector<int> flight_time;
+        std::vector<float> x_acceleration;
+        std::vector<float> y_acceleration;
+        std::vector<float> z_acceleration;
+        std::vector<std::uint32_t> source_ip_addresses;
+        std::vector<std::int64_t> received_at_nanos;
+
+    private:
+        std::size_t batch_capacity;
+        std::size_t batch_size = 0;
+};
+
+class TelloStateBatchReceiver
+{
+    public:
+        static constexpr int max_tello_state_size = 256;
+
+        TelloStateBatchReceiver(TelloSocket &tello_state_receiver, const int &max_datagrams_per_receive = 64) :
+        tello_state_receiver{tello_state_receiver},
+        max_datagrams_per_receive{validate_max_datagrams_per_receive(max_datagrams_per_receive)},
+        datagram_buffers{std::make_unique<char[]>(static_cast<std::size_t>(this->max_datagrams_per_receive) * datagram_buffer_size)},
+        datagrams(static_cast<std::size_t>(this->max_datagrams_per_receive))
+        {
+            for (int datagram_index = 0; datagram_index < this->max_datagrams_per_receive; datagram_index++)
+            {
+                this->datagrams[datagram_index].data = this->datagram_buffers.get() + (static_cast<std::size_t>(datagram_index) * datagram_buffer_size);
+                this->datagrams[datagram_index].capacity = datagram_buffer_size;
+            }
+        }
+
+        TelloStateBatchReceiver(TelloStateBatchReceiver const&) = delete;
+        void operator = (TelloStateBatchReceiver const&) = delete;
+
+        std::size_t receive_tello_states(TelloStateBatch &tello_state_batch)
+        {
+            std::size_t free_space = tello_state_batch.capacity() - tello_state_batch.size();
+            int datagram_count = static_cast<int>(free_space < static_cast<std::size_t>(this->max_datagrams_per_receive) ? free_space : this->max_datagrams_per_receive);
+
+            if (datagram_count == 0)
+            {
+                return 0;
+            }
+
+            int received_count = this->tello_state_receiver.receive_datagrams(this->datagrams.data(), datagram_count);
+
+            std::int64_t received_nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+            std::size_t batch_size_before = tello_state_batch.size();
+
+            TelloState tello_state{};
+
+            for (int datagram_index = 0; datagram_index < received_count; datagram_index++)
+            {
+                const TelloDatagram &datagram = this->datagrams[datagram_index];
+
+                if (datagram.size > max_tello_state_size)
+                {
+                    this->truncated_tello_states++;
+                    continue;
+                }
+
+                if (!try_parse_tello_state(std::string_view(datagram.data, datagram.size), tello_state))
+                {
+                    this->malformed_tello_states++;
+                    continue;
+                }
+
+                tello_state_batch.push_back(tello_state, datagram.source_address.sin_addr.s_addr, received_nanos);
+            }
+
+            return tello_state_batch.size() - batch_size_before;
+        }
+
+        std::uint64_t get_malformed_tello_state_count() const
+        {
+            return this->malformed_tello_states;
+        }
+
+        std::uint64_t get_truncated_tello_state_count() const
+        {
+            return this->truncated_tello_states;
+        }
+
+    private:
+        static constexpr int datagram_buffer_size = max_tello_state_size + 1;
+
+        static int validate_max_datagrams_per_receive(const int &max_datagrams_per_receive)
+        {
+            if (max_datagrams_per_receive <= 0)
+            {
+                throw std::invalid_argument("Sorry, you have to receive at least one Tello state at a time.");
+            }
+
+            return max_datagrams_per_receive;
+        }
+
+        TelloSocket &tello_state_receiver;
+        int max_datagrams_per_receive;
+
+        std::unique_ptr<char[]> datagram_buffers;
+        std::vector<TelloDatagram> datagrams;
+        std::uint64_t malformed_tello_states = 0;
+        std::uint64_t truncated_tello_states = 0;
+};
\ No newline at end of file
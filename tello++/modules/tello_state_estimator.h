@@ -0,0 +1,577 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "tello_state.h"
+
+struct TelloStateEstimatorSettings
+{
+    float acceleration_noise_cm_per_sec_squared = 50;
+    float velocity_noise_cm_per_sec = 5;
+    float height_noise_cm = 5;
+    float velocity_unit_cm_per_sec = 10;
+    bool velocities_in_heading_frame = true;
+    std::chrono::milliseconds max_extrapolation{200};
+    std::chrono::milliseconds max_sample_gap{1000};
+
+    void validate() const
+    {
+        if (!(this->acceleration_noise_cm_per_sec_squared > 0) || !(this->velocity_noise_cm_per_sec > 0) || !(this->height_noise_cm > 0))
+        {
+            throw std::invalid_argument("Sorry, your state estimator's noise settings have to be above zero.");
+        }
+    }
+};
+
+struct TelloPose
+{
+    std::chrono::steady_clock::time_point timestamp;
+    std::array<float, 3> position_cm;
+    std::array<float, 3> velocity_cm_per_sec;
+    std::array<float, 3> acceleration_cm_per_sec_squared;
+    std::array<float, 3> attitude_degrees;
+    std::array<float, 3> attitude_rate_degrees_per_sec;
+
+    float get_height_cm() const
+    {
+        return -this->position_cm[2];
+    }
+};
+
+struct TelloStateMeasurement
+{
+    std::array<float, 3> acceleration_cm_per_sec_squared;
+    std::array<float, 3> velocity_cm_per_sec;
+    std::array<float, 3> attitude_degrees;
+    float down_position_cm;
+};
+
+struct TelloAngleTrigonometry
+{
+    float sine;
+    float cosine;
+};
+
+inline float wrap_degrees(const float &degrees)
+{
+    float wrapped_degrees = degrees > 180 ? degrees - 360 : degrees;
+    return wrapped_degrees < -180 ? wrapped_degrees + 360 : wrapped_degrees;
+}
+
+inline TelloAngleTrigonometry get_angle_trigonometry(const int &degrees)
+{
+    static const std::array<TelloAngleTrigonometry, 360> angle_trigonometry = []
+    {
+        std::array<TelloAngleTrigonometry, 360> angle_trigonometry;
+
+        for (int angle = 0; angle < 360; angle++)
+        {
+            double radians = angle * 3.14159265358979323846 / 180;
+            angle_trigonometry[angle] = TelloAngleTrigonometry{static_cast<float>(std::sin(radians)), static_cast<float>(std::cos(radians))};
+        }
+
+        return angle_trigonometry;
+    }();
+
+    int wrapped_degrees = degrees % 360;
+    return angle_trigonometry[wrapped_degrees < 0 ? wrapped_degrees + 360 : wrapped_degrees];
+}
+
+inline TelloStateMeasurement measure_tello_state(const TelloState &tello_state, const TelloStateEstimatorSettings &estimator_settings)
+{
+    constexpr float milli_g_to_cm_per_sec_squared = 0.980665f;
+    constexpr float gravity_cm_per_sec_squared = 980.665f;
+
+    auto [sin_pitch, cos_pitch] = get_angle_trigonometry(tello_state.imu_attitude.pitch);
+    auto [sin_roll, cos_roll] = get_angle_trigonometry(tello_state.imu_attitude.roll);
+    auto [sin_yaw, cos_yaw] = get_angle_trigonometry(tello_state.imu_attitude.yaw);
+
+    float forward_force = tello_state.imu_acceleration.x_acceleration * milli_g_to_cm_per_sec_squared;
+    float right_force = tello_state.imu_acceleration.y_acceleration * milli_g_to_cm_per_sec_squared;
+    float down_force = tello_state.imu_acceleration.z_acceleration * milli_g_to_cm_per_sec_squared;
+
+    TelloStateMeasurement measurement;
+
+    measurement.acceleration_cm_per_sec_squared[0] = cos_pitch * cos_yaw * forward_force + (sin_roll * sin_pitch * cos_yaw - cos_roll * sin_yaw) * right_force + (cos_roll * sin_pitch * cos_yaw + sin_roll * sin_yaw) * down_force;
+    measurement.acceleration_cm_per_sec_squared[1] = cos_pitch * sin_yaw * forward_force + (sin_roll * sin_pitch * sin_yaw + cos_roll * cos_yaw) * right_force + (cos_roll * sin_pitch * sin_yaw - sin_roll * cos_yaw) * down_force;
+    measurement.acceleration_cm_per_sec_squared[2] = -sin_pitch * forward_force + sin_roll * cos_pitch * right_force + cos_roll * cos_pitch * down_force + gravity_cm_per_sec_squared;
+
+    float forward_velocity = tello_state.imu_velocity.x_velocity * estimator_settings.velocity_unit_cm_per_sec;
+    float right_velocity = tello_state.imu_velocity.y_velocity * estimator_settings.velocity_unit_cm_per_sec;
+
+    if (estimator_settings.velocities_in_heading_frame)
+    {
+        measurement.velocity_cm_per_sec[0] = cos_yaw * forward_velocity - sin_yaw * right_velocity;
+        measurement.velocity_cm_per_sec[1] = sin_yaw * forward_velocity + cos_yaw * right_velocity;
+    }
+    else
+    {
+        measurement.velocity_cm_per_sec[0] = forward_velocity;
+        measurement.velocity_cm_per_sec[1] = right_velocity;
+    }
+
+    measurement.velocity_cm_per_sec[2] = tello_state.imu_velocity.z_velocity * estimator_settings.velocity_unit_cm_per_sec;
+
+    measurement.attitude_degrees = {static_cast<float>(tello_state.imu_attitude.pitch), static_cast<float>(tello_state.imu_attitude.roll), static_cast<float>(tello_state.imu_attitude.yaw)};
+    measurement.down_position_cm = -static_cast<float>(tello_state.height);
+
+    return measurement;
+}
+
+inline void predict_tello_axis(float &position, float &velocity, float &covariance_pp, float &covariance_pv, float &covariance_vv, const float &acceleration, const float &elapsed_secs, const float &acceleration_variance)
+{
+    float elapsed_squared = elapsed_secs * elapsed_secs;
+
+    position += velocity * elapsed_secs + 0.5f * acceleration * elapsed_squared;
+    velocity += acceleration * elapsed_secs;
+
+    covariance_pp += 2 * elapsed_secs * covariance_pv + elapsed_squared * covariance_vv + 0.25f * elapsed_squared * elapsed_squared * acceleration_variance;
+    covariance_pv += elapsed_secs * covariance_vv + 0.5f * elapsed_squared * elapsed_secs * acceleration_variance;
+    covariance_vv += elapsed_squared * acceleration_variance;
+}
+
+inline void correct_tello_axis_velocity(float &position, float &velocity, float &covariance_pp, float &covariance_pv, float &covariance_vv, const float &measured_velocity, const float &velocity_variance, const float &measurement_weight)
+{
+    float innovation_variance = covariance_vv + velocity_variance;
+    float position_gain = measurement_weight * covariance_pv / innovation_variance;
+    float velocity_gain = measurement_weight * covariance_vv / innovation_variance;
+    float innovation = measured_velocity - velocity;
+
+    position += position_gain * innovation;
+    velocity += velocity_gain * innovation;
+
+    covariance_pp -= position_gain * covariance_pv;
+    covariance_pv -= position_gain * covariance_vv;
+    covariance_vv -= velocity_gain * covariance_vv;
+}
+
+inline void correct_tello_axis_position(float &position, float &velocity, float &covariance_pp, float &covariance_pv, float &covariance_vv, const float &measured_position, const float &position_variance, const float &measurement_weight)
+{
+    float innovation_variance = covariance_pp + position_variance;
+    float position_gain = measurement_weight * covariance_pp / innovation_variance;
+    float velocity_gain = measurement_weight * covariance_pv / innovation_variance;
+    float innovation = measured_position - position;
+
+    position += position_gain * innovation;
+    velocity += velocity_gain * innovation;
+
+    covariance_vv -= velocity_gain * covariance_pv;
+    covariance_pv -= position_gain * covariance_pv;
+    covariance_pp -= position_gain * covariance_pp;
+}
+
+inline TelloPose predict_tello_pose(const TelloPose &previous_pose, const TelloPose &latest_pose, const std::chrono::steady_clock::time_point &at, const std::chrono::milliseconds &max_extrapolation)
+{
+    TelloPose tello_pose = latest_pose;
+    tello_pose.timestamp = at;
+
+    if (at >= latest_pose.timestamp || previous_pose.timestamp >= latest_pose.timestamp)
+    {
+        float elapsed_secs = std::chrono::duration<float>(std::clamp<std::chrono::steady_clock::duration>(at - latest_pose.timestamp, std::chrono::steady_clock::duration::zero(), max_extrapolation)).count();
+
+        for (std::size_t axis = 0; axis < 3; axis++)
+        {
+            tello_pose.position_cm[axis] += latest_pose.velocity_cm_per_sec[axis] * elapsed_secs + 0.5f * latest_pose.acceleration_cm_per_sec_squared[axis] * elapsed_secs * elapsed_secs;
+            tello_pose.velocity_cm_per_sec[axis] += latest_pose.acceleration_cm_per_sec_squared[axis] * elapsed_secs;
+            tello_pose.attitude_degrees[axis] = wrap_degrees(latest_pose.attitude_degrees[axis] + latest_pose.attitude_rate_degrees_per_sec[axis] * elapsed_secs);
+        }
+
+        return tello_pose;
+    }
+
+    if (at <= previous_pose.timestamp)
+    {
+        tello_pose = previous_pose;
+        tello_pose.timestamp = at;
+        return tello_pose;
+    }
+
+    float span_secs = std::chrono::duration<float>(latest_pose.timestamp - previous_pose.timestamp).count();
+    float fraction = std::chrono::duration<float>(at - previous_pose.timestamp).count() / span_secs;
+    float fraction_squared = fraction * fraction;
+    float fraction_cubed = fraction_squared * fraction;
+
+    float previous_position_weight = 2 * fraction_cubed - 3 * fraction_squared + 1;
+    float previous_velocity_weight = (fraction_cubed - 2 * fraction_squared + fraction) * span_secs;
+    float latest_position_weight = 3 * fraction_squared - 2 * fraction_cubed;
+    float latest_velocity_weight = (fraction_cubed - fraction_squared) * span_secs;
+
+    for (std::size_t axis = 0; axis < 3; axis++)
+    {
+        tello_pose.position_cm[axis] = previous_position_weight * previous_pose.position_cm[axis] + previous_velocity_weight * previous_pose.velocity_cm_per_sec[axis] + latest_position_weight * latest_pose.position_cm[axis] + latest_velocity_weight * latest_pose.velocity_cm_per_sec[axis];
+        tello_pose.velocity_cm_per_sec[axis] = previous_pose.velocity_cm_per_sec[axis] + fraction * (latest_pose.velocity_cm_per_sec[axis] - previous_pose.velocity_cm_per_sec[axis]);
+        tello_pose.acceleration_cm_per_sec_squared[axis] = previous_pose.acceleration_cm_per_sec_squared[axis] + fraction * (latest_pose.acceleration_cm_per_sec_squared[axis] - previous_pose.acceleration_cm_per_sec_squared[axis]);
+        tello_pose.attitude_degrees[axis] = wrap_degrees(previous_pose.attitude_degrees[axis] + fraction * wrap_degrees(latest_pose.attitude_degrees[axis] - previous_pose.attitude_degrees[axis]));
+    }
+
+    return tello_pose;
+}
+
+class TelloStateEstimator
+{
+    public:
+        static constexpr std::size_t axis_count = 3;
+
+        TelloStateEstimator(const TelloStateEstimatorSettings &estimator_settings = TelloStateEstimatorSettings{}) :
+        estimator_settings{estimator_settings}
+        {
+            this->estimator_settings.validate();
+        }
+
+        void update(const TelloState &tello_state, const std::chrono::steady_clock::time_point &received_at)
+        {
+            TelloStateMeasurement measurement = measure_tello_state(tello_state, this->estimator_settings);
+            std::chrono::steady_clock::duration elapsed = received_at - this->latest_pose.timestamp;
+
+            if (this->sample_count > 0 && elapsed <= std::chrono::steady_clock::duration::zero())
+            {
+                return;
+            }
+
+            this->previous_pose = this->latest_pose;
+
+            if (this->sample_count == 0 || elapsed > this->estimator_settings.max_sample_gap)
+            {
+                this->restart(measurement);
+                this->previous_pose = this->latest_pose = this->make_pose(received_at, measurement, measurement, 0);
+                this->sample_count++;
+                return;
+            }
+
+            float elapsed_secs = std::chrono::duration<float>(elapsed).count();
+            float acceleration_variance = this->estimator_settings.acceleration_noise_cm_per_sec_squared * this->estimator_settings.acceleration_noise_cm_per_sec_squared;
+            float velocity_variance = this->estimator_settings.velocity_noise_cm_per_sec * this->estimator_settings.velocity_noise_cm_per_sec;
+            float height_variance = this->estimator_settings.height_noise_cm * this->estimator_settings.height_noise_cm;
+
+            for (std::size_t axis = 0; axis < axis_count; axis++)
+            {
+                float acceleration = 0.5f * (this->latest_pose.acceleration_cm_per_sec_squared[axis] + measurement.acceleration_cm_per_sec_squared[axis]);
+
+                predict_tello_axis(this->position[axis], this->velocity[axis], this->covariance_pp[axis], this->covariance_pv[axis], this->covariance_vv[axis], acceleration, elapsed_secs, acceleration_variance);
+                correct_tello_axis_velocity(this->position[axis], this->velocity[axis], this->covariance_pp[axis], this->covariance_pv[axis], this->covariance_vv[axis], measurement.velocity_cm_per_sec[axis], velocity_variance, 1);
+            }
+
+            correct_tello_axis_position(this->position[2], this->velocity[2], this->covariance_pp[2], this->covariance_pv[2], this->covariance_vv[2], measurement.down_position_cm, height_variance, 1);
+
+            TelloStateMeasurement previous_measurement{this->latest_pose.acceleration_cm_per_sec_squared, this->latest_pose.velocity_cm_per_sec, this->latest_pose.attitude_degrees, 0};
+            this->latest_pose = this->make_pose(received_at, measurement, previous_measurement, elapsed_secs);
+            this->sample_count++;
+        }
+
+        bool has_estimate() const
+        {
+            return this->sample_count > 0;
+        }
+
+        std::uint64_t get_sample_count() const
+        {
+            return this->sample_count;
+        }
+
+        const TelloPose &get_latest_pose() const
+        {
+            return this->latest_pose;
+        }
+
+        TelloPose get_pose(const std::chrono::steady_clock::time_point &at) const
+        {
+            if (!this->has_estimate())
+            {
+                throw std::runtime_error("Sorry, we haven't estimated your Tello's pose yet.");
+            }
+
+            return predict_tello_pose(this->previous_pose, this->latest_pose, at, this->estimator_settings.max_extrapolation);
+        }
+
+        const TelloStateEstimatorSettings &get_settings() const
+        {
+            return this->estimator_settings;
+        }
+
+        void reset()
+        {
+            *this = TelloStateEstimator(this->estimator_settings);
+        }
+
+    private:
+        void restart(const TelloStateMeasurement &measurement)
+        {
+            float velocity_variance = this->estimator_settings.velocity_noise_cm_per_sec * this->estimator_settings.velocity_noise_cm_per_sec;
+
+            for (std::size_t axis = 0; axis < axis_count; axis++)
+            {
+                this->velocity[axis] = measurement.velocity_cm_per_sec[axis];
+                this->covariance_pp[axis] = 0;
+                this->covariance_pv[axis] = 0;
+                this->covariance_vv[axis] = velocity_variance;
+            }
+
+            this->position[2] = measurement.down_position_cm;
+            this->covariance_pp[2] = this->estimator_settings.height_noise_cm * this->estimator_settings.height_noise_cm;
+        }
+
+        TelloPose make_pose(const std::chrono::steady_clock::time_point &timestamp, const TelloStateMeasurement &measurement, const TelloStateMeasurement &previous_measurement, const float &elapsed_secs) const
+        {
+            TelloPose tello_pose{timestamp, this->position, this->velocity, measurement.acceleration_cm_per_sec_squared, measurement.attitude_degrees, {}};
+
+            for (std::size_t axis = 0; axis < axis_count && elapsed_secs > 0; axis++)
+            {
+                tello_pose.attitude_rate_degrees_per_sec[axis] = wrap_degrees(measurement.attitude_degrees[axis] - previous_measurement.attitude_degrees[axis]) / elapsed_secs;
+            }
+
+            return tello_pose;
+        }
+
+        TelloStateEstimatorSettings estimator_settings;
+
+        std::array<float, axis_count> position{};
+        std::array<float, axis_count> velocity{};
+        std::array<float, axis_count> covariance_pp{};
+        std::array<float, axis_count> covariance_pv{};
+        std::array<float, axis_count> covariance_vv{};
+
+        TelloPose previous_pose{};
+        TelloPose latest_pose{};
+        std::uint64_t sample_count = 0;
+};
+
+class TelloStateEstimatorBatch
+{
+    public:
+        static constexpr std::size_t axis_count = TelloStateEstimator::axis_count;
+        static constexpr std::size_t lane_count = 8;
+
+        TelloStateEstimatorBatch(const std::size_t &tello_count, const TelloStateEstimatorSettings &estimator_settings = TelloStateEstimatorSettings{}) :
+        estimator_settings{estimator_settings},
+        tello_count{tello_count},
+        padded_tello_count{(tello_count + lane_count - 1) / lane_count * lane_count},
+        measured_heights(padded_tello_count),
+        elapsed_secs(padded_tello_count),
+        measurement_weights(padded_tello_count),
+        restarting_tellos(tello_count),
+        previous_poses(tello_count),
+        latest_poses(tello_count),
+        sample_counts(tello_count)
+        {
+            this->estimator_settings.validate();
+
+            if (tello_count == 0)
+            {
+                throw std::invalid_argument("Sorry, your state estimator batch has to estimate at least one Tello.");
+            }
+
+            for (std::size_t axis = 0; axis < axis_count; axis++)
+            {
+                this->position[axis].resize(this->padded_tello_count);
+                this->velocity[axis].resize(this->padded_tello_count);
+                this->covariance_pp[axis].resize(this->padded_tello_count);
+                this->covariance_pv[axis].resize(this->padded_tello_count);
+                this->covariance_vv[axis].resize(this->padded_tello_count);
+                this->acceleration_inputs[axis].resize(this->padded_tello_count);
+                this->measured_velocities[axis].resize(this->padded_tello_count);
+            }
+        }
+
+        void update(std::span<const TelloState> tello_states, std::span<const std::chrono::steady_clock::time_point> received_at)
+        {
+            if (tello_states.size() != this->tello_count || received_at.size() != this->tello_count)
+            {
+                throw std::invalid_argument("Sorry, you have to give your state estimator batch one Tello state and one timestamp per Tello.");
+            }
+
+            float acceleration_variance = this->estimator_settings.acceleration_noise_cm_per_sec_squared * this->estimator_settings.acceleration_noise_cm_per_sec_squared;
+            float velocity_variance = this->estimator_settings.velocity_noise_cm_per_sec * this->estimator_settings.velocity_noise_cm_per_sec;
+            float height_variance = this->estimator_settings.height_noise_cm * this->estimator_settings.height_noise_cm;
+
+            for (std::size_t tello_index = 0; tello_index < this->tello_count; tello_index++)
+            {
+                this->prepare_measurement(tello_index, tello_states[tello_index], received_at[tello_index]);
+            }
+
+            for (std::size_t axis = 0; axis < axis_count; axis++)
+            {
+                update_tello_axes(this->padded_tello_count, this->position[axis].data(), this->velocity[axis].data(), this->covariance_pp[axis].data(), this->covariance_pv[axis].data(), this->covariance_vv[axis].data(), this->acceleration_inputs[axis].data(), this->measured_velocities[axis].data(), this->elapsed_secs.data(), this->measurement_weights.data(), acceleration_variance, velocity_variance);
+            }
+
+            for (std::size_t tello_index = 0; tello_index < this->tello_count; tello_index++)
+            {
+                correct_tello_axis_position(this->position[2][tello_index], this->velocity[2][tello_index], this->covariance_pp[2][tello_index], this->covariance_pv[2][tello_index], this->covariance_vv[2][tello_index], this->measured_heights[tello_index], height_variance, this->measurement_weights[tello_index]);
+            }
+
+            for (std::size_t tello_index = 0; tello_index < this->tello_count; tello_index++)
+            {
+                this->publish_pose(tello_index);
+            }
+        }
+
+        std::size_t size() const
+        {
+            return this->tello_count;
+        }
+
+        bool has_estimate(const std::size_t &tello_index) const
+        {
+            return this->get_sample_count(tello_index) > 0;
+        }
+
+        std::uint64_t get_sample_count(const std::size_t &tello_index) const
+        {
+            if (tello_index >= this->tello_count)
+            {
+                throw std::out_of_range("Sorry, that Tello isn't in this state estimator batch.");
+            }
+
+            return this->sample_counts[tello_index];
+        }
+
+        TelloPose get_pose(const std::size_t &tello_index, const std::chrono::steady_clock::time_point &at) const
+        {
+            if (!this->has_estimate(tello_index))
+            {
+                throw std::runtime_error("Sorry, we haven't estimated that Tello's pose yet.");
+            }
+
+            return predict_tello_pose(this->previous_poses[tello_index], this->latest_poses[tello_index], at, this->estimator_settings.max_extrapolation);
+        }
+
+    private:
+        static void update_tello_axes
+        (
+        const std::size_t &padded_tello_count,
+        float *positions,
+        float *velocities,
+        float *covariances_pp,
+        float *covariances_pv,
+        float *covariances_vv,
+        const float *accelerations,
+        const float *measured_velocities,
+        const float *elapsed_secs,
+        const float *measurement_weights,
+        const float &acceleration_variance,
+        const float &velocity_variance
+        )
+        {
+            for (std::size_t block_start = 0; block_start < padded_tello_count; block_start += lane_count)
+            {
+                float position[lane_count], velocity[lane_count], covariance_pp[lane_count], covariance_pv[lane_count], covariance_vv[lane_count];
+
+                std::copy_n(positions + block_start, lane_count, position);
+                std::copy_n(velocities + block_start, lane_count, velocity);
+                std::copy_n(covariances_pp + block_start, lane_count, covariance_pp);
+                std::copy_n(covariances_pv + block_start, lane_count, covariance_pv);
+                std::copy_n(covariances_vv + block_start, lane_count, covariance_vv);
+
+                for (std::size_t lane = 0; lane < lane_count; lane++)
+                {
+                    predict_tello_axis(position[lane], velocity[lane], covariance_pp[lane], covariance_pv[lane], covariance_vv[lane], accelerations[block_start + lane], elapsed_secs[block_start + lane], acceleration_variance);
+                    correct_tello_axis_velocity(position[lane], velocity[lane], covariance_pp[lane], covariance_pv[lane], covariance_vv[lane], measured_velocities[block_start + lane], velocity_variance, measurement_weights[block_start + lane]);
+                }
+
+                std::copy_n(position, lane_count, positions + block_start);
+                std::copy_n(velocity, lane_count, velocities + block_start);
+                std::copy_n(covariance_pp, lane_count, covariances_pp + block_start);
+                std::copy_n(covariance_pv, lane_count, covariances_pv + block_start);
+                std::copy_n(covariance_vv, lane_count, covariances_vv + block_start);
+            }
+        }
+
+        void prepare_measurement(const std::size_t &tello_index, const TelloState &tello_state, const std::chrono::steady_clock::time_point &received_at)
+        {
+            std::chrono::steady_clock::duration elapsed = received_at - this->latest_poses[tello_index].timestamp;
+
+            this->elapsed_secs[tello_index] = 0;
+            this->measurement_weights[tello_index] = 0;
+            this->restarting_tellos[tello_index] = false;
+
+            if (this->sample_counts[tello_index] > 0 && elapsed <= std::chrono::steady_clock::duration::zero())
+            {
+                return;
+            }
+
+            TelloStateMeasurement measurement = measure_tello_state(tello_state, this->estimator_settings);
+            TelloPose &latest_pose = this->latest_poses[tello_index];
+
+            this->previous_poses[tello_index] = latest_pose;
+            this->measured_heights[tello_index] = measurement.down_position_cm;
+
+            float velocity_variance = this->estimator_settings.velocity_noise_cm_per_sec * this->estimator_settings.velocity_noise_cm_per_sec;
+            bool restarting = this->sample_counts[tello_index] == 0 || elapsed > this->estimator_settings.max_sample_gap;
+            float elapsed_secs = restarting ? 0 : std::chrono::duration<float>(elapsed).count();
+
+            for (std::size_t axis = 0; axis < axis_count; axis++)
+            {
+                this->acceleration_inputs[axis][tello_index] = 0.5f * (latest_pose.acceleration_cm_per_sec_squared[axis] + measurement.acceleration_cm_per_sec_squared[axis]);
+                this->measured_velocities[axis][tello_index] = measurement.velocity_cm_per_sec[axis];
+
+                if (restarting)
+                {
+                    this->velocity[axis][tello_index] = measurement.velocity_cm_per_sec[axis];
+                    this->covariance_pp[axis][tello_index] = 0;
+                    this->covariance_pv[axis][tello_index] = 0;
+                    this->covariance_vv[axis][tello_index] = velocity_variance;
+                }
+
+                latest_pose.attitude_rate_degrees_per_sec[axis] = restarting ? 0 : wrap_degrees(measurement.attitude_degrees[axis] - latest_pose.attitude_degrees[axis]) / elapsed_secs;
+            }
+
+            if (restarting)
+            {
+                this->position[2][tello_index] = measurement.down_position_cm;
+                this->covariance_pp[2][tello_index] = this->estimator_settings.height_noise_cm * this->estimator_settings.height_noise_cm;
+            }
+
+            latest_pose.timestamp = received_at;
+            latest_pose.acceleration_cm_per_sec_squared = measurement.acceleration_cm_per_sec_squared;
+            latest_pose.attitude_degrees = measurement.attitude_degrees;
+
+            this->elapsed_secs[tello_index] = elapsed_secs;
+            this->measurement_weights[tello_index] = restarting ? 0 : 1;
+            this->restarting_tellos[tello_index] = restarting;
+            this->sample_counts[tello_index]++;
+        }
+
+        void publish_pose(const std::size_t &tello_index)
+        {
+            TelloPose &latest_pose = this->latest_poses[tello_index];
+
+            for (std::size_t axis = 0; axis < axis_count; axis++)
+            {
+                latest_pose.position_cm[axis] = this->position[axis][tello_index];
+                latest_pose.velocity_cm_per_sec[axis] = this->velocity[axis][tello_index];
+            }
+
+            if (this->restarting_tellos[tello_index])
+            {
+                this->previous_poses[tello_index] = latest_pose;
+            }
+        }
+
+        TelloStateEstimatorSettings estimator_settings;
+        std::size_t tello_count;
+        std::size_t padded_tello_count;
+
+        std::array<std::vector<float>, axis_count> position;
+        std::array<std::vector<float>, axis_count> velocity;
+        std::array<std::vector<float>, axis_count> covariance_pp;
+        std::array<std::vector<float>, axis_count> covariance_pv;
+        std::array<std::vector<float>, axis_count> covariance_vv;
+
+        std::array<std::vector<float>, axis_count> acceleration_inputs;
+        std::array<std::vector<float>, axis_count> measured_velocities;
+        std::vector<float> measured_heights;
+        std::vector<float> elapsed_secs;
+        std::vector<float> measurement_weights;
+        std::vector<std::uint8_t> restarting_tellos;
+
+        std::vector<TelloPose> previous_poses;
+        std::vector<TelloPose> latest_poses;
+        std::vector<std::uint64_t> sample_counts;
+};
\ No newline at end of file
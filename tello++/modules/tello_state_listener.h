@@ -0,0 +1,234 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "internals/address_table.h"
+#include "internals/socket_util.h"
+
+#include "tello_logger.h"
+#include "tello_socket.h"
+#include "tello_state.h"
+#include "tello_state_stream.h"
+
+class TelloStateListener
+{
+    public:
+        using TelloStateHandler = std::function<void(const TelloStateSample&)>;
+
+#if defined(SO_REUSEPORT)
+        static constexpr bool can_shard = true;
+#else
+        static constexpr bool can_shard = false;
+#endif
+
+        static constexpr int max_batch_size = 64;
+        static constexpr int datagram_buffer_size = 512;
+        static constexpr int receive_buffer_bytes = 1 << 20;
+
+        TelloStateListener
+        (
+        const TelloLogger &tello_logger,
+        const std::string &tello_state_receiver_ip = "0.0.0.0",
+        const int &tello_state_receiver_port = 8890,
+        const int &worker_count = 1,
+        const int &poll_timeout_millis = 100
+        ):
+        tello_logger{tello_logger}
+        {
+            if (worker_count < 1)
+            {
+                throw std::invalid_argument("Sorry, your state listener needs at least one worker.");
+            }
+
+            int shard_count = can_shard ? worker_count : 1;
+
+            for (int shard = 0; shard < shard_count; shard++)
+            {
+                this->tello_state_receivers.push_back(std::make_unique<TelloSocket>(tello_logger, 1, "0.0.0.0", 0, tello_state_receiver_ip, tello_state_receiver_port, shard_count > 1));
+                this->tello_state_receivers.back()->set_receive_timeout(poll_timeout_millis);
+                this->tello_state_receivers.back()->set_receive_buffer_size(receive_buffer_bytes);
+            }
+        }
+
+        TelloStateListener(TelloStateListener const&) = delete;
+        void operator = (TelloStateListener const&) = delete;
+
+        void subscribe(const std::string &tello_ip, const TelloStateHandler &tello_state_handler)
+        {
+            std::unique_lock<std::shared_mutex> subscription_lock(this->subscription_mutex);
+
+            if (!this->subscriptions.insert(encode_ip_address(AF_INET, tello_ip).s_addr, tello_state_handler))
+            {
+                throw std::invalid_argument(format_string("Sorry, something is already listening to the state of the Tello at '%s'.", tello_ip.c_str()));
+            }
+        }
+
+        void unsubscribe(const std::string &tello_ip)
+        {
+            std::unique_lock<std::shared_mutex> subscription_lock(this->subscription_mutex);
+            this->subscriptions.erase(encode_ip_address(AF_INET, tello_ip).s_addr);
+        }
+
+        std::size_t get_subscription_count() const
+        {
+            std::shared_lock<std::shared_mutex> subscription_lock(this->subscription_mutex);
+            return this->subscriptions.size();
+        }
+
+        int get_worker_count() const
+        {
+            return static_cast<int>(this->tello_state_receivers.size());
+        }
+
+        std::uint64_t get_tello_state_count() const
+        {
+            return this->tello_states.load(std::memory_order_relaxed);
+        }
+
+        std::uint64_t get_unknown_datagram_count() const
+        {
+            return this->unknown_datagrams.load(std::memory_order_relaxed);
+        }
+
+        void start()
+        {
+            if (this->running.exchange(true))
+            {
+                return;
+            }
+
+            for (std::unique_ptr<TelloSocket> &tello_state_receiver : this->tello_state_receivers)
+            {
+                this->worker_threads.emplace_back(&TelloStateListener::receive_tello_states, this, std::ref(*tello_state_receiver));
+            }
+        }
+
+        void stop()
+        {
+            if (!this->running.exchange(false))
+            {
+                return;
+            }
+
+            for (std::thread &worker_thread : this->worker_threads)
+            {
+                worker_thread.join();
+            }
+
+            this->worker_threads.clear();
+        }
+
+        bool is_running() const
+        {
+            return this->running.load(std::memory_order_relaxed);
+        }
+
+        ~TelloStateListener()
+        {
+            this->stop();
+        }
+
+    private:
+        void receive_tello_states(TelloSocket &tello_state_receiver)
+        {
+            std::vector<char> datagram_buffers(max_batch_size * datagram_buffer_size);
+            TelloDatagram datagrams[max_batch_size];
+            TelloStateSample tello_state_sample{};
+            std::chrono::steady_clock::time_point log_unknown_datagrams_at{};
+
+            for (int datagram_index = 0; datagram_index < max_batch_size; datagram_index++)
+            {
+                datagrams[datagram_index] = TelloDatagram{datagram_buffers.data() + datagram_index * datagram_buffer_size, datagram_buffer_size, 0, {}};
+            }
+
+            while (this->running.load(std::memory_order_relaxed))
+            {
+                int received_count;
+
+                try
+                {
+                    received_count = tello_state_receiver.receive_datagrams(datagrams, max_batch_size);
+                }
+                catch(const std::runtime_error &receive_error)
+                {
+                    this->tello_logger.log_data(receive_error.what());
+                    continue;
+                }
+
+                if (received_count <= 0)
+                {
+                    continue;
+                }
+
+                tello_state_sample.received_at = std::chrono::steady_clock::now();
+                std::uint64_t batch_tello_states = 0;
+                std::uint64_t batch_unknown_datagrams = 0;
+                in_addr unknown_address{};
+
+                std::shared_lock<std::shared_mutex> subscription_lock(this->subscription_mutex);
+
+                for (int datagram_index = 0; datagram_index < received_count; datagram_index++)
+                {
+                    TelloDatagram &datagram = datagrams[datagram_index];
+                    const TelloStateHandler *tello_state_handler = this->subscriptions.find(datagram.source_address.sin_addr.s_addr);
+
+                    if (!tello_state_handler)
+                    {
+                        batch_unknown_datagrams++;
+                        unknown_address = datagram.source_address.sin_addr;
+                        continue;
+                    }
+
+                    if (!try_parse_tello_state(std::string_view(datagram.data, datagram.size), tello_state_sample.tello_state))
+                    {
+                        continue;
+                    }
+
+                    batch_tello_states++;
+
+                    try
+                    {
+                        (*tello_state_handler)(tello_state_sample);
+                    }
+                    catch(const std::exception &handler_error)
+                    {
+                        this->tello_logger.log_data(format_string("Tello state handler failed: '%s'", handler_error.what()));
+                    }
+                }
+
+                subscription_lock.unlock();
+
+                this->tello_states.fetch_add(batch_tello_states, std::memory_order_relaxed);
+                this->unknown_datagrams.fetch_add(batch_unknown_datagrams, std::memory_order_relaxed);
+
+                if (batch_unknown_datagrams > 0 && tello_state_sample.received_at >= log_unknown_datagrams_at)
+                {
+                    this->tello_logger.log_data(format_string("Unknown connection from ip '%s'", decode_ip_address(AF_INET, unknown_address, INET_ADDRSTRLEN).c_str()));
+                    log_unknown_datagrams_at = tello_state_sample.received_at + std::chrono::seconds(1);
+                }
+            }
+        }
+
+        const TelloLogger &tello_logger;
+        std::vector<std::unique_ptr<TelloSocket>> tello_state_receivers;
+
+        mutable std::shared_mutex subscription_mutex;
+        AddressTable<TelloStateHandler> subscriptions;
+
+        std::atomic<std::uint64_t> tello_states{0};
+        std::atomic<std::uint64_t> unknown_datagrams{0};
+
+        std::atomic<bool> running{false};
+        std::vector<std::thread> worker_threads;
+};
\ No newline at end of file
@@ -0,0 +1,3 @@
+#include "tello_state_stream.h"
+
+template class SeqLock<TelloStateSample>;
\ No newline at end of file
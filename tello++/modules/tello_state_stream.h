@@ -0,0 +1,175 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+
+#include "internals/seqlock.h"
+
+#include "tello_socket.h"
+#include "tello_state.h"
+
+struct TelloStateSample
+{
+    TelloState tello_state;
+    std::chrono::steady_clock::time_point received_at;
+};
+
+extern template class SeqLock<TelloStateSample>;
+
+class TelloStateStream
+{
+    public:
+        TelloStateStream(TelloSocket &tello_state_receiver, const int &poll_timeout_millis = 100) :
+        tello_state_receiver{&tello_state_receiver},
+        poll_timeout_millis{poll_timeout_millis}
+        {}
+
+        TelloStateStream(const int &blocking_timeout_millis) :
+        tello_state_receiver{nullptr},
+        poll_timeout_millis{0},
+        blocking_timeout_millis{blocking_timeout_millis}
+        {}
+
+        TelloStateStream(TelloStateStream const&) = delete;
+        void operator = (TelloStateStream const&) = delete;
+
+        void start()
+        {
+            if (this->running.exchange(true) || !this->tello_state_receiver)
+            {
+                return;
+            }
+
+            this->blocking_timeout_millis = this->tello_state_receiver->get_receive_timeout();
+            this->tello_state_receiver->set_receive_timeout(this->poll_timeout_millis);
+
+            this->receiver_thread = std::thread(&TelloStateStream::receive_tello_states, this);
+        }
+
+        void stop()
+        {
+            if (!this->running.exchange(false) || !this->tello_state_receiver)
+            {
+                return;
+            }
+
+            this->receiver_thread.join();
+            this->tello_state_receiver->set_receive_timeout(this->blocking_timeout_millis);
+        }
+
+        void publish_tello_state_sample(const TelloStateSample &tello_state_sample)
+        {
+            if (!this->tello_state_receiver && this->running.load(std::memory_order_relaxed))
+            {
+                this->accept_tello_state_sample(tello_state_sample);
+            }
+        }
+
+        void set_tello_state_listener(const std::function<void(const TelloStateSample&)> &tello_state_listener)
+        {
+            if (this->is_running())
+            {
+                throw std::runtime_error("Sorry, you can't change the state listener while the state stream is running.");
+            }
+
+            this->tello_state_listener = tello_state_listener;
+        }
+
+        bool is_running() const
+        {
+            return this->running.load(std::memory_order_relaxed);
+        }
+
+        bool try_get_tello_state_sample(TelloStateSample &tello_state_sample) const
+        {
+            return this->latest_tello_state.load(tello_state_sample);
+        }
+
+        TelloStateSample get_tello_state_sample() const
+        {
+            TelloStateSample tello_state_sample;
+
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(this->blocking_timeout_millis);
+
+            while (!this->try_get_tello_state_sample(tello_state_sample))
+            {
+                if (std::chrono::steady_clock::now() > deadline)
+                {
+                    throw std::runtime_error("Sorry, your Tello hasn't sent us its state yet.");
+                }
+
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+
+            return tello_state_sample;
+        }
+
+        TelloState get_tello_state() const
+        {
+            return this->get_tello_state_sample().tello_state;
+        }
+
+        std::uint64_t get_tello_state_count() const
+        {
+            return this->latest_tello_state.get_version();
+        }
+
+        ~TelloStateStream()
+        {
+            try
+            {
+                this->stop();
+            }
+            catch(...)
+            {
+
+            }
+        }
+
+    private:
+        void receive_tello_states()
+        {
+            TelloStateSample tello_state_sample{};
+
+            while (this->running.load(std::memory_order_relaxed))
+            {
+                try
+                {
+                    std::string_view tello_state_response = this->tello_state_receiver->receive_data_view();
+
+                    if (try_parse_tello_state(tello_state_response, tello_state_sample.tello_state))
+                    {
+                        tello_state_sample.received_at = std::chrono::steady_clock::now();
+                        this->accept_tello_state_sample(tello_state_sample);
+                    }
+                }
+                catch(const std::runtime_error&)
+                {
+
+                }
+            }
+        }
+
+        void accept_tello_state_sample(const TelloStateSample &tello_state_sample)
+        {
+            this->latest_tello_state.store(tello_state_sample);
+
+            if (this->tello_state_listener)
+            {
+                this->tello_state_listener(tello_state_sample);
+            }
+        }
+
+        TelloSocket *tello_state_receiver;
+        int poll_timeout_millis;
+        int blocking_timeout_millis = 0;
+
+        std::function<void(const TelloStateSample&)> tello_state_listener;
+
+        std::atomic<bool> running{false};
+        std::thread receiver_thread;
+        SeqLock<TelloStateSample> latest_tello_state;
+};
\ No newline at end of file
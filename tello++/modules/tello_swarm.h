@@ -0,0 +1,469 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#elif !defined(_WIN32)
+#include <poll.h>
+#endif
+
+#include "internals/io_uring_engine.h"
+#include "internals/socket_base.h"
+#include "internals/socket_util.h"
+
+#include "tello_endpoint.h"
+#include "tello_flight_recorder.h"
+#include "tello_logger.h"
+#include "tello_socket.h"
+#include "tello_state.h"
+
+class TelloSwarm
+{
+    public:
+        using TelloEndpoint = ::TelloEndpoint;
+
+        using ResponseHandler = std::function<void(std::size_t tello_id, std::string_view response)>;
+        using TelloStateHandler = std::function<void(std::size_t tello_id, const TelloState &tello_state)>;
+        using VideoHandler = std::function<void(std::size_t tello_id, std::string_view video_datagram)>;
+
+        struct TelloHandlers
+        {
+            ResponseHandler on_response;
+            TelloStateHandler on_tello_state;
+            VideoHandler on_video_datagram;
+        };
+
+        static constexpr int no_receiver = TelloEndpoint::no_receiver;
+
+        bool tello_logging;
+
+        TelloSwarm(const bool &tello_logging = false, const int &tello_response_timeout_secs = 12) :
+        tello_logging{tello_logging},
+        tello_logger{TelloLogger(this->tello_logging)},
+        tello_response_timeout_secs{tello_response_timeout_secs}
+        {
+#if defined(TELLO_IO_URING_ENGINE)
+            try
+            {
+                this->io_uring_engine = std::make_unique<IoUringEngine>();
+            }
+            catch(const std::runtime_error &io_uring_error)
+            {
+                this->tello_logger.log_data(io_uring_error.what());
+            }
+#endif
+
+#if defined(__linux__)
+            this->event_loop = epoll_create1(0);
+
+            if (this->event_loop == -1)
+            {
+                throw_socket_error("Sorry, we couldn't create an event loop for your swarm.");
+            }
+#endif
+        }
+
+        TelloSwarm(TelloSwarm const&) = delete;
+        void operator = (TelloSwarm const&) = delete;
+
+        std::size_t add_tello(const TelloEndpoint &tello_endpoint, const TelloHandlers &tello_handlers)
+        {
+            if (this->is_running())
+            {
+                throw std::runtime_error("Sorry, you can't add a Tello to a swarm that's already running.");
+            }
+
+            std::size_t tello_id = this->tellos.size();
+
+            std::unique_ptr<SwarmTello> swarm_tello = std::make_unique<SwarmTello>();
+            swarm_tello->tello_handlers = tello_handlers;
+
+            swarm_tello->sockets[command_channel] = this->open_socket(tello_endpoint, tello_endpoint.tello_client_ip, tello_endpoint.tello_client_port);
+
+            if (tello_endpoint.tello_state_receiver_port != no_receiver)
+            {
+                swarm_tello->sockets[state_channel] = this->open_socket(tello_endpoint, tello_endpoint.tello_state_receiver_ip, tello_endpoint.tello_state_receiver_port);
+            }
+
+            if (tello_endpoint.tello_video_receiver_port != no_receiver)
+            {
+                swarm_tello->sockets[video_channel] = this->open_socket(tello_endpoint, tello_endpoint.tello_video_receiver_ip, tello_endpoint.tello_video_receiver_port);
+            }
+
+            this->tellos.push_back(std::move(swarm_tello));
+
+            for (int channel = 0; channel < channel_count; channel++)
+            {
+                if (this->tellos[tello_id]->sockets[channel])
+                {
+                    this->watch_socket(tello_id, channel);
+                }
+            }
+
+            return tello_id;
+        }
+
+        void set_flight_recorder(TelloFlightRecorder *flight_recorder)
+        {
+            if (this->is_running())
+            {
+                throw std::runtime_error("Sorry, you can't change the flight recorder of a swarm that's already running.");
+            }
+
+            this->flight_recorder = flight_recorder;
+        }
+
+        std::size_t get_tello_count() const
+        {
+            return this->tellos.size();
+        }
+
+        void send_command(const std::size_t &tello_id, const std::string &to_send)
+        {
+            this->get_swarm_tello(tello_id).sockets[command_channel]->send_data(to_send);
+        }
+
+        void send_command_to_all(const std::string &to_send)
+        {
+            for (std::unique_ptr<SwarmTello> &swarm_tello : this->tellos)
+            {
+                swarm_tello->sockets[command_channel]->send_data(to_send);
+            }
+        }
+
+        bool is_using_io_uring() const
+        {
+#if defined(TELLO_IO_URING_ENGINE)
+            return this->io_uring_engine != nullptr;
+#else
+            return false;
+#endif
+        }
+
+        int poll_events(const int &timeout_millis)
+        {
+            int ready_count = 0;
+
+#if defined(TELLO_IO_URING_ENGINE)
+            if (this->io_uring_engine)
+            {
+                int completed_count = this->io_uring_engine->poll_completions
+                (
+                    timeout_millis,
+                    [this](const std::uint64_t &watch_key, std::string_view datagram, const sockaddr_in &source_address)
+                    {
+                        this->dispatch_completed_datagram(static_cast<std::size_t>(watch_key >> 2), static_cast<int>(watch_key & 3), datagram, source_address);
+                    }
+                );
+
+                if (this->io_uring_engine->has_failed())
+                {
+                    this->fall_back_to_epoll();
+                }
+
+                return completed_count;
+            }
+#endif
+
+#if defined(__linux__)
+            epoll_event ready_events[max_ready_events];
+            ready_count = epoll_wait(this->event_loop, ready_events, max_ready_events, timeout_millis);
+
+            if (ready_count == -1)
+            {
+                if (errno == EINTR)
+                {
+                    return 0;
+                }
+
+                throw_socket_error("Sorry, we couldn't wait on your swarm's sockets.");
+            }
+
+            for (int ready_index = 0; ready_index < ready_count; ready_index++)
+            {
+                std::uint64_t watch_key = ready_events[ready_index].data.u64;
+                this->drain_socket(static_cast<std::size_t>(watch_key >> 2), static_cast<int>(watch_key & 3));
+            }
+#else
+#if defined(_WIN32)
+            ready_count = WSAPoll(this->watched_sockets.data(), static_cast<ULONG>(this->watched_sockets.size()), timeout_millis);
+#else
+            ready_count = poll(this->watched_sockets.data(), this->watched_sockets.size(), timeout_millis);
+#endif
+
+            if (ready_count == native_socket_error)
+            {
+                throw_socket_error("Sorry, we couldn't wait on your swarm's sockets.");
+            }
+
+            for (std::size_t watch_index = 0; watch_index < this->watched_sockets.size(); watch_index++)
+            {
+                if (this->watched_sockets[watch_index].revents & POLLIN)
+                {
+                    std::uint64_t watch_key = this->watch_keys[watch_index];
+                    this->drain_socket(static_cast<std::size_t>(watch_key >> 2), static_cast<int>(watch_key & 3));
+                }
+            }
+#endif
+
+            return ready_count;
+        }
+
+        void start(const int &poll_timeout_millis = 50)
+        {
+            if (this->running.exchange(true))
+            {
+                return;
+            }
+
+            this->event_loop_thread = std::thread
+            (
+                [this, poll_timeout_millis]()
+                {
+                    while (this->running.load(std::memory_order_relaxed))
+                    {
+                        this->poll_events(poll_timeout_millis);
+                    }
+                }
+            );
+        }
+
+        void stop()
+        {
+            if (!this->running.exchange(false))
+            {
+                return;
+            }
+
+            this->event_loop_thread.join();
+        }
+
+        bool is_running() const
+        {
+            return this->running.load(std::memory_order_relaxed);
+        }
+
+        void write_log(const std::string &log_location) const
+        {
+            this->tello_logger.write_log(log_location);
+        }
+
+        ~TelloSwarm()
+        {
+            this->stop();
+
+#if defined(__linux__)
+            close(this->event_loop);
+#endif
+        }
+
+    private:
+        static constexpr int command_channel = 0;
+        static constexpr int state_channel = 1;
+        static constexpr int video_channel = 2;
+        static constexpr int channel_count = 3;
+
+        static constexpr int max_ready_events = 64;
+        static constexpr int datagram_buffer_size = 2048;
+
+        struct SwarmTello
+        {
+            std::unique_ptr<TelloSocket> sockets[channel_count];
+            TelloHandlers tello_handlers;
+        };
+
+        std::unique_ptr<TelloSocket> open_socket(const TelloEndpoint &tello_endpoint, const std::string &receiver_ip, const int &receiver_port)
+        {
+            std::unique_ptr<TelloSocket> tello_socket = std::make_unique<TelloSocket>
+            (
+                this->tello_logger,
+                this->tello_response_timeout_secs,
+                tello_endpoint.tello_ip,
+                tello_endpoint.tello_port,
+                receiver_ip,
+                receiver_port
+            );
+
+            tello_socket->set_non_blocking(true);
+
+            return tello_socket;
+        }
+
+#if defined(TELLO_IO_URING_ENGINE)
+        void fall_back_to_epoll()
+        {
+            this->tello_logger.log_data("Sorry, your swarm's io_uring keeps failing to receive, so we're falling back to epoll.");
+            this->io_uring_engine.reset();
+
+            for (std::size_t tello_id = 0; tello_id < this->tellos.size(); tello_id++)
+            {
+                for (int channel = 0; channel < channel_count; channel++)
+                {
+                    if (this->tellos[tello_id]->sockets[channel])
+                    {
+                        this->watch_socket(tello_id, channel);
+                    }
+                }
+            }
+        }
+#endif
+
+        void watch_socket(const std::size_t &tello_id, const int &channel)
+        {
+            std::uint64_t watch_key = (static_cast<std::uint64_t>(tello_id) << 2) | static_cast<std::uint64_t>(channel);
+            NativeSocket native_socket = this->tellos[tello_id]->sockets[channel]->get_native_socket();
+
+#if defined(TELLO_IO_URING_ENGINE)
+            if (this->io_uring_engine)
+            {
+                this->io_uring_engine->watch_socket(native_socket, watch_key);
+                return;
+            }
+#endif
+
+#if defined(__linux__)
+            epoll_event watch_event{};
+            watch_event.events = EPOLLIN;
+            watch_event.data.u64 = watch_key;
+
+            if (epoll_ctl(this->event_loop, EPOLL_CTL_ADD, native_socket, &watch_event) == -1)
+            {
+                throw_socket_error("Sorry, we couldn't add your Tello's socket to the swarm's event loop.");
+            }
+#else
+            pollfd watched_socket{};
+            watched_socket.fd = native_socket;
+            watched_socket.events = POLLIN;
+
+            this->watched_sockets.push_back(watched_socket);
+            this->watch_keys.push_back(watch_key);
+#endif
+        }
+
+        SwarmTello &get_swarm_tello(const std::size_t &tello_id)
+        {
+            if (tello_id >= this->tellos.size())
+            {
+                throw std::out_of_range(format_string("Sorry, your swarm doesn't have a Tello with the id '%zu'.", tello_id));
+            }
+
+            return *this->tellos[tello_id];
+        }
+
+        void drain_socket(const std::size_t &tello_id, const int &channel)
+        {
+            SwarmTello &swarm_tello = *this->tellos[tello_id];
+            TelloSocket &tello_socket = *swarm_tello.sockets[channel];
+
+            while (true)
+            {
+                int received_size;
+
+                try
+                {
+                    received_size = tello_socket.receive_into(this->datagram_buffer, datagram_buffer_size);
+                }
+                catch(const std::runtime_error &receive_error)
+                {
+                    this->tello_logger.log_data(receive_error.what());
+                    return;
+                }
+
+                if (received_size < 0)
+                {
+                    return;
+                }
+
+                this->dispatch_datagram(tello_id, channel, swarm_tello.tello_handlers, std::string_view(this->datagram_buffer, received_size));
+            }
+        }
+
+#if defined(TELLO_IO_URING_ENGINE)
+        void dispatch_completed_datagram(const std::size_t &tello_id, const int &channel, std::string_view datagram, const sockaddr_in &source_address)
+        {
+            SwarmTello &swarm_tello = *this->tellos[tello_id];
+
+            if (source_address.sin_addr.s_addr != swarm_tello.sockets[channel]->get_tello_address().sin_addr.s_addr)
+            {
+                in_addr source_ip_address = source_address.sin_addr;
+                this->tello_logger.log_data(format_string("Unknown connection from ip '%s'", decode_ip_address(AF_INET, source_ip_address, INET_ADDRSTRLEN).c_str()));
+                return;
+            }
+
+            this->dispatch_datagram(tello_id, channel, swarm_tello.tello_handlers, datagram);
+        }
+#endif
+
+        void dispatch_datagram(const std::size_t &tello_id, const int &channel, const TelloHandlers &tello_handlers, std::string_view datagram)
+        {
+            try
+            {
+                switch (channel)
+                {
+                    case command_channel:
+                        if (tello_handlers.on_response)
+                        {
+                            tello_handlers.on_response(tello_id, datagram);
+                        }
+                        break;
+                    case state_channel:
+                        if ((tello_handlers.on_tello_state || this->flight_recorder) && try_parse_tello_state(datagram, this->parsed_tello_state))
+                        {
+                            if (this->flight_recorder)
+                            {
+                                this->flight_recorder->record(this->parsed_tello_state, static_cast<std::uint32_t>(tello_id));
+                            }
+
+                            if (tello_handlers.on_tello_state)
+                            {
+                                tello_handlers.on_tello_state(tello_id, this->parsed_tello_state);
+                            }
+                        }
+                        break;
+                    case video_channel:
+                        if (tello_handlers.on_video_datagram)
+                        {
+                            tello_handlers.on_video_datagram(tello_id, datagram);
+                        }
+                        break;
+                }
+            }
+            catch(const std::exception &handler_error)
+            {
+                this->tello_logger.log_data(format_string("Tello '%zu' handler failed: '%s'", tello_id, handler_error.what()));
+            }
+        }
+
+        TelloLogger tello_logger;
+        int tello_response_timeout_secs;
+
+        std::vector<std::unique_ptr<SwarmTello>> tellos;
+
+#if defined(TELLO_IO_URING_ENGINE)
+        std::unique_ptr<IoUringEngine> io_uring_engine;
+#endif
+
+#if defined(__linux__)
+        int event_loop = -1;
+#else
+        std::vector<pollfd> watched_sockets;
+        std::vector<std::uint64_t> watch_keys;
+#endif
+
+        TelloFlightRecorder *flight_recorder = nullptr;
+
+        char datagram_buffer[datagram_buffer_size];
+        TelloState parsed_tello_state{};
+
+        std::atomic<bool> running{false};
+        std::thread event_loop_thread;
+};
\ No newline at end of file
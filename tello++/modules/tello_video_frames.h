@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "internals/frame_pool.h"
+
+using VideoDecoder = std::function<bool(const Frame &access_unit, Frame &decoded_frame)>;
+using VideoConsumer = std::function<void(const FrameHandle &video_frame)>;
+
+struct TelloVideoPipelineSettings
+{
+    std::size_t max_access_unit_size = 512 * 1024;
+    std::size_t max_decoded_frame_size = 960 * 720 * 3 / 2;
+    std::size_t decode_queue_capacity = 4;
+    std::size_t consumer_queue_capacity = 2;
+    int poll_timeout_millis = 100;
+};
+
+struct TelloVideoPipelineStatistics
+{
+    std::uint64_t received_access_units;
+    std::uint64_t malformed_access_units;
+    std::uint64_t exhausted_frame_pool_drops;
+    std::uint64_t decode_queue_drops;
+    std::uint64_t rejected_by_decoder;
+    std::uint64_t consumer_queue_drops;
+    std::uint64_t consumed_frames;
+};
\ No newline at end of file
@@ -0,0 +1,3 @@
+#include "tello_video_pipeline.h"
+
+template class DropOldestQueue<FrameHandle>;
\ No newline at end of file
@@ -0,0 +1,325 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "internals/drop_oldest_queue.h"
+#include "internals/frame_pool.h"
+
+#include "tello_socket.h"
+#include "tello_video_frames.h"
+#include "tello_video_receiver.h"
+
+extern template class DropOldestQueue<FrameHandle>;
+
+class TelloVideoPipeline
+{
+    public:
+        TelloVideoPipeline(TelloSocket &tello_video_receiver, const TelloVideoPipelineSettings &pipeline_settings = TelloVideoPipelineSettings{}) :
+        tello_video_receiver{tello_video_receiver},
+        tello_video_assembler{tello_video_receiver},
+        pipeline_settings{pipeline_settings},
+        decode_queue{pipeline_settings.decode_queue_capacity}
+        {
+            if (pipeline_settings.max_access_unit_size < TelloVideoReceiver::max_video_datagram_size)
+            {
+                throw std::invalid_argument("Sorry, your video pipeline's access units have to hold at least one whole datagram.");
+            }
+        }
+
+        TelloVideoPipeline(TelloVideoPipeline const&) = delete;
+        void operator = (TelloVideoPipeline const&) = delete;
+
+        void set_video_decoder(const VideoDecoder &video_decoder)
+        {
+            if (this->is_running())
+            {
+                throw std::runtime_error("Sorry, you can't change the video decoder while the video pipeline is running.");
+            }
+
+            this->video_decoder = video_decoder;
+        }
+
+        void add_video_consumer(const VideoConsumer &video_consumer)
+        {
+            if (this->is_running())
+            {
+                throw std::runtime_error("Sorry, you can't add a video consumer while the video pipeline is running.");
+            }
+
+            this->consumer_stages.push_back(std::make_unique<ConsumerStage>(video_consumer, this->pipeline_settings.consumer_queue_capacity));
+        }
+
+        void start()
+        {
+            if (this->is_running())
+            {
+                return;
+            }
+
+            this->allocate_frame_pools();
+
+            this->running = true;
+
+            this->blocking_timeout_millis = this->tello_video_receiver.get_receive_timeout();
+            this->tello_video_receiver.set_receive_timeout(this->pipeline_settings.poll_timeout_millis);
+
+            this->receiver_thread = std::thread(&TelloVideoPipeline::receive_access_units, this);
+            this->decoder_thread = std::thread(&TelloVideoPipeline::decode_access_units, this);
+
+            for (std::unique_ptr<ConsumerStage> &consumer_stage : this->consumer_stages)
+            {
+                consumer_stage->consumer_thread = std::thread(&TelloVideoPipeline::consume_frames, this, consumer_stage.get());
+            }
+        }
+
+        void stop()
+        {
+            if (!this->running.exchange(false))
+            {
+                return;
+            }
+
+            this->decode_queue.close();
+
+            for (std::unique_ptr<ConsumerStage> &consumer_stage : this->consumer_stages)
+            {
+                consumer_stage->frame_queue.close();
+            }
+
+            this->receiver_thread.join();
+            this->decoder_thread.join();
+
+            for (std::unique_ptr<ConsumerStage> &consumer_stage : this->consumer_stages)
+            {
+                consumer_stage->consumer_thread.join();
+                consumer_stage->frame_queue.clear();
+            }
+
+            this->decode_queue.clear();
+            this->tello_video_receiver.set_receive_timeout(this->blocking_timeout_millis);
+        }
+
+        bool is_running() const
+        {
+            return this->running.load(std::memory_order_relaxed);
+        }
+
+        TelloVideoPipelineStatistics get_statistics() const
+        {
+            TelloVideoPipelineStatistics pipeline_statistics
+            {
+                this->received_access_units.load(std::memory_order_relaxed),
+                this->malformed_access_units.load(std::memory_order_relaxed),
+                this->exhausted_frame_pool_drops.load(std::memory_order_relaxed),
+                this->decode_queue.get_dropped_count(),
+                this->rejected_by_decoder.load(std::memory_order_relaxed),
+                0,
+                0
+            };
+
+            for (const std::unique_ptr<ConsumerStage> &consumer_stage : this->consumer_stages)
+            {
+                pipeline_statistics.consumer_queue_drops += consumer_stage->frame_queue.get_dropped_count();
+                pipeline_statistics.consumed_frames += consumer_stage->consumed_frames.load(std::memory_order_relaxed);
+            }
+
+            return pipeline_statistics;
+        }
+
+        ~TelloVideoPipeline()
+        {
+            try
+            {
+                this->stop();
+            }
+            catch(...)
+            {
+
+            }
+        }
+
+    private:
+        struct ConsumerStage
+        {
+            ConsumerStage(const VideoConsumer &video_consumer, const std::size_t &queue_capacity) :
+            video_consumer{video_consumer},
+            frame_queue{queue_capacity}
+            {}
+
+            VideoConsumer video_consumer;
+            DropOldestQueue<FrameHandle> frame_queue;
+            std::thread consumer_thread;
+            std::atomic<std::uint64_t> consumed_frames{0};
+        };
+
+        static void resize_frame_pool(std::unique_ptr<FramePool> &frame_pool, const std::size_t &frame_count, const std::size_t &frame_capacity)
+        {
+            if (frame_pool && frame_pool->get_frame_count() == frame_count && frame_pool->get_frame_capacity() == frame_capacity)
+            {
+                return;
+            }
+
+            if (frame_pool && frame_pool->get_free_frame_count() != frame_pool->get_frame_count())
+            {
+                throw std::runtime_error("Sorry, you're still holding video frames from the last time the video pipeline ran.");
+            }
+
+            frame_pool = std::make_unique<FramePool>(frame_count, frame_capacity);
+        }
+
+        void allocate_frame_pools()
+        {
+            std::size_t consumer_frame_count = this->consumer_stages.size() * (this->pipeline_settings.consumer_queue_capacity + 1);
+
+            resize_frame_pool(this->access_unit_pool, this->pipeline_settings.decode_queue_capacity + consumer_frame_count + 2, this->pipeline_settings.max_access_unit_size);
+
+            if (this->video_decoder)
+            {
+                resize_frame_pool(this->decoded_frame_pool, consumer_frame_count + 1, this->pipeline_settings.max_decoded_frame_size);
+            }
+
+            if (!this->discard_buffer)
+            {
+                this->discard_buffer = std::make_unique<std::byte[]>(this->pipeline_settings.max_access_unit_size);
+            }
+        }
+
+        void receive_access_units()
+        {
+            std::uint64_t sequence_number = 0;
+
+            while (this->running.load(std::memory_order_relaxed))
+            {
+                FrameHandle access_unit = this->access_unit_pool->try_acquire();
+
+                try
+                {
+                    if (!access_unit)
+                    {
+                        this->tello_video_assembler.receive_access_unit_into(std::span<std::byte>(this->discard_buffer.get(), this->pipeline_settings.max_access_unit_size));
+                        this->exhausted_frame_pool_drops.fetch_add(1, std::memory_order_relaxed);
+                        continue;
+                    }
+
+                    access_unit->size = this->tello_video_assembler.receive_access_unit_into(std::span<std::byte>(access_unit->data, access_unit->capacity));
+                }
+                catch(const std::runtime_error&)
+                {
+                    continue;
+                }
+
+                access_unit->sequence_number = sequence_number++;
+                access_unit->received_at = std::chrono::steady_clock::now();
+
+                this->received_access_units.fetch_add(1, std::memory_order_relaxed);
+                this->malformed_access_units.store(this->tello_video_assembler.get_dropped_access_unit_count(), std::memory_order_relaxed);
+
+                this->decode_queue.push(std::move(access_unit));
+            }
+        }
+
+        void decode_access_units()
+        {
+            FrameHandle access_unit;
+            std::chrono::milliseconds poll_timeout(this->pipeline_settings.poll_timeout_millis);
+
+            while (this->running.load(std::memory_order_relaxed))
+            {
+                if (!this->decode_queue.pop(access_unit, poll_timeout))
+                {
+                    continue;
+                }
+
+                FrameHandle video_frame = std::move(access_unit);
+
+                if (this->video_decoder)
+                {
+                    FrameHandle decoded_frame = this->decoded_frame_pool->try_acquire();
+
+                    if (!decoded_frame)
+                    {
+                        this->exhausted_frame_pool_drops.fetch_add(1, std::memory_order_relaxed);
+                        continue;
+                    }
+
+                    decoded_frame->sequence_number = video_frame->sequence_number;
+                    decoded_frame->received_at = video_frame->received_at;
+
+                    try
+                    {
+                        if (!this->video_decoder(*video_frame, *decoded_frame))
+                        {
+                            this->rejected_by_decoder.fetch_add(1, std::memory_order_relaxed);
+                            continue;
+                        }
+                    }
+                    catch(const std::exception&)
+                    {
+                        this->rejected_by_decoder.fetch_add(1, std::memory_order_relaxed);
+                        continue;
+                    }
+
+                    video_frame = std::move(decoded_frame);
+                }
+
+                for (std::unique_ptr<ConsumerStage> &consumer_stage : this->consumer_stages)
+                {
+                    consumer_stage->frame_queue.push(video_frame);
+                }
+            }
+        }
+
+        void consume_frames(ConsumerStage *consumer_stage)
+        {
+            FrameHandle video_frame;
+            std::chrono::milliseconds poll_timeout(this->pipeline_settings.poll_timeout_millis);
+
+            while (this->running.load(std::memory_order_relaxed))
+            {
+                if (!consumer_stage->frame_queue.pop(video_frame, poll_timeout))
+                {
+                    continue;
+                }
+
+                try
+                {
+                    consumer_stage->video_consumer(video_frame);
+                }
+                catch(const std::exception&)
+                {
+
+                }
+
+                video_frame.reset();
+                consumer_stage->consumed_frames.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        TelloSocket &tello_video_receiver;
+        TelloVideoReceiver tello_video_assembler;
+        TelloVideoPipelineSettings pipeline_settings;
+        int blocking_timeout_millis = 0;
+
+        VideoDecoder video_decoder;
+        std::vector<std::unique_ptr<ConsumerStage>> consumer_stages;
+
+        std::unique_ptr<FramePool> access_unit_pool;
+        std::unique_ptr<FramePool> decoded_frame_pool;
+        std::unique_ptr<std::byte[]> discard_buffer;
+        DropOldestQueue<FrameHandle> decode_queue;
+
+        std::atomic<bool> running{false};
+        std::thread receiver_thread;
+        std::thread decoder_thread;
+
+        std::atomic<std::uint64_t> received_access_units{0};
+        std::atomic<std::uint64_t> malformed_access_units{0};
+        std::atomic<std::uint64_t> exhausted_frame_pool_drops{0};
+        std::atomic<std::uint64_t> rejected_by_decoder{0};
+};
\ No newline at end of file
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+
+#include "tello_socket.h"
+
+class TelloVideoReceiver
+{
+    public:
+        static constexpr int tello_video_fragment_size = 1460;
+        static constexpr int max_video_datagram_size = 2048;
+
+        TelloVideoReceiver(TelloSocket &tello_video_receiver, const std::size_t &slab_count = 4, const std::size_t &slab_size = 512 * 1024) :
+        tello_video_receiver{tello_video_receiver},
+        slab_count{slab_count},
+        slab_size{slab_size}
+        {
+            if (slab_count < 2 || slab_size < max_video_datagram_size)
+            {
+                throw std::invalid_argument("Sorry, your video receiver needs at least two slabs that can each hold a whole datagram.");
+            }
+        }
+
+        TelloVideoReceiver(TelloVideoReceiver const&) = delete;
+        void operator = (TelloVideoReceiver const&) = delete;
+
+        std::span<const std::byte> receive_access_unit()
+        {
+            if (!this->slabs)
+            {
+                this->slabs = std::make_unique<std::byte[]>(this->slab_count * this->slab_size);
+            }
+
+            std::byte *slab = this->slabs.get() + (this->current_slab * this->slab_size);
+            std::size_t access_unit_size = this->receive_access_unit_into(std::span<std::byte>(slab, this->slab_size));
+
+            this->current_slab = (this->current_slab + 1) % this->slab_count;
+
+            return std::span<const std::byte>(slab, access_unit_size);
+        }
+
+        std::size_t receive_access_unit_into(std::span<std::byte> access_unit)
+        {
+            std::size_t access_unit_size = 0;
+            bool discarding = false;
+
+            while (true)
+            {
+                if (access_unit.size() - access_unit_size < max_video_datagram_size)
+                {
+                    this->dropped_access_units++;
+                    access_unit_size = 0;
+                    discarding = true;
+                }
+
+                std::byte *fragment = access_unit.data() + access_unit_size;
+                int fragment_size = this->tello_video_receiver.receive_into(reinterpret_cast<char*>(fragment), max_video_datagram_size);
+
+                if (fragment_size < 0)
+                {
+                    if (access_unit_size > 0)
+                    {
+                        this->dropped_access_units++;
+                    }
+
+                    throw std::runtime_error("Sorry, your Tello didn't send us any video in time.");
+                }
+
+                bool last_fragment = fragment_size != tello_video_fragment_size;
+
+                if (discarding)
+                {
+                    discarding = !last_fragment;
+                    continue;
+                }
+
+                if (access_unit_size == 0 && !has_start_code(fragment, fragment_size))
+                {
+                    this->dropped_access_units++;
+                    discarding = !last_fragment;
+                    continue;
+                }
+
+                access_unit_size += fragment_size;
+
+                if (last_fragment)
+                {
+                    return access_unit_size;
+                }
+            }
+        }
+
+        std::uint64_t get_dropped_access_unit_count() const
+        {
+            return this->dropped_access_units;
+        }
+
+    private:
+        static bool has_start_code(const std::byte *fragment, const int &fragment_size)
+        {
+            if (fragment_size >= 4 && fragment[0] == std::byte{0} && fragment[1] == std::byte{0} && fragment[2] == std::byte{0} && fragment[3] == std::byte{1})
+            {
+                return true;
+            }
+
+            return fragment_size >= 3 && fragment[0] == std::byte{0} && fragment[1] == std::byte{0} && fragment[2] == std::byte{1};
+        }
+
+        TelloSocket &tello_video_receiver;
+        std::size_t slab_count;
+        std::size_t slab_size;
+
+        std::unique_ptr<std::byte[]> slabs;
+        std::size_t current_slab = 0;
+        std::uint64_t dropped_access_units = 0;
+};
\ No newline at end of file
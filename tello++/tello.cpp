@@ -0,0 +1,1253 @@
+#include "tello.h"
+
+#include "modules/tello_command_pipeline.h"
+#include "modules/tello_endpoint_manager.h"
+#include "modules/tello_flight_recorder.h"
+#include "modules/tello_logger.h"
+#include "modules/tello_mission_executor.h"
+#include "modules/tello_packet_capture.h"
+#include "modules/tello_reliable_commands.h"
+#include "modules/tello_remote_control_stream.h"
+#include "modules/tello_socket.h"
+#include "modules/tello_state_stream.h"
+#include "modules/internals/seqlock.h"
+#include "modules/tello_video_pipeline.h"
+#include "modules/tello_video_receiver.h"
+
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+struct Tello::TelloModules
+{
+    TelloModules
+    (
+    bool &tello_logging,
+    const int &tello_response_timeout_secs,
+    const std::string &tello_ip,
+    const int &tello_port,
+    const std::string &tello_client_ip,
+    const int &tello_client_port,
+    const std::string &tello_state_receiver_ip,
+    const int &tello_state_receiver_port,
+    const std::string &tello_video_receiver_ip,
+    const int &tello_video_receiver_port
+    ): 
+    tello_endpoint{tello_ip, tello_port, tello_client_ip, tello_client_port, tello_state_receiver_ip, tello_state_receiver_port, tello_video_receiver_ip, tello_video_receiver_port},
+    tello_logger{TelloLogger(tello_logging)},
+    tello_client{TelloSocket(tello_logger, tello_response_timeout_secs, tello_ip, tello_port, tello_client_ip, tello_client_port)},
+    tello_state_receiver{tello_state_receiver_port == TelloEndpoint::no_receiver ? nullptr : std::make_unique<TelloSocket>(tello_logger, tello_response_timeout_secs, tello_ip, tello_port, tello_state_receiver_ip, tello_state_receiver_port)},
+    tello_video_receiver{TelloSocket(tello_logger, tello_response_timeout_secs, tello_ip, tello_port, tello_video_receiver_ip, tello_video_receiver_port)},
+    tello_state_stream{make_tello_state_stream(tello_state_receiver.get(), tello_response_timeout_secs)},
+    tello_command_pipeline{tello_client},
+    tello_video_assembler{tello_video_receiver},
+    tello_video_pipeline{tello_video_receiver},
+    tello_remote_control_stream{tello_client}
+    {
+        this->tello_command_pipeline.set_command_metrics(&this->tello_command_metrics);
+
+        this->tello_client.set_packet_capture(&this->tello_packet_capture, TelloPacketChannel::command);
+        this->tello_video_receiver.set_packet_capture(&this->tello_packet_capture, TelloPacketChannel::video);
+
+        if (this->tello_state_receiver)
+        {
+            this->tello_state_receiver->set_packet_capture(&this->tello_packet_capture, TelloPacketChannel::state);
+        }
+    }
+
+    TelloModules(bool &tello_logging, const int &tello_response_timeout_secs, TelloEndpointLease &&tello_endpoint_lease): 
+    TelloModules
+    (
+    tello_logging,
+    tello_response_timeout_secs,
+    tello_endpoint_lease.get_endpoint().tello_ip,
+    tello_endpoint_lease.get_endpoint().tello_port,
+    tello_endpoint_lease.get_endpoint().tello_client_ip,
+    tello_endpoint_lease.get_endpoint().tello_client_port,
+    tello_endpoint_lease.get_endpoint().tello_state_receiver_ip,
+    tello_endpoint_lease.get_endpoint().tello_state_receiver_port,
+    tello_endpoint_lease.get_endpoint().tello_video_receiver_ip,
+    tello_endpoint_lease.get_endpoint().tello_video_receiver_port
+    )
+    {
+        this->tello_endpoint_lease = std::move(tello_endpoint_lease);
+    }
+
+    static std::unique_ptr<TelloModules> lease(bool &tello_logging, const int &tello_response_timeout_secs, TelloEndpointManager &endpoint_manager, const std::string &tello_ip)
+    {
+        constexpr int max_lease_attempts = 8;
+
+        for (int lease_attempt = 1;; lease_attempt++)
+        {
+            try
+            {
+                return std::make_unique<TelloModules>(tello_logging, tello_response_timeout_secs, endpoint_manager.lease_endpoint(tello_ip));
+            }
+            catch(const std::runtime_error&)
+            {
+                if (lease_attempt >= max_lease_attempts)
+                {
+                    throw;
+                }
+            }
+        }
+    }
+
+    static TelloStateStream make_tello_state_stream(TelloSocket *tello_state_receiver, const int &tello_response_timeout_secs)
+    {
+        if (tello_state_receiver)
+        {
+            return TelloStateStream(*tello_state_receiver);
+        }
+
+        return TelloStateStream(tello_response_timeout_secs * 1000);
+    }
+
+    TelloEndpoint tello_endpoint;
+    TelloLogger tello_logger;
+    TelloPacketCapture tello_packet_capture;
+    TelloSocket tello_client;
+    std::unique_ptr<TelloSocket> tello_state_receiver;
+    TelloSocket tello_video_receiver;
+    std::mutex flight_recorder_mutex;
+    std::unique_ptr<TelloFlightRecorder> tello_flight_recorder;
+    TelloCommandMetrics tello_command_metrics;
+    TelloStateStream tello_state_stream;
+    TelloCommandPipeline tello_command_pipeline;
+    TelloVideoReceiver tello_video_assembler;
+    TelloVideoPipeline tello_video_pipeline;
+    TelloRemoteControlStream tello_remote_control_stream;
+    std::mutex mission_mutex;
+    std::shared_ptr<TelloMissionExecutor> mission_executor;
+    std::future<void> mission_future;
+    std::mutex state_estimator_mutex;
+    TelloStateEstimator tello_state_estimator;
+    SeqLock<TelloStateEstimator> published_tello_state_estimator;
+    TelloEndpointLease tello_endpoint_lease;
+};
+
+Tello::Tello
+(
+const bool &tello_logging,
+const bool &land_on_exit, 
+const int &tello_response_timeout_secs,
+const std::string &tello_ip, 
+const int &tello_port,
+const std::string &tello_client_ip, 
+const int &tello_client_port,
+const std::string &tello_state_receiver_ip, 
+const int &tello_state_receiver_port,
+const std::string &tello_video_receiver_ip,
+const int &tello_video_receiver_port,
+const TelloConnectMode &connect_mode
+): 
+land_on_exit{land_on_exit},
+tello_logging{tello_logging},
+tello_modules{std::make_unique<TelloModules>(this->tello_logging, tello_response_timeout_secs, tello_ip, tello_port, tello_client_ip, tello_client_port, tello_state_receiver_ip, tello_state_receiver_port, tello_video_receiver_ip, tello_video_receiver_port)}
+{
+    this->initialize_tello(connect_mode);
+}
+
+Tello::Tello
+(
+const TelloEndpoint &tello_endpoint,
+const bool &tello_logging,
+const bool &land_on_exit, 
+const int &tello_response_timeout_secs,
+const TelloConnectMode &connect_mode
+): 
+Tello
+(
+tello_logging, 
+land_on_exit, 
+tello_response_timeout_secs, 
+tello_endpoint.tello_ip, 
+tello_endpoint.tello_port, 
+tello_endpoint.tello_client_ip, 
+tello_endpoint.tello_client_port, 
+tello_endpoint.tello_state_receiver_ip, 
+tello_endpoint.tello_state_receiver_port, 
+tello_endpoint.tello_video_receiver_ip, 
+tello_endpoint.tello_video_receiver_port,
+connect_mode
+) 
+{}
+
+Tello::Tello
+(
+TelloEndpointManager &endpoint_manager,
+const std::string &tello_ip,
+const bool &tello_logging,
+const bool &land_on_exit, 
+const int &tello_response_timeout_secs,
+const TelloConnectMode &connect_mode
+): 
+land_on_exit{land_on_exit},
+tello_logging{tello_logging},
+tello_modules{TelloModules::lease(this->tello_logging, tello_response_timeout_secs, endpoint_manager, tello_ip)}
+{
+    this->initialize_tello(connect_mode);
+}
+
+const TelloEndpoint &Tello::get_endpoint() const
+{
+    return this->tello_modules->tello_endpoint;
+}
+
+bool Tello::connect(const std::chrono::milliseconds &timeout)
+{
+    Tello *tello = this;
+    return connect_all(std::span<Tello* const>(&tello, 1), timeout).all_responded();
+}
+
+bool Tello::is_connected() const
+{
+    return this->connected.load(std::memory_order_acquire);
+}
+
+TelloHandshakeReport Tello::connect_all(std::span<Tello* const> tellos, const std::chrono::milliseconds &timeout)
+{
+    TelloHandshakeReport handshake_report = exchange_with_all(tellos, TelloCommands::Command::command_name, timeout);
+
+    for (std::size_t tello_index : handshake_report.responsive_tellos) 
+    {
+        tellos[tello_index]->connected.store(true, std::memory_order_release);
+    }
+
+    return handshake_report;
+}
+
+TelloHandshakeReport Tello::land_all(std::span<Tello* const> tellos, const std::chrono::milliseconds &timeout)
+{
+    TelloHandshakeReport handshake_report = exchange_with_all(tellos, TelloCommands::Land::command_name, timeout);
+
+    for (std::size_t tello_index : handshake_report.responsive_tellos) 
+    {
+        tellos[tello_index]->may_be_flying.store(false, std::memory_order_relaxed);
+    }
+
+    return handshake_report;
+}
+
+void Tello::set_land_on_exit_timeout(const std::chrono::milliseconds &land_on_exit_timeout)
+{
+    this->land_on_exit_timeout = land_on_exit_timeout;
+}
+
+std::string Tello::takeoff()
+{
+    return  this->send_command(TelloCommands::Takeoff::command_name);
+}
+
+std::string Tello::land()
+{
+    std::string response = this->send_command(TelloCommands::Land::command_name);
+
+    if (response == "ok") 
+    {
+        this->may_be_flying.store(false, std::memory_order_relaxed);
+    }
+
+    return response;
+}
+
+std::string Tello::emergency_shutdown()
+{
+    std::string response = this->send_command(TelloCommands::Emergency::command_name);
+
+    if (response == "ok") 
+    {
+        this->may_be_flying.store(false, std::memory_order_relaxed);
+    }
+
+    return response;
+}
+
+std::string Tello::fly_forward(const int &forward_cm)
+{
+    return this->send_command(TelloCommands::Forward::encode(forward_cm));
+}
+
+std::string Tello::fly_backward(const int &backward_cm)
+{
+    return this->send_command(TelloCommands::Back::encode(backward_cm));
+}
+
+std::string Tello::fly_up(const int &up_cm)
+{
+    return this->send_command(TelloCommands::Up::encode(up_cm));
+}
+
+std::string Tello::fly_down(const int &down_cm)
+{
+    return this->send_command(TelloCommands::Down::encode(down_cm));
+}
+
+std::string Tello::fly_left(const int &left_cm)
+{
+    return this->send_command(TelloCommands::Left::encode(left_cm));
+}
+
+std::string Tello::fly_right(const int &right_cm)
+{
+    return this->send_command(TelloCommands::Right::encode(right_cm));
+}
+
+std::string Tello::rotate_clockwise(const int &angle)
+{
+    return this->send_command(TelloCommands::Clockwise::encode(angle));
+}
+
+std::string Tello::rotate_counterclockwise(const int &angle)
+{
+    return this->send_command(TelloCommands::Counterclockwise::encode(angle));
+}
+
+std::string Tello::front_flip()
+{
+    return this->send_command(TelloCommands::FlipFront::command_name);
+}
+
+std::string Tello::back_flip()
+{
+    return this->send_command(TelloCommands::FlipBack::command_name);
+}
+
+std::string Tello::left_flip()
+{
+    return this->send_command(TelloCommands::FlipLeft::command_name);
+}
+
+std::string Tello::right_flip()
+{
+    return this->send_command(TelloCommands::FlipRight::command_name);
+}
+
+std::string Tello::fly_to_position(const int &x_position, const int &y_position, const int &z_position, const int &speed_cm_per_sec)
+{
+    return this->send_command(TelloCommands::Go::encode(x_position, y_position, z_position, speed_cm_per_sec));
+}
+
+std::string Tello::fly_to_position(const int &x1_position, const int &y1_position, const int &z1_position, int x2_position, const int &y2_position, const int &z2_position, const int &speed_cm_per_sec)
+{
+    return this->send_command(TelloCommands::Curve::encode(x1_position, y1_position, z1_position, x2_position, y2_position, z2_position, speed_cm_per_sec));
+}
+
+std::string Tello::set_speed(const int &speed_cm_per_sec)
+{
+    return this->send_command(TelloCommands::Speed::encode(speed_cm_per_sec));
+}
+
+void Tello::set_remote_control(const int &roll, const int &pitch, const int &up_down, const int &yaw)
+{
+    if (this->tello_modules->tello_remote_control_stream.is_running()) 
+    {
+        this->tello_modules->tello_remote_control_stream.set_sticks(roll, pitch, up_down, yaw);
+        return;
+    }
+
+    this->may_be_flying.store(true, std::memory_order_relaxed);
+
+    this->tello_modules->tello_command_metrics.record_sent(TelloCommands::RemoteControl::command_name);
+    this->tello_modules->tello_client.send_data(TelloCommands::RemoteControl::encode(roll, pitch, up_down, yaw));
+}
+
+void Tello::start_remote_control_stream(const int &send_rate_hz)
+{
+    this->may_be_flying.store(true, std::memory_order_relaxed);
+    this->tello_modules->tello_remote_control_stream.set_send_rate(send_rate_hz);
+    this->tello_modules->tello_remote_control_stream.start();
+}
+
+void Tello::stop_remote_control_stream()
+{
+    this->tello_modules->tello_remote_control_stream.stop();
+}
+
+RemoteControlJitter Tello::get_remote_control_jitter() const
+{
+    return this->tello_modules->tello_remote_control_stream.get_jitter();
+}
+
+std::string Tello::change_tello_wifi_info(const std::string &new_tello_wifi_name, const std::string &new_tello_wifi_password)
+{
+    return this->send_command(format_string("wifi %s %s", new_tello_wifi_name.c_str(), new_tello_wifi_password.c_str()));
+}
+
+void Tello::start_command_pipeline()
+{
+    this->tello_modules->tello_command_pipeline.start();
+}
+
+void Tello::stop_command_pipeline()
+{
+    this->tello_modules->tello_command_pipeline.stop();
+}
+
+bool Tello::is_command_pipelining() const
+{
+    return this->tello_modules->tello_command_pipeline.is_running();
+}
+
+std::future<std::string> Tello::send_command_async(std::string_view to_send, const std::chrono::milliseconds &response_timeout)
+{
+    this->track_flight(to_send);
+    this->tello_modules->tello_command_pipeline.start();
+    return this->tello_modules->tello_command_pipeline.send_command(to_send, response_timeout);
+}
+
+std::future<std::string> Tello::send_command_async(std::string_view to_send)
+{
+    this->track_flight(to_send);
+    this->tello_modules->tello_command_pipeline.start();
+    return this->tello_modules->tello_command_pipeline.send_command(to_send, std::chrono::milliseconds(this->tello_modules->tello_command_pipeline.get_default_response_timeout()));
+}
+
+std::future<MissionResult> Tello::run_mission(const MissionPlan &mission_plan, const MissionRetryPolicy &retry_policy)
+{
+    mission_plan.validate();
+
+    std::lock_guard<std::mutex> mission_lock(this->tello_modules->mission_mutex);
+
+    if (this->tello_modules->mission_future.valid() && this->tello_modules->mission_future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) 
+    {
+        throw std::runtime_error("Sorry, your Tello is already running a mission.");
+    }
+
+    const MissionPreconditions &mission_preconditions = mission_plan.get_mission_preconditions();
+
+    if (mission_preconditions.minimum_battery > 0 || mission_preconditions.minimum_height_cm > 0 || mission_preconditions.maximum_height_cm > 0 || retry_policy.max_timeout_retries > 0) 
+    {
+        this->tello_modules->tello_state_stream.start();
+    }
+
+    this->tello_modules->tello_command_pipeline.start();
+
+    this->may_be_flying.store(true, std::memory_order_relaxed);
+
+    std::shared_ptr<TelloMissionExecutor> mission_executor = std::make_shared<TelloMissionExecutor>(this->tello_modules->tello_command_pipeline, &this->tello_modules->tello_state_stream, retry_policy);
+    std::shared_ptr<std::promise<MissionResult>> mission_result = std::make_shared<std::promise<MissionResult>>();
+
+    this->tello_modules->mission_executor = mission_executor;
+    this->tello_modules->mission_future = std::async
+    (
+            std::launch::async, 
+            [mission_executor, mission_plan, mission_result]() 
+            {
+                    try
+                    {
+                            mission_result->set_value(mission_executor->run(mission_plan));
+                    }
+                    catch(...)
+                    {
+                            mission_result->set_exception(std::current_exception());
+                    }
+            }
+    );
+
+    return mission_result->get_future();
+}
+
+void Tello::cancel_mission()
+{
+    std::lock_guard<std::mutex> mission_lock(this->tello_modules->mission_mutex);
+
+    if (this->tello_modules->mission_executor) 
+    {
+        this->tello_modules->mission_executor->cancel();
+    }
+}
+
+void Tello::start_reliable_commands(const int &max_query_retransmissions, const int &max_motion_retransmissions)
+{
+    this->max_query_retransmissions = max_query_retransmissions;
+    this->max_motion_retransmissions = max_motion_retransmissions;
+    this->tello_modules->tello_state_stream.start();
+    this->tello_modules->tello_command_pipeline.start();
+    this->sending_reliable_commands.store(true, std::memory_order_release);
+}
+
+void Tello::stop_reliable_commands()
+{
+    this->sending_reliable_commands.store(false, std::memory_order_release);
+}
+
+bool Tello::is_sending_reliable_commands() const
+{
+    return this->sending_reliable_commands.load(std::memory_order_acquire);
+}
+
+const TelloRttEstimator &Tello::get_rtt_estimator() const
+{
+    return this->tello_modules->tello_command_pipeline.get_rtt_estimator();
+}
+
+std::uint64_t Tello::get_command_retransmission_count() const
+{
+    return this->tello_modules->tello_command_pipeline.get_retransmission_count() + this->motion_retransmissions.load(std::memory_order_relaxed);
+}
+
+std::uint64_t Tello::get_telemetry_confirmed_motion_count() const
+{
+    return this->telemetry_confirmed_motions.load(std::memory_order_relaxed);
+}
+
+const TelloCommandMetrics &Tello::get_command_metrics() const
+{
+    return this->tello_modules->tello_command_metrics;
+}
+
+void Tello::write_log(const std::string &log_location) const
+{
+    this->tello_modules->tello_logger.write_log(log_location);
+}
+
+void Tello::start_flight_recording(const std::string &recording_location)
+{
+    std::lock_guard<std::mutex> flight_recorder_lock(this->tello_modules->flight_recorder_mutex);
+    this->tello_modules->tello_flight_recorder = std::make_unique<TelloFlightRecorder>(recording_location);
+}
+
+void Tello::stop_flight_recording()
+{
+    std::lock_guard<std::mutex> flight_recorder_lock(this->tello_modules->flight_recorder_mutex);
+    this->tello_modules->tello_flight_recorder.reset();
+}
+
+void Tello::start_packet_capture(const std::string &capture_location)
+{
+    this->tello_modules->tello_packet_capture.open(capture_location);
+}
+
+void Tello::stop_packet_capture()
+{
+    this->tello_modules->tello_packet_capture.close();
+}
+
+bool Tello::is_capturing_packets() const
+{
+    return this->tello_modules->tello_packet_capture.is_open();
+}
+
+void Tello::start_tello_state_stream()
+{
+    this->tello_modules->tello_state_stream.start();
+}
+
+void Tello::stop_tello_state_stream()
+{
+    this->tello_modules->tello_state_stream.stop();
+}
+
+bool Tello::is_tello_state_streaming() const
+{
+    return this->tello_modules->tello_state_stream.is_running();
+}
+
+void Tello::start_state_estimation(const TelloStateEstimatorSettings &estimator_settings)
+{
+    {
+        std::lock_guard<std::mutex> state_estimator_lock(this->tello_modules->state_estimator_mutex);
+
+        this->tello_modules->tello_state_estimator = TelloStateEstimator(estimator_settings);
+        this->tello_modules->published_tello_state_estimator.store(this->tello_modules->tello_state_estimator);
+    }
+
+    this->estimating_state.store(true, std::memory_order_release);
+    this->tello_modules->tello_state_stream.start();
+}
+
+void Tello::stop_state_estimation()
+{
+    this->estimating_state.store(false, std::memory_order_release);
+}
+
+bool Tello::is_estimating_state() const
+{
+    return this->estimating_state.load(std::memory_order_acquire);
+}
+
+TelloPose Tello::get_estimated_pose(const std::chrono::steady_clock::time_point &at) const
+{
+    TelloStateEstimator tello_state_estimator;
+
+    if (!this->tello_modules->published_tello_state_estimator.load(tello_state_estimator) || !tello_state_estimator.has_estimate()) 
+    {
+        throw std::runtime_error("Sorry, we haven't estimated your Tello's pose yet. Did you start state estimation?");
+    }
+
+    return tello_state_estimator.get_pose(at);
+}
+
+TelloPose Tello::get_estimated_pose() const
+{
+    return this->get_estimated_pose(std::chrono::steady_clock::now());
+}
+
+void Tello::start_cached_queries(const std::chrono::milliseconds &max_tello_state_age)
+{
+    this->max_cached_tello_state_age = max_tello_state_age;
+    this->tello_modules->tello_state_stream.start();
+    this->serving_cached_queries = true;
+}
+
+void Tello::stop_cached_queries()
+{
+    this->serving_cached_queries = false;
+}
+
+bool Tello::is_serving_cached_queries() const
+{
+    return this->serving_cached_queries;
+}
+
+std::uint64_t Tello::get_cached_query_hit_count() const
+{
+    return this->cached_query_hits.load(std::memory_order_relaxed);
+}
+
+std::uint64_t Tello::get_cached_query_miss_count() const
+{
+    return this->cached_query_misses.load(std::memory_order_relaxed);
+}
+
+TelloState Tello::get_tello_state()
+{
+    if (this->tello_modules->tello_state_stream.is_running() || !this->tello_modules->tello_state_receiver) 
+    {
+        return this->tello_modules->tello_state_stream.get_tello_state();
+    }
+
+    TelloState tello_state = parse_tello_state(this->tello_modules->tello_state_receiver->receive_data_view());
+    this->record_tello_state(tello_state);
+
+    return tello_state;
+}
+
+float Tello::get_speed()
+{
+    return stof(this->send_command(TelloCommands::SpeedQuery::command_name));
+}
+
+int Tello::get_battery()
+{
+    TelloState cached_tello_state;
+
+    if (this->try_get_cached_tello_state(cached_tello_state)) 
+    {
+        return cached_tello_state.battery;
+    }
+
+    return stoi(this->send_command(TelloCommands::BatteryQuery::command_name));
+}
+
+int Tello::get_flight_time()
+{
+    TelloState cached_tello_state;
+
+    if (this->try_get_cached_tello_state(cached_tello_state)) 
+    {
+        return cached_tello_state.flight_time;
+    }
+
+    int flight_time;
+
+    std::string flight_time_response = this->send_command(TelloCommands::TimeQuery::command_name);
+    std::string_view flight_time_units = parse_number_with_units(flight_time_response, flight_time);
+
+    this->tello_modules->tello_logger.log_event(TelloLogEvent::flight_time_units, flight_time_units);
+
+    return flight_time;
+}
+
+int Tello::get_height()
+{
+    TelloState cached_tello_state;
+
+    if (this->try_get_cached_tello_state(cached_tello_state)) 
+    {
+        return cached_tello_state.height / 10;
+    }
+
+    int height;
+
+    std::string height_response = this->send_command(TelloCommands::HeightQuery::command_name);
+    std::string_view height_units = parse_number_with_units(height_response, height);
+
+    this->tello_modules->tello_logger.log_event(TelloLogEvent::height_units, height_units);
+
+    return height;
+}
+
+float Tello::get_average_temprature()
+{
+    TelloState cached_tello_state;
+
+    if (this->try_get_cached_tello_state(cached_tello_state)) 
+    {
+        return cached_tello_state.average_temprature;
+    }
+
+    float low_temprature;
+    float high_temprature;
+
+    std::string temprature_response = this->send_command(TelloCommands::TempratureQuery::command_name);
+    std::string_view high_temprature_response = parse_number_with_units(temprature_response, low_temprature);
+
+    if (high_temprature_response.empty() || high_temprature_response.front() != '~') 
+    {
+        throw std::runtime_error(format_string("Sorry, we couldn't read a temprature range from '%s'.", temprature_response.c_str()));
+    }
+
+    std::string_view temprature_units = parse_number_with_units(high_temprature_response.substr(1), high_temprature);
+
+    this->tello_modules->tello_logger.log_event(TelloLogEvent::temprature_units, temprature_units);
+
+    return (low_temprature + high_temprature) / 2;
+}
+
+const IMUAttitude Tello::get_imu_attitude()
+{
+    TelloState cached_tello_state;
+
+    if (this->try_get_cached_tello_state(cached_tello_state)) 
+    {
+        return cached_tello_state.imu_attitude;
+    }
+
+    std::string imu_attitude_reponse = this->send_command(TelloCommands::AttitudeQuery::command_name);
+
+    this->tello_modules->tello_logger.log_data("Tello IMU Attitude Units: Pitch, Roll, Yaw");
+
+    return IMUAttitude{parse_keyed_number<int>(imu_attitude_reponse, "pitch"), parse_keyed_number<int>(imu_attitude_reponse, "roll"), parse_keyed_number<int>(imu_attitude_reponse, "yaw")};
+}
+
+float Tello::get_barometer_reading()
+{
+    TelloState cached_tello_state;
+
+    if (this->try_get_cached_tello_state(cached_tello_state)) 
+    {
+        return cached_tello_state.barometer_reading;
+    }
+
+    return std::stof(this->send_command(TelloCommands::BarometerQuery::command_name));
+}
+
+IMUAcceleration Tello::get_imu_acceleration()
+{
+    TelloState cached_tello_state;
+
+    if (this->try_get_cached_tello_state(cached_tello_state)) 
+    {
+        return cached_tello_state.imu_acceleration;
+    }
+
+    std::string imu_acceleration_reponse = this->send_command(TelloCommands::AccelerationQuery::command_name);
+
+    this->tello_modules->tello_logger.log_data("Tello IMU Acceleration Units: X Acceleration, Y Acceleration, Z Acceleration");
+
+    return IMUAcceleration{parse_keyed_number<float>(imu_acceleration_reponse, "agx"), parse_keyed_number<float>(imu_acceleration_reponse, "agy"), parse_keyed_number<float>(imu_acceleration_reponse, "agz")};
+}
+
+float Tello::get_distance_from_takeoff()
+{
+    TelloState cached_tello_state;
+
+    if (this->try_get_cached_tello_state(cached_tello_state)) 
+    {
+        return cached_tello_state.distance_from_takeoff * 10.0f;
+    }
+
+    float distance_from_takeoff;
+
+    std::string distance_from_takeoff_response = this->send_command(TelloCommands::DistanceFromTakeoffQuery::command_name);
+    std::string_view distance_from_takeoff_units = parse_number_with_units(distance_from_takeoff_response, distance_from_takeoff);
+
+    this->tello_modules->tello_logger.log_event(TelloLogEvent::distance_from_takeoff_units, distance_from_takeoff_units);
+
+    return distance_from_takeoff;
+}
+
+int Tello::get_wifi_snr()
+{
+    return std::stoi(this->send_command(TelloCommands::WifiQuery::command_name));
+}
+
+std::string Tello::get_video_frame(const int &buffer_size)
+{
+    std::string video_frame(buffer_size, '\0');
+
+    int video_frame_size = this->tello_modules->tello_video_receiver.receive_into(video_frame.data(), buffer_size);
+
+    if (video_frame_size < 0) 
+    {
+        throw std::runtime_error("Sorry, your Tello didn't send us any video in time.");
+    }
+
+    video_frame.resize(video_frame_size);
+
+    return video_frame;
+}
+
+std::span<const std::byte> Tello::get_video_access_unit()
+{
+    return this->tello_modules->tello_video_assembler.receive_access_unit();
+}
+
+void Tello::set_video_decoder(const VideoDecoder &video_decoder)
+{
+    this->tello_modules->tello_video_pipeline.set_video_decoder(video_decoder);
+}
+
+void Tello::add_video_consumer(const VideoConsumer &video_consumer)
+{
+    this->tello_modules->tello_video_pipeline.add_video_consumer(video_consumer);
+}
+
+void Tello::start_video_pipeline()
+{
+    this->tello_modules->tello_video_pipeline.start();
+}
+
+void Tello::stop_video_pipeline()
+{
+    this->tello_modules->tello_video_pipeline.stop();
+}
+
+bool Tello::is_video_pipelining() const
+{
+    return this->tello_modules->tello_video_pipeline.is_running();
+}
+
+TelloVideoPipelineStatistics Tello::get_video_pipeline_statistics() const
+{
+    return this->tello_modules->tello_video_pipeline.get_statistics();
+}
+
+Tello::~Tello() 
+{
+    this->cancel_mission();
+
+    if (this->tello_modules->mission_future.valid()) 
+    {
+        this->tello_modules->mission_future.wait();
+    }
+
+    try
+    {
+        if (this->land_on_exit && this->may_be_flying.load(std::memory_order_relaxed)) 
+        {
+            Tello *tello = this;
+            land_all(std::span<Tello* const>(&tello, 1), this->land_on_exit_timeout);
+        }
+    }
+    catch(...)
+    {
+
+    }
+}
+
+bool Tello::try_get_cached_tello_state(TelloState &cached_tello_state)
+{
+    if (!this->serving_cached_queries) 
+    {
+        return false;
+    }
+
+    if (this->try_get_fresh_tello_state(cached_tello_state)) 
+    {
+        this->cached_query_hits.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    this->cached_query_misses.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void Tello::initialize_tello(const TelloConnectMode &connect_mode)
+{
+    this->tello_modules->tello_state_stream.set_tello_state_listener
+    (
+        [this](const TelloStateSample &tello_state_sample) 
+        {
+            this->record_tello_state(tello_state_sample.tello_state);
+            this->estimate_tello_state(tello_state_sample.tello_state, tello_state_sample.received_at);
+        }
+    );
+
+    if (!this->tello_modules->tello_state_receiver) 
+    {
+        this->tello_modules->tello_state_stream.start();
+
+        if (this->tello_modules->tello_endpoint_lease.is_leased()) 
+        {
+            this->tello_modules->tello_endpoint_lease.subscribe_tello_state
+            (
+                [tello_modules = this->tello_modules.get()](const TelloStateSample &tello_state_sample) 
+                {
+                    tello_modules->tello_state_stream.publish_tello_state_sample(tello_state_sample);
+                }
+            );
+        }
+    }
+
+    if (connect_mode == TelloConnectMode::blocking) 
+    {
+        this->send_command(TelloCommands::Command::command_name);
+        this->connected.store(true, std::memory_order_release);
+    }
+}
+
+void Tello::track_flight(std::string_view to_send)
+{
+    if (!is_idempotent_tello_command(to_send)) 
+    {
+        this->may_be_flying.store(true, std::memory_order_relaxed);
+    }
+}
+
+void Tello::record_tello_state(const TelloState &tello_state)
+{
+    std::lock_guard<std::mutex> flight_recorder_lock(this->tello_modules->flight_recorder_mutex);
+
+    if (this->tello_modules->tello_flight_recorder) 
+    {
+        this->tello_modules->tello_flight_recorder->record(tello_state);
+    }
+}
+
+void Tello::estimate_tello_state(const TelloState &tello_state, const std::chrono::steady_clock::time_point &received_at)
+{
+    if (!this->estimating_state.load(std::memory_order_acquire)) 
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> state_estimator_lock(this->tello_modules->state_estimator_mutex);
+
+    this->tello_modules->tello_state_estimator.update(tello_state, received_at);
+    this->tello_modules->published_tello_state_estimator.store(this->tello_modules->tello_state_estimator);
+}
+
+bool Tello::try_get_fresh_tello_state(TelloState &fresh_tello_state)
+{
+    TelloStateSample tello_state_sample;
+
+    if (this->tello_modules->tello_state_stream.is_running() && this->tello_modules->tello_state_stream.try_get_tello_state_sample(tello_state_sample) && std::chrono::steady_clock::now() - tello_state_sample.received_at <= this->max_cached_tello_state_age) 
+    {
+        fresh_tello_state = tello_state_sample.tello_state;
+        return true;
+    }
+
+    return false;
+}
+
+bool Tello::wait_for_tello_state_since(const std::chrono::steady_clock::time_point &since, TelloState &tello_state)
+{
+    TelloStateSample tello_state_sample;
+    auto deadline = std::chrono::steady_clock::now() + this->max_cached_tello_state_age;
+
+    while (this->tello_modules->tello_state_stream.is_running()) 
+    {
+        if (this->tello_modules->tello_state_stream.try_get_tello_state_sample(tello_state_sample) && tello_state_sample.received_at > since) 
+        {
+            tello_state = tello_state_sample.tello_state;
+            return true;
+        }
+
+        if (std::chrono::steady_clock::now() > deadline) 
+        {
+            break;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    return false;
+}
+
+std::string Tello::send_reliable_command(std::string_view to_send)
+{
+    std::chrono::milliseconds response_timeout(this->tello_modules->tello_command_pipeline.get_default_response_timeout());
+
+    if (is_idempotent_tello_command(to_send)) 
+    {
+        return this->tello_modules->tello_command_pipeline.send_command(to_send, response_timeout, this->max_query_retransmissions).get();
+    }
+
+    TelloState tello_state_before;
+
+    if (!this->wait_for_tello_state_since(this->last_motion_finished_at, tello_state_before)) 
+    {
+        return this->tello_modules->tello_command_pipeline.send_command(to_send, response_timeout).get();
+    }
+
+    TelloMotionGuard motion_guard(to_send, tello_state_before);
+
+    try
+    {
+        std::string response = this->send_guarded_motion_command(to_send, motion_guard, response_timeout);
+        this->last_motion_finished_at = std::chrono::steady_clock::now();
+
+        return response;
+    }
+    catch(...)
+    {
+        this->last_motion_finished_at = std::chrono::steady_clock::now();
+        throw;
+    }
+}
+
+std::string Tello::send_guarded_motion_command(std::string_view to_send, const TelloMotionGuard &motion_guard, const std::chrono::milliseconds &response_timeout)
+{
+    for (int motion_retransmissions_left = this->max_motion_retransmissions;; motion_retransmissions_left--) 
+    {
+        try
+        {
+            return this->tello_modules->tello_command_pipeline.send_command(to_send, response_timeout).get();
+        }
+        catch(const std::runtime_error&)
+        {
+            TelloState tello_state_after;
+
+            if (!this->wait_for_tello_state_since(std::chrono::steady_clock::now(), tello_state_after)) 
+            {
+                throw;
+            }
+
+            MotionOutcome motion_outcome = motion_guard.evaluate(tello_state_after);
+
+            if (motion_outcome == MotionOutcome::taken_effect) 
+            {
+                this->telemetry_confirmed_motions.fetch_add(1, std::memory_order_relaxed);
+                return "ok";
+            }
+
+            if (motion_outcome != MotionOutcome::not_started || motion_retransmissions_left <= 0) 
+            {
+                throw;
+            }
+
+            this->motion_retransmissions.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+std::string Tello::send_command(std::string_view to_send)
+{
+    this->track_flight(to_send);
+
+    if (this->sending_reliable_commands.load(std::memory_order_acquire) && this->tello_modules->tello_command_pipeline.is_running()) 
+    {
+        return this->send_reliable_command(to_send);
+    }
+
+    if (this->tello_modules->tello_command_pipeline.is_running()) 
+    {
+        return this->send_command_async(to_send).get();
+    }
+
+    auto sent_at = this->tello_modules->tello_command_metrics.record_sent(to_send);
+
+    try
+    {
+        std::string response = this->tello_modules->tello_client.send_command(to_send);
+        this->tello_modules->tello_command_metrics.record_response(to_send, sent_at, response);
+
+        return response;
+    }
+    catch(const std::runtime_error&)
+    {
+        if (is_socket_would_block(get_last_socket_error())) 
+        {
+            this->tello_modules->tello_command_metrics.record_timeout(to_send);
+        }
+        else 
+        {
+            this->tello_modules->tello_command_metrics.record_error(to_send);
+        }
+
+        throw;
+    }
+}
+
+TelloHandshakeReport Tello::exchange_with_all(std::span<Tello* const> tellos, std::string_view to_send, const std::chrono::milliseconds &timeout)
+{
+    enum class HandshakeOutcome
+    {
+        pending,
+        responded,
+        failed
+    };
+
+    constexpr std::chrono::milliseconds retransmission_interval(250);
+
+    auto started_at = std::chrono::steady_clock::now();
+    auto deadline = started_at + timeout;
+    bool retransmitting = is_idempotent_tello_command(to_send);
+    int max_retransmissions = retransmitting ? std::max(static_cast<int>(timeout / retransmission_interval) - 1, 0) : 0;
+
+    std::vector<HandshakeOutcome> handshake_outcomes(tellos.size(), HandshakeOutcome::pending);
+    std::vector<std::chrono::steady_clock::time_point> sent_at(tellos.size());
+    std::vector<std::chrono::steady_clock::time_point> retransmit_at(tellos.size());
+    std::vector<std::future<std::string>> pipelined_responses(tellos.size());
+    std::vector<pollfd> watched_sockets;
+    std::vector<std::size_t> watched_tellos;
+
+    for (std::size_t tello_index = 0; tello_index < tellos.size(); tello_index++) 
+    {
+        TelloModules &tello_modules = *tellos[tello_index]->tello_modules;
+        tellos[tello_index]->track_flight(to_send);
+
+        if (tello_modules.tello_command_pipeline.is_running()) 
+        {
+            try
+            {
+                pipelined_responses[tello_index] = tello_modules.tello_command_pipeline.send_command(to_send, timeout, max_retransmissions);
+            }
+            catch(const std::runtime_error&)
+            {
+                handshake_outcomes[tello_index] = HandshakeOutcome::failed;
+            }
+
+            continue;
+        }
+
+        pollfd watched_socket{tello_modules.tello_client.get_native_socket(), POLLIN, 0};
+
+        try
+        {
+            while (poll_native_sockets(&watched_socket, 1, 0) > 0 && (watched_socket.revents & POLLIN)) 
+            {
+                tello_modules.tello_client.receive_data_view();
+            }
+
+            sent_at[tello_index] = tello_modules.tello_command_metrics.record_sent(to_send);
+            retransmit_at[tello_index] = sent_at[tello_index] + retransmission_interval;
+            tello_modules.tello_client.send_data(to_send);
+        }
+        catch(const std::runtime_error&)
+        {
+            tello_modules.tello_command_metrics.record_error(to_send);
+            handshake_outcomes[tello_index] = HandshakeOutcome::failed;
+            continue;
+        }
+
+        watched_sockets.push_back(pollfd{watched_socket.fd, POLLIN, 0});
+        watched_tellos.push_back(tello_index);
+    }
+
+    for (auto now = std::chrono::steady_clock::now(); now < deadline; now = std::chrono::steady_clock::now()) 
+    {
+        bool waiting = false;
+        auto wake_at = deadline;
+
+        for (std::size_t watch_index = 0; watch_index < watched_tellos.size(); watch_index++) 
+        {
+            std::size_t tello_index = watched_tellos[watch_index];
+
+            if (handshake_outcomes[tello_index] != HandshakeOutcome::pending) 
+            {
+                continue;
+            }
+
+            waiting = true;
+
+            if (!retransmitting) 
+            {
+                continue;
+            }
+
+            if (retransmit_at[tello_index] <= now) 
+            {
+                try
+                {
+                    tellos[tello_index]->tello_modules->tello_client.send_data(to_send);
+                }
+                catch(const std::runtime_error&)
+                {
+
+                }
+
+                retransmit_at[tello_index] = now + retransmission_interval;
+            }
+
+            wake_at = std::min(wake_at, retransmit_at[tello_index]);
+        }
+
+        if (!waiting) 
+        {
+            break;
+        }
+
+        int wait_millis = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(wake_at - now).count()) + 1;
+        int ready_count = poll_native_sockets(watched_sockets.data(), static_cast<unsigned long>(watched_sockets.size()), wait_millis);
+
+        if (ready_count <= 0) 
+        {
+            continue;
+        }
+
+        for (std::size_t watch_index = 0; watch_index < watched_tellos.size(); watch_index++) 
+        {
+            std::size_t tello_index = watched_tellos[watch_index];
+
+            if (!(watched_sockets[watch_index].revents & POLLIN) || handshake_outcomes[tello_index] != HandshakeOutcome::pending) 
+            {
+                continue;
+            }
+
+            TelloModules &tello_modules = *tellos[tello_index]->tello_modules;
+
+            try
+            {
+                std::string_view response = tello_modules.tello_client.receive_data_view();
+                tello_modules.tello_command_metrics.record_response(to_send, sent_at[tello_index], response);
+
+                handshake_outcomes[tello_index] = response == "ok" ? HandshakeOutcome::responded : HandshakeOutcome::failed;
+                watched_sockets[watch_index].events = 0;
+            }
+            catch(const std::runtime_error&)
+            {
+
+            }
+        }
+    }
+
+    TelloHandshakeReport handshake_report;
+
+    for (std::size_t tello_index = 0; tello_index < tellos.size(); tello_index++) 
+    {
+        if (pipelined_responses[tello_index].valid() && pipelined_responses[tello_index].wait_until(deadline) == std::future_status::ready) 
+        {
+            try
+            {
+                handshake_outcomes[tello_index] = pipelined_responses[tello_index].get() == "ok" ? HandshakeOutcome::responded : HandshakeOutcome::failed;
+            }
+            catch(const std::runtime_error&)
+            {
+                handshake_outcomes[tello_index] = HandshakeOutcome::failed;
+            }
+        }
+        else if (!pipelined_responses[tello_index].valid() && handshake_outcomes[tello_index] == HandshakeOutcome::pending) 
+        {
+            tellos[tello_index]->tello_modules->tello_command_metrics.record_timeout(to_send);
+        }
+
+        if (handshake_outcomes[tello_index] == HandshakeOutcome::responded) 
+        {
+            handshake_report.responsive_tellos.push_back(tello_index);
+        }
+        else 
+        {
+            handshake_report.unresponsive_tellos.push_back(tello_index);
+        }
+    }
+
+    handshake_report.elapsed = std::chrono::steady_clock::now() - started_at;
+
+    return handshake_report;
+}
\ No newline at end of file
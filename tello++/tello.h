@@ -1,46 +1,36 @@
 #pragma once
 
-#include "modules/internals/util.h"
-
-#include "modules/tello_socket.h"
-#include "modules/tello_logger.h"
+#include "modules/tello_command_metrics.h"
+#include "modules/tello_endpoint.h"
+#include "modules/tello_handshake.h"
+#include "modules/tello_mission_plan.h"
+#include "modules/tello_remote_control_jitter.h"
+#include "modules/tello_rtt_estimator.h"
+#include "modules/tello_state.h"
+#include "modules/tello_state_estimator.h"
+#include "modules/tello_video_frames.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class TelloEndpointManager;
+class TelloMotionGuard;
 
 class Tello 
 {
     public:
-        struct IMUAttitude 
-        {
-            int pitch;
-            int roll;
-            int yaw;
-        };
-
-        struct IMUAcceleration 
-        {
-            float x_acceleration;
-            float y_acceleration;
-            float z_acceleration;
-        };
-
-        struct IMUVelocity 
-        {
-            int x_velocity;
-            int y_velocity;
-            int z_velocity;
-        };
-
-        struct TelloState 
-        {
-            IMUAttitude imu_attitude;
-            IMUVelocity imu_velocity;
-            float average_temprature;
-            int distance_from_takeoff;
-            int height;
-            int battery;
-            float barometer_reading;
-            int flight_time;
-            IMUAcceleration imu_acceleration;
-        };
+        using IMUAttitude = ::IMUAttitude;
+        using IMUAcceleration = ::IMUAcceleration;
+        using IMUVelocity = ::IMUVelocity;
+        using TelloState = ::TelloState;
 
         bool land_on_exit;
         bool tello_logging;
@@ -57,279 +47,160 @@ class Tello
         const std::string &tello_state_receiver_ip = "0.0.0.0", 
         const int &tello_state_receiver_port = 8890,
         const std::string &tello_video_receiver_ip = "0.0.0.0",
-        const int &tello_video_receiver_port = 11111
-        ): 
-        land_on_exit{land_on_exit},
-        tello_logging{tello_logging},
-        tello_logger{TelloLogger(this->tello_logging)},
-        tello_client{TelloSocket(tello_logger, tello_response_timeout_secs, tello_ip, tello_port, tello_client_ip, tello_client_port)},
-        tello_state_receiver{TelloSocket(tello_logger, tello_response_timeout_secs, tello_ip, tello_port, tello_state_receiver_ip, tello_state_receiver_port)},
-        tello_video_receiver{TelloSocket(tello_logger, tello_response_timeout_secs, tello_ip, tello_port, tello_video_receiver_ip, tello_video_receiver_port)}
-        {
-                this->tello_client.send_command("command");
-
-                if (this->land_on_exit) 
-                {
-                        this->start_flight_time = this->get_flight_time();
-                }
-        }
-
-        std::string takeoff() 
-        {
-                return  this->tello_client.send_command("takeoff");
-        }
-
-        std::string land() 
-        {
-                return this->tello_client.send_command("land");
-        }
-
-        std::string emergency_shutdown() 
-        {
-                return this->tello_client.send_command("emergency");
-        }
-
-        std::string fly_forward(const int &forward_cm) 
-        {
-                return this->tello_client.send_command(format_string("forward %i", forward_cm));
-        }
-
-        std::string fly_backward(const int &backward_cm) 
-        {
-                return this->tello_client.send_command(format_string("back %i", backward_cm));
-        }
-
-        std::string fly_up(const int &up_cm) 
-        {
-                return this->tello_client.send_command(format_string("up %i", up_cm));
-        }
-
-        std::string fly_down(const int &down_cm) 
-        {
-                return this->tello_client.send_command(format_string("down %i", down_cm));
-        }
-
-        std::string fly_left(const int &left_cm) 
-        {
-                return this->tello_client.send_command(format_string("left %i", left_cm));
-        }
-
-        std::string fly_right(const int &right_cm) 
-        {
-                return this->tello_client.send_command(format_string("right %i", right_cm));
-        }
-
-        std::string rotate_clockwise(const int &angle) 
-        {
-                return this->tello_client.send_command(format_string("cw %i", angle));
-        }
-
-        std::string rotate_counterclockwise(const int &angle) 
-        {
-                return this->tello_client.send_command(format_string("ccw %i", angle));
-        }
-
-        std::string front_flip() 
-        {
-                return this->tello_client.send_command("flip f");
-        }
-
-        std::string back_flip() 
-        {
-                return this->tello_client.send_command("flip b");
-        }
-
-        std::string left_flip() 
-        {
-                return this->tello_client.send_command("flip l");
-        }
-
-        std::string right_flip() 
-        {
-                return this->tello_client.send_command("flip r");
-        }
-
-        std::string fly_to_position(const int &x_position, const int &y_position, const int &z_position, const int &speed_cm_per_sec) 
-        {
-                return this->tello_client.send_command(format_string("go %i %i %i %i", x_position, y_position, z_position, speed_cm_per_sec));
-        }
-
-        std::string fly_to_position(const int &x1_position, const int &y1_position, const int &z1_position, int x2_position, const int &y2_position, const int &z2_position, const int &speed_cm_per_sec) 
-        {
-                return this->tello_client.send_command(format_string("curve %i %i %i %i %i %i %i", x1_position, y1_position, z1_position, x2_position, y2_position, z2_position, speed_cm_per_sec));
-        }
-
-        std::string set_speed(const int &speed_cm_per_sec) 
-        {
-                return this->tello_client.send_command(format_string("speed %i", speed_cm_per_sec));
-        }
-
-        std::string set_remote_control(const int &roll, const int &pitch, const int &up_down, const int &yaw) 
-        {
-                return this->tello_client.send_command(format_string("rc %i %i %i %i", roll, pitch, up_down, yaw));
-        }
-
-        std::string change_tello_wifi_info(const std::string &new_tello_wifi_name, const std::string &new_tello_wifi_password) 
-        {
-                return this->tello_client.send_command(format_string("wifi %s %s", new_tello_wifi_name.c_str(), new_tello_wifi_password.c_str()));
-        }
-
-        TelloState get_tello_state() 
-        {
-                std::string tello_state_response = this->tello_state_receiver.receive_data();
-
-                TelloState tello_state;
-
-                const std::regex tello_state_regex
-                (
-                R"((pitch:)(.+)(;roll:)(.+)(;yaw:)(.+)(;vgx:)(.+)(;vgy:)(.+)(;vgz:)(.+)(;templ:)(.+)(;temph:)(.+)(;tof:)(.+)(;h:)(.+)(;bat:)(.+)(;baro:)(.+)(;time:)(.+)(;agx:)(.+)(;agy:)(.+)(;agz:)(.+)(;))"
-                );
-
-                std::smatch matches;
-                regex_search(tello_state_response, matches, tello_state_regex);
-
-                return TelloState
-                {
-                {std::stoi(matches[2].str()), std::stoi(matches[4].str()), std::stoi(matches[6].str())}, 
-                {std::stoi(matches[8].str()), std::stoi(matches[10].str()), std::stoi(matches[12].str())}, 
-                (std::stof(matches[14].str()) + std::stof(matches[16].str())) / 2,
-                std::stoi(matches[18].str()), 
-                std::stoi(matches[20].str()), 
-                std::stoi(matches[22].str()), 
-                std::stof(matches[24].str()), 
-                std::stoi(matches[26].str()), 
-                {std::stof(matches[28].str()), std::stof(matches[30].str()), std::stof(matches[32].str())}
-                };
-        }
-
-        float get_speed() 
-        {
-                return stof(this->tello_client.send_command("speed?"));
-        }
-
-        int get_battery() 
-        {
-                return stoi(this->tello_client.send_command("battery?"));
-        }
-
-        int get_flight_time() 
-        {
-                const std::regex flight_time_regex(R"((\d+)(\w+))");
-                std::smatch matches;
-
-                std::string flight_time_response = this->tello_client.send_command("time?");
-
-                std::regex_search(flight_time_response, matches, flight_time_regex);
-
-                this->tello_logger.log_data(format_string("Tello Flight Time Units: '%s'", matches[2].str().c_str()));
-
-                return std::stoi(matches[1].str());
-        }
-
-        int get_height() 
-        {
-                const std::regex height_regex(R"((\d+)(\w+))");
-                std::smatch matches;
+        const int &tello_video_receiver_port = 11111,
+        const TelloConnectMode &connect_mode = TelloConnectMode::blocking
+        );
 
-                std::string height_response = this->tello_client.send_command("height?");
-
-                regex_search(height_response, matches, height_regex);
-
-                this->tello_logger.log_data(format_string("Tello Height Units: '%s'", matches[2].str().c_str()));
-
-                return std::stoi(matches[1].str());
-        }
-
-        float get_average_temprature() 
-        {
-                const std::regex temprature_regex(R"((\d+)(~)(\d+)(\w+))");
-                std::smatch matches;
-
-                std::string temprature_response = this->tello_client.send_command("temp?");
-
-                regex_search(temprature_response, matches, temprature_regex);
-
-                this->tello_logger.log_data(format_string("Tello Temprature Unit: '%s'", matches[4].str().c_str()));
-
-                return (std::stof(matches[1].str()) + std::stof(matches[3].str())) / 2;
-        }
-
-        const IMUAttitude get_imu_attitude() 
-        {
-                const std::regex imu_attitude_regex(R"((pitch:)(.+)(;roll:)(.+)(;yaw:)(.+)(;))");
-                std::smatch matches;
-
-                std::string imu_attitude_reponse = this->tello_client.send_command("attitude?");
-
-                regex_search(imu_attitude_reponse, matches, imu_attitude_regex);
-
-                this->tello_logger.log_data("Tello IMU Attitude Units: Pitch, Roll, Yaw");
-
-                return IMUAttitude{std::stoi(matches[2].str()), std::stoi(matches[4].str()), std::stoi(matches[6].str())};
-        }
-
-        float get_barometer_reading() 
-        {
-                return std::stof(this->tello_client.send_command("baro?"));
-        }
-
-        IMUAcceleration get_imu_acceleration() 
-        {
-                const std::regex imu_acceleration_regex(R"((agx:)(.+)(;agy:)(.+)(;agz:)(.+)(;))");
-                std::smatch matches;
-
-                std::string imu_acceleration_reponse = this->tello_client.send_command("acceleration?");
-
-                std::regex_search(imu_acceleration_reponse, matches, imu_acceleration_regex);
-
-                this->tello_logger.log_data("Tello IMU Acceleration Units: X Acceleration, Y Acceleration, Z Acceleration");
-
-                return IMUAcceleration{std::stof(matches[2].str()), std::stof(matches[4].str()), std::stof(matches[6].str())};
-        }
-
-        float get_distance_from_takeoff() 
-        {
-                const std::regex distance_from_takeoff_regex(R"((\d+|.)(\w+))");
-                std::smatch matches;
-
-                std::string distance_from_takeoff_response = this->tello_client.send_command("tof?");
-
-                std::regex_search(distance_from_takeoff_response, matches, distance_from_takeoff_regex);
-
-                this->tello_logger.log_data(format_string("Tello Distance Form Takeoff Units: '%s'", matches[2].str().c_str()));
-
-                return std::stof(matches[1].str());
-        }
-
-        int get_wifi_snr() 
-        {
-                return std::stoi(this->tello_client.send_command("wifi?"));
-        }
-
-        std::string get_video_frame(const int &buffer_size) 
-        {
-                return this->tello_video_receiver.receive_data(buffer_size);
-        }
-
-        ~Tello() 
-        {
-                try
-                {
-                        if (this->land_on_exit && this->get_flight_time() > this->start_flight_time) 
-                        {
-                                this->land();
-                        }
-                }
-                catch(...)
-                {
+        Tello
+        (
+        const TelloEndpoint &tello_endpoint,
+        const bool &tello_logging = false,
+        const bool &land_on_exit = false, 
+        const int &tello_response_timeout_secs = 12,
+        const TelloConnectMode &connect_mode = TelloConnectMode::blocking
+        ); 
 
-                }
-        }
+        Tello
+        (
+        TelloEndpointManager &endpoint_manager,
+        const std::string &tello_ip,
+        const bool &tello_logging = false,
+        const bool &land_on_exit = false, 
+        const int &tello_response_timeout_secs = 12,
+        const TelloConnectMode &connect_mode = TelloConnectMode::blocking
+        ); 
+
+        Tello(Tello const&) = delete;
+        void operator = (Tello const&) = delete;
+
+        const TelloEndpoint &get_endpoint() const;
+
+        bool connect(const std::chrono::milliseconds &timeout);
+        bool is_connected() const;
+        static TelloHandshakeReport connect_all(std::span<Tello* const> tellos, const std::chrono::milliseconds &timeout);
+        static TelloHandshakeReport land_all(std::span<Tello* const> tellos, const std::chrono::milliseconds &timeout);
+        void set_land_on_exit_timeout(const std::chrono::milliseconds &land_on_exit_timeout);
+
+        std::string takeoff();
+        std::string land();
+        std::string emergency_shutdown();
+        std::string fly_forward(const int &forward_cm);
+        std::string fly_backward(const int &backward_cm);
+        std::string fly_up(const int &up_cm);
+        std::string fly_down(const int &down_cm);
+        std::string fly_left(const int &left_cm);
+        std::string fly_right(const int &right_cm);
+        std::string rotate_clockwise(const int &angle);
+        std::string rotate_counterclockwise(const int &angle);
+        std::string front_flip();
+        std::string back_flip();
+        std::string left_flip();
+        std::string right_flip();
+        std::string fly_to_position(const int &x_position, const int &y_position, const int &z_position, const int &speed_cm_per_sec);
+        std::string fly_to_position(const int &x1_position, const int &y1_position, const int &z1_position, int x2_position, const int &y2_position, const int &z2_position, const int &speed_cm_per_sec);
+        std::string set_speed(const int &speed_cm_per_sec);
+
+        void set_remote_control(const int &roll, const int &pitch, const int &up_down, const int &yaw);
+        void start_remote_control_stream(const int &send_rate_hz = 50);
+        void stop_remote_control_stream();
+        RemoteControlJitter get_remote_control_jitter() const;
+
+        std::string change_tello_wifi_info(const std::string &new_tello_wifi_name, const std::string &new_tello_wifi_password);
+
+        void start_command_pipeline();
+        void stop_command_pipeline();
+        bool is_command_pipelining() const;
+        std::future<std::string> send_command_async(std::string_view to_send, const std::chrono::milliseconds &response_timeout);
+        std::future<std::string> send_command_async(std::string_view to_send);
+
+        std::future<MissionResult> run_mission(const MissionPlan &mission_plan, const MissionRetryPolicy &retry_policy = MissionRetryPolicy{});
+        void cancel_mission();
+
+        void start_reliable_commands(const int &max_query_retransmissions = 5, const int &max_motion_retransmissions = 1);
+        void stop_reliable_commands();
+        bool is_sending_reliable_commands() const;
+        const TelloRttEstimator &get_rtt_estimator() const;
+        std::uint64_t get_command_retransmission_count() const;
+        std::uint64_t get_telemetry_confirmed_motion_count() const;
+
+        const TelloCommandMetrics &get_command_metrics() const;
+        void write_log(const std::string &log_location) const;
+
+        void start_flight_recording(const std::string &recording_location);
+        void stop_flight_recording();
+
+        void start_packet_capture(const std::string &capture_location);
+        void stop_packet_capture();
+        bool is_capturing_packets() const;
+
+        void start_tello_state_stream();
+        void stop_tello_state_stream();
+        bool is_tello_state_streaming() const;
+
+        void start_state_estimation(const TelloStateEstimatorSettings &estimator_settings = TelloStateEstimatorSettings{});
+        void stop_state_estimation();
+        bool is_estimating_state() const;
+        TelloPose get_estimated_pose(const std::chrono::steady_clock::time_point &at) const;
+        TelloPose get_estimated_pose() const;
+
+        void start_cached_queries(const std::chrono::milliseconds &max_tello_state_age = std::chrono::milliseconds(500));
+        void stop_cached_queries();
+        bool is_serving_cached_queries() const;
+        std::uint64_t get_cached_query_hit_count() const;
+        std::uint64_t get_cached_query_miss_count() const;
+
+        TelloState get_tello_state();
+        float get_speed();
+        int get_battery();
+        int get_flight_time();
+        int get_height();
+        float get_average_temprature();
+        const IMUAttitude get_imu_attitude();
+        float get_barometer_reading();
+        IMUAcceleration get_imu_acceleration();
+        float get_distance_from_takeoff();
+        int get_wifi_snr();
+
+        std::string get_video_frame(const int &buffer_size);
+        std::span<const std::byte> get_video_access_unit();
+
+        void set_video_decoder(const VideoDecoder &video_decoder);
+        void add_video_consumer(const VideoConsumer &video_consumer);
+        void start_video_pipeline();
+        void stop_video_pipeline();
+        bool is_video_pipelining() const;
+        TelloVideoPipelineStatistics get_video_pipeline_statistics() const;
+
+        ~Tello();
 
     private:
-        TelloLogger tello_logger;
-        TelloSocket tello_client;
-        TelloSocket tello_state_receiver;
-        TelloSocket tello_video_receiver;
-        int start_flight_time;
+        struct TelloModules;
+
+        void initialize_tello(const TelloConnectMode &connect_mode);
+        void track_flight(std::string_view to_send);
+        static TelloHandshakeReport exchange_with_all(std::span<Tello* const> tellos, std::string_view to_send, const std::chrono::milliseconds &timeout);
+        bool try_get_cached_tello_state(TelloState &cached_tello_state);
+        void record_tello_state(const TelloState &tello_state);
+        void estimate_tello_state(const TelloState &tello_state, const std::chrono::steady_clock::time_point &received_at);
+        bool try_get_fresh_tello_state(TelloState &fresh_tello_state);
+        bool wait_for_tello_state_since(const std::chrono::steady_clock::time_point &since, TelloState &tello_state);
+        std::string send_reliable_command(std::string_view to_send);
+        std::string send_guarded_motion_command(std::string_view to_send, const TelloMotionGuard &motion_guard, const std::chrono::milliseconds &response_timeout);
+        std::string send_command(std::string_view to_send);
+
+        std::unique_ptr<TelloModules> tello_modules;
+        bool serving_cached_queries = false;
+        std::chrono::milliseconds max_cached_tello_state_age{500};
+        std::atomic<std::uint64_t> cached_query_hits{0};
+        std::atomic<std::uint64_t> cached_query_misses{0};
+        std::atomic<bool> estimating_state{false};
+        std::atomic<bool> sending_reliable_commands{false};
+        int max_query_retransmissions = 5;
+        int max_motion_retransmissions = 1;
+        std::atomic<std::uint64_t> motion_retransmissions{0};
+        std::atomic<std::uint64_t> telemetry_confirmed_motions{0};
+        std::chrono::steady_clock::time_point last_motion_finished_at{};
+        std::atomic<bool> connected{false};
+        std::atomic<bool> may_be_flying{false};
+        std::chrono::milliseconds land_on_exit_timeout{1000};
 };
\ No newline at end of file
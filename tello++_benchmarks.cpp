@@ -0,0 +1,682 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <future>
+#include <iostream>
+#include <map>
+#include <regex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "tello++/tello.h"
+#include "tello++/modules/internals/address_table.h"
+#include "tello++/modules/tello_endpoint_manager.h"
+#include "tello++/modules/tello_logger.h"
+#include "tello++/modules/tello_packet_capture.h"
+#include "tello++/modules/tello_packet_replayer.h"
+#include "tello++/modules/tello_simulator.h"
+#include "tello++/modules/tello_socket.h"
+#include "tello++/modules/tello_state_batch.h"
+#include "tello++/modules/tello_state_estimator.h"
+#include "tello++/modules/tello_state_listener.h"
+#include "tello++/modules/tello_state_stream.h"
+#include "tello++/modules/tello_swarm.h"
+#include "tello++/modules/tello_video_pipeline.h"
+#include "tello++/modules/tello_video_receiver.h"
+
+static const std::string tello_state_packet = "pitch:-2;roll:1;yaw:-87;vgx:0;vgy:0;vgz:0;templ:62;temph:65;tof:10;h:0;bat:87;baro:-57.82;time:0;agx:-3.00;agy:-12.00;agz:-999.00;\r\n";
+static const std::string mission_pad_tello_state_packet = "mid:-1;x:0;y:0;z:0;mpry:0,0,0;pitch:-2;roll:1;yaw:-87;vgx:0;vgy:0;vgz:0;templ:62;temph:65;tof:10;h:0;bat:87;baro:-57.82;time:0;agx:-3.00;agy:-12.00;agz:-999.00;\r\n";
+
+static int failed_benchmarks = 0;
+
+TelloState parse_tello_state_with_regex(const std::string &tello_state_response)
+{
+    const std::regex tello_state_regex
+    (
+    R"((pitch:)(.+)(;roll:)(.+)(;yaw:)(.+)(;vgx:)(.+)(;vgy:)(.+)(;vgz:)(.+)(;templ:)(.+)(;temph:)(.+)(;tof:)(.+)(;h:)(.+)(;bat:)(.+)(;baro:)(.+)(;time:)(.+)(;agx:)(.+)(;agy:)(.+)(;agz:)(.+)(;))"
+    );
+
+    std::smatch matches;
+    regex_search(tello_state_response, matches, tello_state_regex);
+
+    return TelloState
+    {
+    {std::stoi(matches[2].str()), std::stoi(matches[4].str()), std::stoi(matches[6].str())},
+    {std::stoi(matches[8].str()), std::stoi(matches[10].str()), std::stoi(matches[12].str())},
+    (std::stof(matches[14].str()) + std::stof(matches[16].str())) / 2,
+    std::stoi(matches[18].str()),
+    std::stoi(matches[20].str()),
+    std::stoi(matches[22].str()),
+    std::stof(matches[24].str()),
+    std::stoi(matches[26].str()),
+    {std::stof(matches[28].str()), std::stof(matches[30].str()), std::stof(matches[32].str())}
+    };
+}
+
+template<typename Benchmark>
+void run_benchmark(const std::string &benchmark_name, const int &iterations, Benchmark benchmark)
+{
+    volatile int sink = 0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int iteration = 0; iteration < iterations; iteration++)
+    {
+        sink = sink + benchmark();
+    }
+
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << benchmark_name << ": " << (elapsed / iterations) << " ns/op (" << iterations << " iterations)\n";
+}
+
+template<typename Consumer>
+void run_throughput_benchmark(const std::string &benchmark_name, const std::chrono::milliseconds &duration, Consumer consumer)
+{
+    std::uint64_t consumed = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + duration;
+
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        consumed += consumer();
+    }
+
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << benchmark_name << ": " << (consumed / elapsed) << " /s (" << consumed << " in " << elapsed << " s)\n";
+}
+
+void run_swarm_ingestion_benchmark(const int &iterations)
+{
+    constexpr int tello_count = 8;
+    constexpr int burst_size = 64;
+
+    bool tello_logging = false;
+    TelloLogger tello_logger(tello_logging);
+
+    std::uint64_t received_tello_states = 0;
+
+    TelloSwarm tello_swarm;
+    std::vector<std::unique_ptr<TelloSocket>> tello_state_senders;
+
+    for (int tello_index = 0; tello_index < tello_count; tello_index++)
+    {
+        TelloEndpoint tello_endpoint;
+        tello_endpoint.tello_ip = "127.0.0.1";
+        tello_endpoint.tello_port = 18960 + tello_index;
+        tello_endpoint.tello_client_ip = "127.0.0.1";
+        tello_endpoint.tello_client_port = 18900 + tello_index;
+        tello_endpoint.tello_state_receiver_ip = "127.0.0.1";
+        tello_endpoint.tello_state_receiver_port = 18920 + tello_index;
+        tello_endpoint.tello_video_receiver_port = TelloSwarm::no_receiver;
+
+        tello_swarm.add_tello(tello_endpoint, {{}, [&received_tello_states](std::size_t, const TelloState&) { received_tello_states++; }, {}});
+        tello_state_senders.push_back(std::make_unique<TelloSocket>(tello_logger, 1, "127.0.0.1", 18920 + tello_index, "127.0.0.1", 18960 + tello_index));
+    }
+
+    std::vector<std::string> tello_state_burst(burst_size, tello_state_packet);
+
+    run_benchmark(std::string("swarm ingest 8x64 states (") + (tello_swarm.is_using_io_uring() ? "io_uring" : "epoll") + ")", iterations, [&]
+    {
+        std::uint64_t expected_tello_states = received_tello_states + tello_count * burst_size;
+
+        for (std::unique_ptr<TelloSocket> &tello_state_sender : tello_state_senders)
+        {
+            tello_state_sender->send_datagrams(tello_state_burst.data(), burst_size);
+        }
+
+        while (received_tello_states < expected_tello_states && tello_swarm.poll_events(100) > 0)
+        {
+
+        }
+
+        return static_cast<int>(received_tello_states);
+    });
+}
+
+void run_address_table_benchmarks(const int &iterations)
+{
+    AddressTable<int> address_table;
+    std::map<std::uint32_t, int> address_map;
+    std::vector<std::uint32_t> tello_addresses;
+
+    for (int tello_index = 0; tello_index < 256; tello_index++)
+    {
+        std::uint32_t tello_address = encode_ip_address(AF_INET, format_string("192.168.10.%i", tello_index)).s_addr;
+
+        address_table.insert(tello_address, tello_index);
+        address_map.emplace(tello_address, tello_index);
+        tello_addresses.push_back(tello_address);
+    }
+
+    std::size_t lookup = 0;
+    run_benchmark("demux 256 tellos (std::map)", iterations, [&] { lookup = (lookup + 97) % tello_addresses.size(); return address_map.find(tello_addresses[lookup])->second; });
+    run_benchmark("demux 256 tellos (AddressTable)", iterations, [&] { lookup = (lookup + 97) % tello_addresses.size(); return *address_table.find(tello_addresses[lookup]); });
+}
+
+void run_state_listener_benchmarks(const int &iterations)
+{
+    constexpr int tello_count = 8;
+    constexpr int burst_size = 64;
+
+    bool tello_logging = false;
+    TelloLogger tello_logger(tello_logging);
+    std::vector<std::string> tello_state_burst(burst_size, tello_state_packet);
+
+    for (int worker_count : {1, 4})
+    {
+        TelloStateListener tello_state_listener(tello_logger, "127.0.0.1", 18990, worker_count);
+        std::vector<std::unique_ptr<TelloSocket>> tello_state_senders;
+
+        for (int tello_index = 0; tello_index < tello_count; tello_index++)
+        {
+            std::string tello_ip = format_string("127.0.0.%i", tello_index + 2);
+
+            tello_state_listener.subscribe(tello_ip, [](const TelloStateSample&) {});
+            tello_state_senders.push_back(std::make_unique<TelloSocket>(tello_logger, 1, "127.0.0.1", 18990, tello_ip, 18991));
+        }
+
+        tello_state_listener.start();
+
+        run_benchmark(format_string("shared state listener 8x64 states (%i of %i workers)", tello_state_listener.get_worker_count(), worker_count), iterations, [&]
+        {
+            std::uint64_t expected_tello_states = tello_state_listener.get_tello_state_count() + tello_count * burst_size;
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(100);
+
+            for (std::unique_ptr<TelloSocket> &tello_state_sender : tello_state_senders)
+            {
+                tello_state_sender->send_datagrams(tello_state_burst.data(), burst_size);
+            }
+
+            while (tello_state_listener.get_tello_state_count() < expected_tello_states && std::chrono::steady_clock::now() < deadline)
+            {
+                std::this_thread::yield();
+            }
+
+            return static_cast<int>(tello_state_listener.get_tello_state_count());
+        });
+    }
+}
+
+void run_swarm_bring_up_benchmark(const int &iterations)
+{
+    constexpr int tello_count = 16;
+
+    TelloEndpointManagerSettings endpoint_manager_settings;
+    endpoint_manager_settings.tello_client_ip = "127.0.0.1";
+    endpoint_manager_settings.first_tello_client_port = 19500;
+    endpoint_manager_settings.tello_video_receiver_ip = "127.0.0.1";
+    endpoint_manager_settings.first_tello_video_receiver_port = 19600;
+    endpoint_manager_settings.tello_state_receiver_ip = "127.0.0.1";
+    endpoint_manager_settings.tello_state_receiver_port = 18990;
+
+    TelloEndpointManager endpoint_manager(endpoint_manager_settings);
+    std::vector<std::unique_ptr<TelloSimulator>> tello_simulators;
+    std::vector<std::string> tello_ips;
+
+    for (int tello_index = 0; tello_index < tello_count; tello_index++)
+    {
+        TelloSimulatorSettings simulator_settings;
+        simulator_settings.simulator_ip = format_string("127.0.0.%i", tello_index + 2);
+        simulator_settings.simulator_port = 8889;
+        simulator_settings.state_port = 18990;
+        simulator_settings.video_port = 19700 + tello_index;
+        simulator_settings.network_conditions.minimum_delay_micros = 20000;
+        simulator_settings.network_conditions.maximum_delay_micros = 20000;
+
+        tello_simulators.push_back(std::make_unique<TelloSimulator>(simulator_settings));
+        tello_simulators.back()->start();
+        tello_ips.push_back(simulator_settings.simulator_ip);
+    }
+
+    run_benchmark("bring up 16 tellos one by one (20 ms rtt)", iterations, [&]
+    {
+        std::vector<std::unique_ptr<Tello>> tellos;
+
+        for (const std::string &tello_ip : tello_ips)
+        {
+            tellos.push_back(std::make_unique<Tello>(endpoint_manager, tello_ip));
+        }
+
+        return static_cast<int>(tellos.size());
+    });
+
+    run_benchmark("bring up 16 tellos with connect_all (20 ms rtt)", iterations, [&]
+    {
+        std::vector<std::unique_ptr<Tello>> tellos;
+        std::vector<Tello*> tello_handles;
+
+        for (const std::string &tello_ip : tello_ips)
+        {
+            tellos.push_back(std::make_unique<Tello>(endpoint_manager, tello_ip, false, false, 12, TelloConnectMode::deferred));
+            tello_handles.push_back(tellos.back().get());
+        }
+
+        return static_cast<int>(Tello::connect_all(tello_handles, std::chrono::milliseconds(1000)).responsive_tellos.size());
+    });
+}
+
+void run_round_trip_benchmarks(const int &round_trips)
+{
+    TelloSimulator tello_simulator;
+    tello_simulator.start();
+
+    Tello tello(tello_simulator.get_tello_endpoint(), false, false, 1);
+
+    std::vector<double> round_trip_micros;
+    round_trip_micros.reserve(round_trips);
+
+    for (int round_trip = 0; round_trip < round_trips; round_trip++)
+    {
+        auto sent_at = std::chrono::steady_clock::now();
+        tello.get_battery();
+        round_trip_micros.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - sent_at).count());
+    }
+
+    std::sort(round_trip_micros.begin(), round_trip_micros.end());
+
+    double round_trip_sum = 0;
+
+    for (const double &micros : round_trip_micros)
+    {
+        round_trip_sum += micros;
+    }
+
+    std::cout << "simulator round trip (battery?): mean " << (round_trip_sum / round_trips) << " us, p50 " << round_trip_micros[round_trips / 2] << " us, p99 " << round_trip_micros[(round_trips * 99) / 100] << " us\n";
+
+    tello.start_cached_queries(std::chrono::milliseconds(1000));
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    run_benchmark("simulator get_battery (cached telemetry)", round_trips, [&tello] { return tello.get_battery(); });
+
+    tello.stop_cached_queries();
+
+    std::vector<std::future<std::string>> pending_commands;
+    pending_commands.reserve(32);
+
+    run_throughput_benchmark("simulator pipelined commands (32 in flight)", std::chrono::milliseconds(500), [&]
+    {
+        pending_commands.clear();
+
+        for (int command = 0; command < 32; command++)
+        {
+            pending_commands.push_back(tello.send_command_async(TelloCommands::BatteryQuery::command_name));
+        }
+
+        for (std::future<std::string> &pending_command : pending_commands)
+        {
+            pending_command.get();
+        }
+
+        return static_cast<std::uint64_t>(pending_commands.size());
+    });
+}
+
+void run_lossy_link_benchmark(const int &queries)
+{
+    TelloSimulator tello_simulator;
+    tello_simulator.start();
+    tello_simulator.set_network_conditions(TelloNetworkConditions{0.1, 0, 200, 2000});
+
+    Tello tello(tello_simulator.get_tello_endpoint(), false, false, 1);
+
+    int blocking_failed_queries = 0;
+
+    for (const bool &reliable_commands : {false, true})
+    {
+        if (reliable_commands)
+        {
+            tello.start_reliable_commands();
+        }
+
+        double worst_stall_micros = 0;
+        double stall_sum_micros = 0;
+        int failed_queries = 0;
+
+        for (int query = 0; query < queries; query++)
+        {
+            auto sent_at = std::chrono::steady_clock::now();
+
+            try
+            {
+                tello.get_speed();
+            }
+            catch(const std::runtime_error&)
+            {
+                failed_queries++;
+            }
+
+            double stall_micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - sent_at).count();
+            worst_stall_micros = std::max(worst_stall_micros, stall_micros);
+            stall_sum_micros += stall_micros;
+        }
+
+        std::cout << "10% loss speed? " << (reliable_commands ? "(adaptive retransmission)" : "(blocking timeout)") << ": mean " << (stall_sum_micros / queries) << " us, worst " << worst_stall_micros << " us, " << failed_queries << " failed";
+
+        if (!reliable_commands)
+        {
+            blocking_failed_queries = failed_queries;
+            std::cout << '\n';
+        }
+        else
+        {
+            std::cout << (failed_queries <= blocking_failed_queries ? " (passed)" : " (FAILED: more than the blocking timeout)") << '\n';
+
+            if (failed_queries > blocking_failed_queries)
+            {
+                failed_benchmarks++;
+            }
+        }
+    }
+
+    std::cout << "10% loss adaptive timeout: srtt " << tello.get_rtt_estimator().get_smoothed_rtt().count() << " us, rto " << tello.get_rtt_estimator().get_retransmission_timeout().count() << " us, " << tello.get_command_retransmission_count() << " retransmissions\n";
+}
+
+void run_replay_benchmark(const int &tello_state_count)
+{
+    const std::string capture_location = "tello++_benchmark_capture.tpc";
+
+    {
+        TelloPacketCapture packet_capture(capture_location);
+
+        for (int tello_state_index = 0; tello_state_index < tello_state_count; tello_state_index++)
+        {
+            packet_capture.capture(TelloPacketChannel::state, tello_state_packet, static_cast<std::int64_t>(tello_state_index) * 10000000);
+        }
+    }
+
+    TelloEndpoint tello_endpoint;
+    tello_endpoint.tello_ip = "127.0.0.1";
+    tello_endpoint.tello_state_receiver_ip = "127.0.0.1";
+    tello_endpoint.tello_state_receiver_port = 18895;
+    tello_endpoint.tello_video_receiver_ip = "127.0.0.1";
+    tello_endpoint.tello_video_receiver_port = 18896;
+
+    bool tello_logging = false;
+    TelloLogger tello_logger(tello_logging);
+    TelloSocket tello_state_receiver(tello_logger, 1, tello_endpoint.tello_ip, tello_endpoint.tello_port, tello_endpoint.tello_state_receiver_ip, tello_endpoint.tello_state_receiver_port);
+    tello_state_receiver.set_receive_buffer_size(8 * 1024 * 1024);
+
+    TelloStateStream tello_state_stream(tello_state_receiver);
+    tello_state_stream.start();
+
+    TelloPacketRecording packet_recording(capture_location);
+    TelloPacketReplayer packet_replayer(packet_recording, tello_endpoint);
+
+    for (const double &replay_speed : {100.0, TelloPacketReplayer::max_replay_speed})
+    {
+        std::uint64_t tello_states_before = tello_state_stream.get_tello_state_count();
+
+        TelloReplayResult replay_result = packet_replayer.replay(replay_speed);
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        double replay_seconds = std::chrono::duration<double>(replay_result.replay_duration).count();
+
+        std::uint64_t parsed_tello_states = tello_state_stream.get_tello_state_count() - tello_states_before;
+
+        std::cout << "replay " << tello_state_count << " states " << (replay_speed == TelloPacketReplayer::max_replay_speed ? std::string("(max speed)") : "(" + std::to_string(static_cast<int>(replay_speed)) + "x)") << ": " << (replay_result.replayed_state_packets / replay_seconds) << " states/s sent, " << parsed_tello_states << " parsed by TelloStateStream " << (parsed_tello_states == replay_result.replayed_state_packets ? "(passed)" : "(FAILED: " + std::to_string(replay_result.replayed_state_packets - parsed_tello_states) + " dropped)") << '\n';
+
+        if (parsed_tello_states != replay_result.replayed_state_packets)
+        {
+            failed_benchmarks++;
+        }
+    }
+
+    tello_state_stream.stop();
+    std::remove(capture_location.c_str());
+}
+
+void run_telemetry_benchmark()
+{
+    TelloSimulatorSettings simulator_settings;
+    simulator_settings.state_rate_hz = 1000;
+
+    TelloSimulator tello_simulator(simulator_settings);
+    TelloEndpoint tello_endpoint = tello_simulator.get_tello_endpoint();
+
+    bool tello_logging = false;
+    TelloLogger tello_logger(tello_logging);
+    TelloSocket tello_state_receiver(tello_logger, 1, tello_endpoint.tello_ip, tello_endpoint.tello_port, tello_endpoint.tello_state_receiver_ip, tello_endpoint.tello_state_receiver_port);
+    TelloStateStream tello_state_stream(tello_state_receiver);
+
+    tello_simulator.start();
+    tello_state_stream.start();
+
+    std::uint64_t seen_tello_states = tello_state_stream.get_tello_state_count();
+
+    run_throughput_benchmark("simulator telemetry through TelloStateStream", std::chrono::milliseconds(1000), [&]
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        std::uint64_t tello_state_count = tello_state_stream.get_tello_state_count();
+        std::uint64_t new_tello_states = tello_state_count - seen_tello_states;
+        seen_tello_states = tello_state_count;
+
+        return new_tello_states;
+    });
+
+    tello_state_stream.stop();
+}
+
+void run_video_benchmark()
+{
+    TelloSimulatorSettings simulator_settings;
+    simulator_settings.state_rate_hz = 0;
+    simulator_settings.video_rate_fps = 1000;
+    simulator_settings.video_access_unit_size = 20000;
+
+    TelloSimulator tello_simulator(simulator_settings);
+    TelloEndpoint tello_endpoint = tello_simulator.get_tello_endpoint();
+
+    bool tello_logging = false;
+    TelloLogger tello_logger(tello_logging);
+    TelloSocket tello_video_receiver(tello_logger, 1, tello_endpoint.tello_ip, tello_endpoint.tello_port, tello_endpoint.tello_video_receiver_ip, tello_endpoint.tello_video_receiver_port);
+    tello_video_receiver.set_receive_buffer_size(4 * 1024 * 1024);
+    TelloVideoReceiver tello_video_assembler(tello_video_receiver);
+
+    tello_simulator.set_video_streaming(true);
+    tello_simulator.start();
+
+    run_throughput_benchmark("simulator video access units through TelloVideoReceiver", std::chrono::milliseconds(1000), [&]
+    {
+        return static_cast<std::uint64_t>(tello_video_assembler.receive_access_unit().size() > 0);
+    });
+
+    std::cout << "simulator video dropped access units: " << tello_video_assembler.get_dropped_access_unit_count() << " of " << tello_simulator.get_sent_video_access_unit_count() << "\n";
+
+    TelloVideoPipeline tello_video_pipeline(tello_video_receiver);
+    std::atomic<std::uint64_t> consumed_bytes{0};
+
+    tello_video_pipeline.add_video_consumer([&consumed_bytes](const FrameHandle &video_frame) { consumed_bytes.fetch_add(video_frame->size, std::memory_order_relaxed); });
+    tello_video_pipeline.start();
+
+    std::uint64_t seen_frames = 0;
+
+    run_throughput_benchmark("simulator video access units through TelloVideoPipeline", std::chrono::milliseconds(1000), [&]
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        std::uint64_t consumed_frames = tello_video_pipeline.get_statistics().consumed_frames;
+        std::uint64_t new_frames = consumed_frames - seen_frames;
+        seen_frames = consumed_frames;
+
+        return new_frames;
+    });
+
+    tello_video_pipeline.stop();
+
+    TelloVideoPipelineStatistics pipeline_statistics = tello_video_pipeline.get_statistics();
+    std::cout << "simulator video pipeline drops: " << pipeline_statistics.decode_queue_drops << " decode queue, " << pipeline_statistics.consumer_queue_drops << " consumer queue, " << pipeline_statistics.exhausted_frame_pool_drops << " exhausted pool\n";
+}
+
+void run_receive_benchmarks(const int &iterations)
+{
+    bool tello_logging = false;
+    TelloLogger tello_logger(tello_logging);
+    TelloSocket tello_sender(tello_logger, 1, "127.0.0.1", 18893, "127.0.0.1", 18894);
+    TelloSocket tello_receiver(tello_logger, 1, "127.0.0.1", 18894, "127.0.0.1", 18893);
+
+    run_benchmark("receive 'ok' (receive_data)", iterations, [&]
+    {
+        tello_sender.send_data("ok\r\n");
+        return static_cast<int>(tello_receiver.receive_data().size());
+    });
+
+    run_benchmark("receive 'ok' (receive_data_view)", iterations, [&]
+    {
+        tello_sender.send_data("ok\r\n");
+        return static_cast<int>(tello_receiver.receive_data_view().size());
+    });
+}
+
+void run_batch_ingestion_benchmarks(const int &iterations)
+{
+    constexpr int burst_size = 64;
+
+    bool tello_logging = false;
+    TelloLogger tello_logger(tello_logging);
+    TelloSocket tello_state_sender(tello_logger, 1, "127.0.0.1", 18891, "127.0.0.1", 18892);
+    TelloSocket tello_state_receiver(tello_logger, 1, "127.0.0.1", 18892, "127.0.0.1", 18891);
+    tello_state_receiver.set_receive_buffer_size(1024 * 1024);
+
+    std::vector<std::string> tello_state_burst(burst_size, tello_state_packet);
+
+    run_benchmark("ingest 64 states (receive_data + parse_tello_state)", iterations, [&]
+    {
+        tello_state_sender.send_datagrams(tello_state_burst.data(), burst_size);
+
+        int battery_sum = 0;
+
+        for (int datagram = 0; datagram < burst_size; datagram++)
+        {
+            battery_sum += parse_tello_state(tello_state_receiver.receive_data()).battery;
+        }
+
+        return battery_sum;
+    });
+
+    TelloStateBatch tello_state_batch(burst_size);
+    TelloStateBatchReceiver tello_state_batch_receiver(tello_state_receiver, burst_size);
+
+    run_benchmark("ingest 64 states (TelloStateBatchReceiver)", iterations, [&]
+    {
+        tello_state_sender.send_datagrams(tello_state_burst.data(), burst_size);
+
+        tello_state_batch.clear();
+
+        while (!tello_state_batch.is_full() && tello_state_batch_receiver.receive_tello_states(tello_state_batch) > 0)
+        {
+
+        }
+
+        int battery_sum = 0;
+
+        for (std::size_t index = 0; index < tello_state_batch.size(); index++)
+        {
+            battery_sum += tello_state_batch.battery[index];
+        }
+
+        return battery_sum;
+    });
+}
+
+void run_state_estimator_benchmarks(const int &iterations)
+{
+    constexpr int swarm_size = 64;
+
+    TelloState tello_state = parse_tello_state(tello_state_packet);
+    TelloStateEstimator tello_state_estimator;
+    auto received_at = std::chrono::steady_clock::now();
+
+    run_benchmark("update TelloStateEstimator", iterations, [&]
+    {
+        received_at += std::chrono::milliseconds(100);
+        tello_state_estimator.update(tello_state, received_at);
+        return static_cast<int>(tello_state_estimator.get_sample_count());
+    });
+
+    auto estimated_at = received_at - std::chrono::milliseconds(100);
+
+    run_benchmark("interpolate TelloStateEstimator pose", iterations, [&]
+    {
+        estimated_at += std::chrono::microseconds(1);
+        return static_cast<int>(tello_state_estimator.get_pose(estimated_at).get_height_cm());
+    });
+
+    std::vector<TelloState> tello_states(swarm_size, tello_state);
+    std::vector<std::chrono::steady_clock::time_point> tello_states_received_at(swarm_size, received_at);
+    TelloStateEstimatorBatch tello_state_estimator_batch(swarm_size);
+
+    run_benchmark("update TelloStateEstimatorBatch (64 Tellos)", iterations / 10, [&]
+    {
+        for (auto &tello_state_received_at : tello_states_received_at)
+        {
+            tello_state_received_at += std::chrono::milliseconds(100);
+        }
+
+        tello_state_estimator_batch.update(tello_states, tello_states_received_at);
+        return static_cast<int>(tello_state_estimator_batch.get_sample_count(swarm_size - 1));
+    });
+
+    std::vector<TelloStateEstimator> tello_state_estimators(swarm_size);
+
+    run_benchmark("update 64 TelloStateEstimators one by one", iterations / 10, [&]
+    {
+        for (int tello_index = 0; tello_index < swarm_size; tello_index++)
+        {
+            tello_state_estimators[tello_index].update(tello_states[tello_index], tello_states_received_at[tello_index] += std::chrono::milliseconds(100));
+        }
+
+        return static_cast<int>(tello_state_estimators[swarm_size - 1].get_sample_count());
+    });
+}
+
+int main(int argument_count, char **arguments)
+{
+    int iterations = argument_count > 1 ? std::stoi(arguments[1]) : 100000;
+
+    run_benchmark("parse_tello_state (regex)", iterations / 100, [] { return parse_tello_state_with_regex(tello_state_packet).battery; });
+    run_benchmark("parse_tello_state", iterations, [] { return parse_tello_state(tello_state_packet).battery; });
+    run_benchmark("parse_tello_state (mission pad fields)", iterations, [] { return parse_tello_state(mission_pad_tello_state_packet).battery; });
+
+    TelloState tello_state{};
+    run_benchmark("try_parse_tello_state_scalar (memchr + from_chars)", iterations, [&tello_state] { return try_parse_tello_state_scalar(tello_state_packet, tello_state) + tello_state.battery; });
+    run_benchmark("try_parse_tello_state_vectorized (scalar scanner)", iterations, [&tello_state] { return try_parse_tello_state_vectorized(tello_state_packet, tello_state, get_delimiter_scanner(DelimiterScannerKind::scalar)) + tello_state.battery; });
+    run_benchmark("try_parse_tello_state_vectorized (sse2 scanner)", iterations, [&tello_state] { return try_parse_tello_state_vectorized(tello_state_packet, tello_state, get_delimiter_scanner(DelimiterScannerKind::sse2)) + tello_state.battery; });
+
+    if (detect_delimiter_scanner_kind() == DelimiterScannerKind::avx2)
+    {
+        run_benchmark("try_parse_tello_state_vectorized (avx2 scanner)", iterations, [&tello_state] { return try_parse_tello_state_vectorized(tello_state_packet, tello_state, get_delimiter_scanner(DelimiterScannerKind::avx2)) + tello_state.battery; });
+    }
+
+    run_benchmark("try_parse_tello_state (runtime dispatch)", iterations, [&tello_state] { return try_parse_tello_state(tello_state_packet, tello_state) + tello_state.battery; });
+
+    int stick = 0;
+    run_benchmark("encode rc (format_string)", iterations, [&stick] { stick = (stick + 1) % 100; return static_cast<int>(format_string("rc %i %i %i %i", stick, -stick, stick, -stick).size()); });
+    run_benchmark("encode rc (TelloCommands)", iterations, [&stick] { stick = (stick + 1) % 100; return static_cast<int>(TelloCommands::RemoteControl::encode(stick, -stick, stick, -stick).view().size()); });
+
+    TelloCommandMetrics tello_command_metrics;
+    run_benchmark("record command latency (TelloCommandMetrics)", iterations, [&tello_command_metrics]
+    {
+        auto sent_at = tello_command_metrics.record_sent(TelloCommands::BatteryQuery::command_name);
+        tello_command_metrics.record_response(TelloCommands::BatteryQuery::command_name, sent_at, "87");
+        return 1;
+    });
+
+    run_state_estimator_benchmarks(std::max(iterations, 1000));
+    run_address_table_benchmarks(std::max(iterations, 1000));
+    run_receive_benchmarks(std::max(iterations / 10, 100));
+    run_batch_ingestion_benchmarks(std::max(iterations / 100, 100));
+    run_swarm_ingestion_benchmark(std::max(iterations / 100, 100));
+    run_state_listener_benchmarks(std::max(iterations / 100, 100));
+    run_round_trip_benchmarks(std::max(iterations / 100, 100));
+    run_swarm_bring_up_benchmark(std::max(iterations / 10000, 10));
+    run_lossy_link_benchmark(std::max(iterations / 1000, 50));
+    run_replay_benchmark(std::max(iterations / 10, 1000));
+    run_telemetry_benchmark();
+    run_video_benchmark();
+
+    return failed_benchmarks == 0 ? 0 : 1;
+}
\ No newline at end of file
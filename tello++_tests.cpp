@@ -1,10 +1,1048 @@
 #include <string>
 #include <iostream>
+#include <memory>
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 #include "tello++/tello.h"
+#include "tello++/modules/internals/address_table.h"
+#include "tello++/modules/internals/drop_oldest_queue.h"
+#include "tello++/modules/internals/frame_pool.h"
+#include "tello++/modules/tello_command_metrics.h"
+#include "tello++/modules/tello_command_pipeline.h"
+#include "tello++/modules/tello_commands.h"
+#include "tello++/modules/tello_flight_recorder.h"
+#include "tello++/modules/tello_mission_executor.h"
+#include "tello++/modules/tello_mission_plan.h"
+#include "tello++/modules/tello_packet_capture.h"
+#include "tello++/modules/tello_packet_replayer.h"
+#include "tello++/modules/tello_remote_control_stream.h"
+#include "tello++/modules/tello_rtt_estimator.h"
+#include "tello++/modules/tello_simulator.h"
+#include "tello++/modules/tello_socket.h"
+#include "tello++/modules/tello_state.h"
+#include "tello++/modules/tello_state_batch.h"
+#include "tello++/modules/tello_state_estimator.h"
+#include "tello++/modules/tello_video_receiver.h"
 
-int main() 
+static int failed_checks = 0;
+
+void check(const bool &passed, const std::string &check_name) 
+{
+    if (!passed) 
+    {
+        failed_checks++;
+        std::cerr << "FAILED: " << check_name << '\n';
+    }
+}
+
+std::size_t count_open_sockets() 
+{
+#if defined(__linux__)
+    return static_cast<std::size_t>(std::distance(std::filesystem::directory_iterator("/proc/self/fd"), std::filesystem::directory_iterator{}));
+#else
+    return 0;
+#endif
+}
+
+TelloSimulatorSettings make_delayed_simulator_settings(const int &delay_millis) 
+{
+    TelloSimulatorSettings simulator_settings;
+    simulator_settings.simulator_port = 28889;
+    simulator_settings.client_port = 29100;
+    simulator_settings.state_port = 28890;
+    simulator_settings.video_port = 28111;
+    simulator_settings.network_conditions.minimum_delay_micros = delay_millis * 1000;
+    simulator_settings.network_conditions.maximum_delay_micros = delay_millis * 1000;
+
+    return simulator_settings;
+}
+
+std::string get_response_or_error(std::future<std::string> response) 
+{
+    try
+    {
+        return response.get();
+    }
+    catch(const std::runtime_error&)
+    {
+        return "timeout";
+    }
+}
+
+bool is_same_tello_state(const TelloState &tello_state, const TelloState &other_tello_state) 
+{
+    return tello_state.imu_attitude.pitch == other_tello_state.imu_attitude.pitch && tello_state.imu_attitude.roll == other_tello_state.imu_attitude.roll && tello_state.imu_attitude.yaw == other_tello_state.imu_attitude.yaw
+        && tello_state.imu_velocity.x_velocity == other_tello_state.imu_velocity.x_velocity && tello_state.imu_velocity.y_velocity == other_tello_state.imu_velocity.y_velocity && tello_state.imu_velocity.z_velocity == other_tello_state.imu_velocity.z_velocity
+        && tello_state.average_temprature == other_tello_state.average_temprature && tello_state.distance_from_takeoff == other_tello_state.distance_from_takeoff && tello_state.height == other_tello_state.height && tello_state.battery == other_tello_state.battery
+        && tello_state.barometer_reading == other_tello_state.barometer_reading && tello_state.flight_time == other_tello_state.flight_time
+        && tello_state.imu_acceleration.x_acceleration == other_tello_state.imu_acceleration.x_acceleration && tello_state.imu_acceleration.y_acceleration == other_tello_state.imu_acceleration.y_acceleration && tello_state.imu_acceleration.z_acceleration == other_tello_state.imu_acceleration.z_acceleration;
+}
+
+bool parses_alike(const std::string &tello_state_packet) 
+{
+    TelloState scalar_tello_state{};
+    bool scalar_parsed = try_parse_tello_state_scalar(tello_state_packet, scalar_tello_state);
+
+    std::vector<DelimiterScannerKind> delimiter_scanner_kinds{DelimiterScannerKind::scalar, DelimiterScannerKind::sse2};
+
+    if (detect_delimiter_scanner_kind() == DelimiterScannerKind::avx2) 
+    {
+        delimiter_scanner_kinds.push_back(DelimiterScannerKind::avx2);
+    }
+
+    for (const DelimiterScannerKind &delimiter_scanner_kind : delimiter_scanner_kinds) 
+    {
+        TelloState vectorized_tello_state{};
+
+        if (try_parse_tello_state_vectorized(tello_state_packet, vectorized_tello_state, get_delimiter_scanner(delimiter_scanner_kind)) != scalar_parsed || (scalar_parsed && !is_same_tello_state(vectorized_tello_state, scalar_tello_state))) 
+        {
+            return false;
+        }
+    }
+
+    TelloState dispatched_tello_state{};
+
+    return try_parse_tello_state(tello_state_packet, dispatched_tello_state) == scalar_parsed && (!scalar_parsed || is_same_tello_state(dispatched_tello_state, scalar_tello_state));
+}
+
+bool parses(const std::string &tello_state_packet) 
+{
+    TelloState tello_state{};
+    return try_parse_tello_state(tello_state_packet, tello_state);
+}
+
+void check_tello_state_parsing() 
+{
+    const std::string tello_state_packet = "pitch:-2;roll:1;yaw:-87;vgx:0;vgy:0;vgz:0;templ:62;temph:65;tof:10;h:0;bat:87;baro:-57.82;time:0;agx:-3.00;agy:-12.00;agz:-999.00;";
+    const std::string mission_pad_fields = "mid:-1;x:0;y:0;z:0;mpry:0,0,0;";
+
+    TelloState tello_state = parse_tello_state(tello_state_packet + "\r\n");
+
+    check(tello_state.imu_attitude.pitch == -2 && tello_state.imu_attitude.yaw == -87 && tello_state.average_temprature == 63.5f && tello_state.battery == 87, "a state packet parses its integer fields");
+    check(tello_state.barometer_reading == -57.82f && tello_state.imu_acceleration.y_acceleration == -12.0f && tello_state.imu_acceleration.z_acceleration == -999.0f, "a state packet parses its decimal fields");
+
+    check(parses(mission_pad_fields + tello_state_packet), "a state packet with mission pad fields parses");
+    check(parses(tello_state_packet.substr(0, tello_state_packet.size() - 1)), "a state packet without a trailing ';' parses");
+    check(!parses(""), "an empty state packet doesn't parse");
+    check(!parses(tello_state_packet.substr(0, tello_state_packet.find("agz:"))), "a state packet missing a field doesn't parse");
+    check(!parses("bat:;" + tello_state_packet), "a state packet with an empty value doesn't parse");
+    check(!parses("bat:x8;" + tello_state_packet), "a state packet with a non-numeric value doesn't parse");
+
+    std::vector<std::string> tello_state_packets
+    {
+        tello_state_packet,
+        tello_state_packet + "\r\n",
+        mission_pad_fields + tello_state_packet,
+        tello_state_packet.substr(0, tello_state_packet.size() - 1),
+        "",
+        ";;;",
+        "bat:;" + tello_state_packet,
+        "bat:8x;" + tello_state_packet,
+        "bat:x8;" + tello_state_packet,
+        "bat:8:7;" + tello_state_packet,
+        "baro:1e2;" + tello_state_packet,
+        "baro:-0.5;" + tello_state_packet,
+        "baro:.5;" + tello_state_packet,
+        "baro:1234567890.1234567890123;" + tello_state_packet,
+        tello_state_packet.substr(0, tello_state_packet.find("agz:"))
+    };
+
+    for (std::size_t padding_size = 0; padding_size < 64; padding_size++) 
+    {
+        tello_state_packets.push_back("pad:" + std::string(padding_size, 'x') + ";" + tello_state_packet);
+    }
+
+    std::string long_tello_state_packet = tello_state_packet;
+
+    while (long_tello_state_packet.size() <= max_vectorized_tello_state_size) 
+    {
+        long_tello_state_packet = mission_pad_fields + long_tello_state_packet;
+    }
+
+    tello_state_packets.push_back(long_tello_state_packet);
+
+    bool parsed_alike = true;
+
+    for (const std::string &parity_tello_state_packet : tello_state_packets) 
+    {
+        parsed_alike = parsed_alike && parses_alike(parity_tello_state_packet);
+    }
+
+    check(parsed_alike, "the scalar, SSE2, AVX2 and dispatched state parsers agree");
+}
+
+void check_late_responses() 
+{
+    bool tello_logging = false;
+    TelloLogger tello_logger(tello_logging);
+
+    TelloSimulator tello_simulator(make_delayed_simulator_settings(150));
+    tello_simulator.start();
+
+    TelloSocket tello_client(tello_logger, 2, "127.0.0.1", 28889, "127.0.0.1", 29100);
+    TelloCommandPipeline tello_command_pipeline(tello_client);
+    tello_command_pipeline.start();
+
+    check(get_response_or_error(tello_command_pipeline.send_command("takeoff", std::chrono::milliseconds(50))) == "timeout", "a motion slower than its timeout times out");
+    check(get_response_or_error(tello_command_pipeline.send_command("battery?", std::chrono::milliseconds(1000))) == "87", "a late reply to a timed out motion doesn't answer the next query");
+
+    check(get_response_or_error(tello_command_pipeline.send_command("battery?", std::chrono::milliseconds(50))) == "timeout", "a query slower than its timeout times out");
+    check(get_response_or_error(tello_command_pipeline.send_command("up 20", std::chrono::milliseconds(1000))) == "ok", "a late reply to a timed out query doesn't answer the next motion");
+}
+
+void check_duplicate_responses() 
+{
+    bool tello_logging = false;
+    TelloLogger tello_logger(tello_logging);
+
+    TelloSimulator tello_simulator(make_delayed_simulator_settings(300));
+    tello_simulator.start();
+
+    {
+        TelloSocket tello_client(tello_logger, 2, "127.0.0.1", 28889, "127.0.0.1", 29100);
+        TelloCommandPipeline tello_command_pipeline(tello_client);
+        tello_command_pipeline.start();
+
+        check(get_response_or_error(tello_command_pipeline.send_command("battery?", std::chrono::milliseconds(2000), 1)) == "87", "a retransmitted query gets its reply");
+        check(tello_command_pipeline.get_rtt_estimator().get_retransmission_timeout() == std::chrono::milliseconds(200), "a reply to a retransmitted query resets the back off");
+
+        std::string flight_time = get_response_or_error(tello_command_pipeline.send_command("time?", std::chrono::milliseconds(2000)));
+
+        check(!flight_time.empty() && flight_time.back() == 's', "a duplicate reply to a retransmitted query doesn't answer the next query");
+        check(tello_command_pipeline.get_retransmission_count() == 1, "a query is retransmitted once its timeout runs out");
+    }
+
+    {
+        TelloSocket tello_client(tello_logger, 2, "127.0.0.1", 28889, "127.0.0.1", 29101);
+        TelloCommandPipeline tello_command_pipeline(tello_client);
+        tello_command_pipeline.start();
+
+        check(get_response_or_error(tello_command_pipeline.send_command("speed 50", std::chrono::milliseconds(2000), 1)) == "ok", "a retransmitted command gets its reply");
+
+        auto sent_at = std::chrono::steady_clock::now();
+        std::string response = get_response_or_error(tello_command_pipeline.send_command("up 20", std::chrono::milliseconds(2000)));
+
+        check(response != "timeout" && std::chrono::steady_clock::now() - sent_at >= std::chrono::milliseconds(250), "a duplicate 'ok' to a retransmitted command doesn't answer the next motion");
+    }
+}
+
+void check_lossy_responses() 
+{
+    bool tello_logging = false;
+    TelloLogger tello_logger(tello_logging);
+
+    TelloSimulatorSettings simulator_settings = make_delayed_simulator_settings(1);
+    simulator_settings.network_conditions.loss_probability = 0.1;
+
+    TelloSimulator tello_simulator(simulator_settings);
+    tello_simulator.start();
+
+    TelloSocket tello_client(tello_logger, 2, "127.0.0.1", 28889, "127.0.0.1", 29100);
+    TelloCommandPipeline tello_command_pipeline(tello_client);
+    tello_command_pipeline.start();
+
+    int failed_queries = 0;
+    int misanswered_queries = 0;
+
+    for (int query = 0; query < 100; query++) 
+    {
+        bool battery_query = query % 2 == 0;
+        std::string response = get_response_or_error(tello_command_pipeline.send_command(battery_query ? "battery?" : "time?", std::chrono::milliseconds(1000), 5));
+
+        if (response == "timeout") 
+        {
+            failed_queries++;
+        }
+        else if (battery_query ? response != "87" : response.empty() || response.back() != 's') 
+        {
+            misanswered_queries++;
+        }
+    }
+
+    check(tello_command_pipeline.get_retransmission_count() > 0, "a lossy link makes the pipeline retransmit");
+    check(failed_queries == 0, "retransmitted queries over a lossy link get a reply");
+    check(misanswered_queries == 0, "a lost reply doesn't make the next query discard or take the wrong reply");
+}
+
+template<typename Encode>
+std::string get_encoding_error(const Encode &encode) 
+{
+    try
+    {
+        encode();
+    }
+    catch(const std::out_of_range &encoding_error)
+    {
+        return encoding_error.what();
+    }
+
+    return "";
+}
+
+void check_command_encoding() 
+{
+    check(TelloCommands::Takeoff::encode<>().view() == "takeoff" && TelloCommands::Clockwise::encode<90>().view() == "cw 90", "commands encode with compile time arguments");
+    check(TelloCommands::Up::encode(20).view() == "up 20" && TelloCommands::Up::encode(500).view() == "up 500", "runtime arguments on the edges of their range encode");
+    check(TelloCommands::Go::encode(-500, 0, 500, 10).view() == "go -500 0 500 10", "negative runtime arguments encode");
+    check(TelloCommands::Curve::encode(-500, -500, -500, -500, -500, -500, 10).view() == "curve -500 -500 -500 -500 -500 -500 10", "the widest command fits its buffer");
+
+    check(get_encoding_error([] { return TelloCommands::Up::encode(19); }) == "Sorry, '19' is outside '[20, 500]' for 'up'.", "a runtime argument below its range throws");
+    check(!get_encoding_error([] { return TelloCommands::Clockwise::encode(361); }).empty(), "a runtime argument above its range throws");
+    check(!get_encoding_error([] { return TelloCommands::RemoteControl::encode(0, 0, 0, 101); }).empty(), "every runtime argument is range checked");
+    check(!get_encoding_error([] { return TelloCommands::Curve::encode(0, 0, 0, 0, 0, 0, 61); }).empty(), "runtime arguments are checked against their own range");
+}
+
+void check_rtt_estimator() 
 {
-    Tello tello{true, true};
+    TelloRttEstimator rtt_estimator;
+
+    check(rtt_estimator.get_retransmission_timeout() == std::chrono::milliseconds(200), "the retransmission timeout starts at 200ms");
+
+    rtt_estimator.add_sample(std::chrono::milliseconds(100));
+    check(rtt_estimator.get_retransmission_timeout() == std::chrono::milliseconds(300), "the first sample sets the timeout to srtt + 4 * srtt / 2");
+
+    rtt_estimator.add_sample(std::chrono::milliseconds(200));
+    check(rtt_estimator.get_smoothed_rtt() == std::chrono::microseconds(112500) && rtt_estimator.get_rtt_variation() == std::chrono::microseconds(62500), "later samples are smoothed with gains of 1/8 and 1/4");
+    check(rtt_estimator.get_retransmission_timeout() == std::chrono::microseconds(362500), "later samples set the timeout to srtt + 4 * rttvar");
+
+    rtt_estimator.back_off();
+    check(rtt_estimator.get_retransmission_timeout() == std::chrono::microseconds(725000), "backing off doubles the timeout");
+
+    rtt_estimator.back_off();
+    rtt_estimator.back_off();
+    check(rtt_estimator.get_retransmission_timeout() == std::chrono::seconds(2), "backing off stops at the maximum timeout");
+
+    rtt_estimator.reset_back_off();
+    check(rtt_estimator.get_retransmission_timeout() == std::chrono::microseconds(362500), "resetting the back off restores srtt + 4 * rttvar");
+
+    TelloRttEstimator fast_rtt_estimator;
+    fast_rtt_estimator.add_sample(std::chrono::milliseconds(1));
+    check(fast_rtt_estimator.get_retransmission_timeout() == std::chrono::milliseconds(20), "the timeout doesn't drop below the minimum");
+}
+
+void check_packet_capture() 
+{
+    const std::string capture_location = (std::filesystem::temp_directory_path() / "tello++_tests.tpc").string();
+    const std::string tello_state_packet = "pitch:-2;roll:1;yaw:-87;vgx:0;vgy:0;vgz:0;templ:62;temph:65;tof:10;h:0;bat:87;baro:-57.82;time:0;agx:-3.00;agy:-12.00;agz:-999.00;";
+
+    bool tello_logging = false;
+    TelloLogger tello_logger(tello_logging);
+
+    {
+        TelloPacketCapture packet_capture(capture_location);
+
+        TelloSocket tello_client(tello_logger, 1, "127.0.0.1", 29301, "127.0.0.1", 29300);
+        TelloSocket simulated_tello(tello_logger, 1, "127.0.0.1", 29300, "127.0.0.1", 29301);
+        tello_client.set_packet_capture(&packet_capture, TelloPacketChannel::command);
+
+        tello_client.send_data("command");
+        simulated_tello.receive_data();
+        simulated_tello.send_data("ok");
+        tello_client.receive_data();
+
+        packet_capture.capture(TelloPacketChannel::state, tello_state_packet);
+        packet_capture.capture(TelloPacketChannel::state, tello_state_packet);
+    }
+
+    {
+        TelloPacketRecording packet_recording(capture_location);
+
+        check(packet_recording.get_packet_count() == 4, "a packet capture keeps every packet");
+
+        if (packet_recording.get_packet_count() == 4) 
+        {
+            TelloCapturedPacket sent_packet = packet_recording.get_packet(0);
+            TelloCapturedPacket received_packet = packet_recording.get_packet(1);
+            std::int64_t now_nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+
+            check(sent_packet.channel == TelloPacketChannel::sent_command && sent_packet.payload == "command", "a packet capture records sent commands");
+            check(received_packet.channel == TelloPacketChannel::command && received_packet.payload == "ok", "a packet capture records replies");
+            check(sent_packet.timestamp_nanos <= received_packet.timestamp_nanos && received_packet.timestamp_nanos <= now_nanos && now_nanos - sent_packet.timestamp_nanos < 1000000000, "a packet capture is timestamped with the steady clock");
+        }
+
+        TelloEndpoint tello_endpoint;
+        tello_endpoint.tello_ip = "127.0.0.1";
+        tello_endpoint.tello_state_receiver_ip = "127.0.0.1";
+        tello_endpoint.tello_state_receiver_port = 29302;
+        tello_endpoint.tello_video_receiver_ip = "127.0.0.1";
+        tello_endpoint.tello_video_receiver_port = 29303;
+
+        TelloSocket tello_state_receiver(tello_logger, 1, "127.0.0.1", 0, "127.0.0.1", 29302);
+        TelloPacketReplayer packet_replayer(packet_recording, tello_endpoint);
+        TelloReplayResult replay_result = packet_replayer.replay(TelloPacketReplayer::max_replay_speed);
+
+        check(replay_result.replayed_state_packets == 2 && replay_result.replayed_video_packets == 0, "replaying a capture sends only its state and video packets");
+        check(tello_state_receiver.receive_data() == tello_state_packet && tello_state_receiver.receive_data() == tello_state_packet, "replaying a capture sends the captured payloads");
+    }
+
+    std::filesystem::remove(capture_location);
+
+#if defined(__linux__)
+    std::size_t open_files_before = count_open_sockets();
+
+    try
+    {
+        TelloPacketRecording directory_recording(std::filesystem::temp_directory_path().string());
+        check(false, "a directory can't be mapped as a packet recording");
+    }
+    catch(const std::runtime_error&)
+    {
+
+    }
+
+    check(count_open_sockets() == open_files_before, "a recording that can't be mapped closes its file");
+#endif
+}
+
+bool matches_reference(const AddressTable<int> &address_table, const std::map<std::uint32_t, int> &reference_table, const std::uint32_t &max_address) 
+{
+    if (address_table.size() != reference_table.size()) 
+    {
+        return false;
+    }
+
+    for (std::uint32_t address = 1; address <= max_address; address++) 
+    {
+        const int *value = address_table.find(address);
+        auto reference_value = reference_table.find(address);
+
+        if ((value == nullptr) != (reference_value == reference_table.end()) || (value && *value != reference_value->second)) 
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void check_address_table() 
+{
+    AddressTable<int> address_table;
+
+    check(!address_table.insert(AddressTable<int>::empty_address, 1) && address_table.find(AddressTable<int>::empty_address) == nullptr, "the address table ignores the empty address");
+    check(address_table.insert(7, 1) && !address_table.insert(7, 2) && *address_table.find(7) == 1, "the address table doesn't overwrite an address");
+    check(address_table.erase(7) && !address_table.erase(7) && address_table.size() == 0, "the address table erases an address once");
+
+    std::mt19937 random_engine(24);
+    std::uniform_int_distribution<std::uint32_t> random_address(1, 24);
+    std::map<std::uint32_t, int> reference_table;
+    bool matched = true;
+
+    for (int operation = 0; operation < 20000 && matched; operation++) 
+    {
+        std::uint32_t address = random_address(random_engine);
+
+        if (reference_table.size() < 7 && operation % 2 == 0) 
+        {
+            matched = address_table.insert(address, operation) == reference_table.emplace(address, operation).second;
+        }
+        else
+        {
+            matched = address_table.erase(address) == (reference_table.erase(address) == 1);
+        }
+
+        matched = matched && matches_reference(address_table, reference_table, 24);
+    }
+
+    check(matched && address_table.capacity() == 16, "erasing from a crowded address table shifts colliding addresses back across the wrap");
+
+    for (std::uint32_t address = 1; address <= 1000 && matched; address++) 
+    {
+        matched = address_table.insert(address, static_cast<int>(address)) || reference_table.count(address) == 1;
+        reference_table.emplace(address, static_cast<int>(address));
+    }
+
+    for (std::uint32_t address = 1; address <= 1000 && matched; address += 3) 
+    {
+        matched = address_table.erase(address);
+        reference_table.erase(address);
+    }
+
+    check(matched && matches_reference(address_table, reference_table, 1000), "the address table keeps every address through growth and erasure");
+}
+
+bool rejects_estimator_settings(const TelloStateEstimatorSettings &estimator_settings) 
+{
+    try
+    {
+        TelloStateEstimator tello_state_estimator(estimator_settings);
+        TelloStateEstimatorBatch tello_state_estimator_batch(1, estimator_settings);
+    }
+    catch(const std::invalid_argument&)
+    {
+        return true;
+    }
+
+    return false;
+}
+
+void check_state_estimator_settings() 
+{
+    TelloStateEstimatorSettings noiseless_height;
+    noiseless_height.height_noise_cm = 0;
+
+    TelloStateEstimatorSettings noiseless_velocity;
+    noiseless_velocity.velocity_noise_cm_per_sec = 0;
+
+    TelloStateEstimatorSettings negative_acceleration_noise;
+    negative_acceleration_noise.acceleration_noise_cm_per_sec_squared = -1;
+
+    check(rejects_estimator_settings(noiseless_height) && rejects_estimator_settings(noiseless_velocity) && rejects_estimator_settings(negative_acceleration_noise), "the state estimator rejects noise settings that aren't above zero");
+    check(!rejects_estimator_settings(TelloStateEstimatorSettings{}), "the state estimator accepts its default settings");
+}
+
+void check_latency_histogram() 
+{
+    check(LatencyHistogram::get_bucket_index(0) == 0 && LatencyHistogram::get_bucket_index(63) == 63, "latencies below 64us get a bucket each");
+    check(LatencyHistogram::get_bucket_index(64) == 64 && LatencyHistogram::get_bucket_index(65) == 64 && LatencyHistogram::get_bucket_index(66) == 65 && LatencyHistogram::get_bucket_index(127) == 95, "latencies from 64us share buckets two wide");
+    check(LatencyHistogram::get_bucket_index(128) == 96 && LatencyHistogram::get_bucket_index(131) == 96 && LatencyHistogram::get_bucket_index(132) == 97, "each magnitude doubles the bucket width");
+    check(LatencyHistogram::get_bucket_index(LatencyHistogram::max_trackable_micros) == LatencyHistogram::bucket_count - 1, "the largest trackable latency lands in the last bucket");
+
+    bool buckets_contiguous = true;
+
+    for (std::uint64_t latency_micros = 1; latency_micros < (1ull << 20) && buckets_contiguous; latency_micros++) 
+    {
+        std::size_t bucket_step = LatencyHistogram::get_bucket_index(latency_micros) - LatencyHistogram::get_bucket_index(latency_micros - 1);
+        buckets_contiguous = bucket_step <= 1;
+    }
+
+    check(buckets_contiguous, "latency buckets are contiguous");
+
+    LatencyHistogram latency_histogram;
+
+    for (std::uint64_t latency_micros = 1; latency_micros <= 100; latency_micros++) 
+    {
+        latency_histogram.record(latency_micros);
+    }
+
+    check(latency_histogram.get_value_at_percentile(50) == 50 && latency_histogram.get_value_at_percentile(99) == 99 && latency_histogram.get_value_at_percentile(100) == 100, "percentiles report the top of their bucket, capped at the maximum");
+    check(latency_histogram.get_min_micros() == 1 && latency_histogram.get_sum_micros() == 5050 && latency_histogram.get_mean_micros() == 50.5, "the histogram tracks the minimum, sum and mean");
+
+    latency_histogram.record(UINT64_MAX);
+    check(latency_histogram.get_max_micros() == LatencyHistogram::max_trackable_micros, "latencies are clamped to the largest trackable latency");
+
+    latency_histogram.reset();
+    check(latency_histogram.get_count() == 0 && latency_histogram.get_value_at_percentile(50) == 0 && latency_histogram.get_min_micros() == 0, "resetting the histogram empties it");
+}
+
+void check_frame_accounting() 
+{
+    DropOldestQueue<int> drop_oldest_queue(3);
+    int popped_item = 0;
+
+    check(drop_oldest_queue.push(1) && drop_oldest_queue.push(2) && drop_oldest_queue.push(3) && !drop_oldest_queue.push(4), "a full queue reports dropping its oldest item");
+    check(drop_oldest_queue.size() == 3 && drop_oldest_queue.get_dropped_count() == 1, "a full queue counts the item it dropped");
+    check(drop_oldest_queue.pop(popped_item, std::chrono::milliseconds(0)) && popped_item == 2, "a full queue drops its oldest item first");
+
+    drop_oldest_queue.pop(popped_item, std::chrono::milliseconds(0));
+    drop_oldest_queue.pop(popped_item, std::chrono::milliseconds(0));
+
+    check(popped_item == 4 && !drop_oldest_queue.pop(popped_item, std::chrono::milliseconds(1)), "an empty queue times out");
+
+    drop_oldest_queue.close();
+    auto popped_at = std::chrono::steady_clock::now();
+
+    check(!drop_oldest_queue.pop(popped_item, std::chrono::seconds(5)) && std::chrono::steady_clock::now() - popped_at < std::chrono::seconds(1), "a closed queue stops waiting");
+
+    drop_oldest_queue.push(5);
+    drop_oldest_queue.clear();
+
+    check(drop_oldest_queue.size() == 0 && drop_oldest_queue.get_dropped_count() == 1, "clearing a queue doesn't count as dropping");
+
+    FramePool frame_pool(2, 64);
+    FrameHandle first_frame = frame_pool.try_acquire();
+    FrameHandle second_frame = frame_pool.try_acquire();
+
+    check(first_frame && second_frame && !frame_pool.try_acquire() && frame_pool.get_exhausted_count() == 1 && frame_pool.get_free_frame_count() == 0, "an exhausted frame pool counts failed acquires");
+
+    FrameHandle shared_frame = first_frame;
+    FrameHandle moved_frame = std::move(second_frame);
+
+    check(first_frame.get_reference_count() == 2 && moved_frame.get_reference_count() == 1 && !second_frame, "copying a frame shares it and moving it doesn't");
+
+    first_frame.reset();
+    check(frame_pool.get_free_frame_count() == 0 && shared_frame.get_reference_count() == 1, "a frame stays taken while it's shared");
+
+    shared_frame.reset();
+    check(frame_pool.get_free_frame_count() == 1, "a frame goes back to the pool with its last reference");
+
+    DropOldestQueue<FrameHandle> frame_queue(1);
+    frame_queue.push(std::move(moved_frame));
+    frame_queue.push(frame_pool.try_acquire());
+
+    check(frame_pool.get_free_frame_count() == 1 && frame_queue.get_dropped_count() == 1, "a frame dropped from a full queue goes back to the pool");
+
+    frame_queue.clear();
+    check(frame_pool.get_free_frame_count() == 2, "clearing a frame queue returns its frames to the pool");
+}
+
+bool is_invalid_mission(const MissionPlan &mission_plan) 
+{
+    try
+    {
+        mission_plan.validate();
+    }
+    catch(const std::out_of_range&)
+    {
+        return true;
+    }
+
+    return false;
+}
+
+void check_mission_plans() 
+{
+    MissionPlan merged_moves = MissionPlan().fly_forward(100).fly_forward(100).rotate_clockwise(90).rotate_clockwise(90).compile();
+
+    check(merged_moves.size() == 2 && merged_moves.get_mission_steps()[0].arguments[0] == 200 && merged_moves.get_mission_steps()[1].arguments[0] == 180, "compiling merges repeated moves and rotations");
+    check(MissionPlan().fly_forward(400).fly_forward(200).compile().size() == 2, "compiling doesn't merge moves past the longest move");
+    check(MissionPlan().fly_forward(100).fly_backward(100).compile().size() == 2, "compiling doesn't merge opposite moves");
+    check(MissionPlan().fly_forward(100).fly_forward(100).compile(MissionCompileOptions{false, false, false, 0}).size() == 2, "compiling without merging keeps every step");
+
+    MissionPlan merged_go = MissionPlan().set_speed(50).fly_forward(30).fly_up(30).compile(MissionCompileOptions{true, true, true, 0});
+    const MissionStep &go_step = merged_go.get_mission_steps().back();
+
+    check(merged_go.size() == 2 && go_step.kind == MissionStepKind::go && go_step.arguments[0] == 30 && go_step.arguments[1] == 0 && go_step.arguments[2] == 30 && go_step.arguments[3] == 50, "compiling merges moves into 'go' at the current speed");
+    check(MissionPlan().fly_forward(30).fly_up(30).compile(MissionCompileOptions{true, true, true, 0}).size() == 2, "compiling doesn't merge into 'go' without a speed");
+
+    check(is_invalid_mission(MissionPlan().fly_forward(10)), "validating rejects moves that are too short");
+    check(is_invalid_mission(MissionPlan().rotate_clockwise(0)), "validating rejects rotations that are too small");
+    check(is_invalid_mission(MissionPlan().fly_to_position(10, 10, 10, 50)), "validating rejects 'go' inside the dead zone");
+    check(!is_invalid_mission(MissionPlan().takeoff().fly_to_position(30, 0, 0, 50).land()), "validating accepts a valid mission");
+}
+
+void check_mission_timeouts() 
+{
+    bool tello_logging = false;
+    TelloLogger tello_logger(tello_logging);
+
+    TelloSimulator tello_simulator(make_delayed_simulator_settings(150));
+    tello_simulator.start();
+
+    {
+        TelloSocket tello_client(tello_logger, 2, "127.0.0.1", 28889, "127.0.0.1", 29100);
+        TelloCommandPipeline tello_command_pipeline(tello_client);
+        tello_command_pipeline.start();
+
+        MissionRetryPolicy retry_policy;
+        retry_policy.max_timeout_retries = 2;
+        retry_policy.retry_delay = std::chrono::milliseconds(10);
+        retry_policy.step_timeout = std::chrono::milliseconds(50);
+
+        TelloMissionExecutor motion_executor(tello_command_pipeline, nullptr, retry_policy);
+        MissionResult motion_result = motion_executor.run(MissionPlan().fly_up(20));
+
+        check(!motion_result.completed && motion_result.retry_count == 0, "a timed out motion isn't resent without telemetry");
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+        TelloMissionExecutor speed_executor(tello_command_pipeline, nullptr, retry_policy);
+        MissionResult speed_result = speed_executor.run(MissionPlan().set_speed(50));
+
+        check(!speed_result.completed && speed_result.retry_count == 2, "a timed out idempotent step is resent");
+    }
+
+    std::future<MissionResult> mission_result;
+
+    {
+        Tello tello{tello_simulator.get_tello_endpoint(), false, false, 2};
+        mission_result = tello.run_mission(MissionPlan().takeoff().fly_up(100).fly_down(100).fly_up(100).fly_down(100).land());
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+
+    check(mission_result.wait_for(std::chrono::seconds(0)) == std::future_status::ready && !mission_result.get().completed, "destroying a Tello cancels and waits for its mission");
+}
+
+std::string receive_last_datagram(TelloSocket &tello_socket) 
+{
+    std::string last_datagram;
+
+    tello_socket.set_receive_timeout(50);
+
+    try
+    {
+        while (true) 
+        {
+            last_datagram = tello_socket.receive_data();
+        }
+    }
+    catch(const std::runtime_error&)
+    {
+
+    }
+
+    return last_datagram;
+}
+
+void check_video_reassembly() 
+{
+    bool tello_logging = false;
+    TelloLogger tello_logger(tello_logging);
+
+    {
+        TelloSimulatorSettings simulator_settings;
+        simulator_settings.simulator_port = 29400;
+        simulator_settings.client_port = 29401;
+        simulator_settings.state_port = 29402;
+        simulator_settings.video_port = 29403;
+        simulator_settings.state_rate_hz = 0;
+        simulator_settings.video_access_unit_size = 8000;
+
+        TelloSimulator tello_simulator(simulator_settings);
+        TelloEndpoint tello_endpoint = tello_simulator.get_tello_endpoint();
+
+        TelloSocket tello_video_receiver(tello_logger, 1, tello_endpoint.tello_ip, tello_endpoint.tello_port, tello_endpoint.tello_video_receiver_ip, tello_endpoint.tello_video_receiver_port);
+        TelloVideoReceiver tello_video_assembler(tello_video_receiver);
+
+        tello_simulator.set_video_streaming(true);
+        tello_simulator.start();
+
+        bool reassembled = true;
+
+        for (int access_unit_index = 0; access_unit_index < 3; access_unit_index++) 
+        {
+            std::span<const std::byte> access_unit = tello_video_assembler.receive_access_unit();
+            reassembled = reassembled && access_unit.size() == 8000 && access_unit[3] == std::byte{1} && access_unit[7999] == std::byte{0x55};
+        }
+
+        check(reassembled, "fragmented access units are reassembled whole");
+        check(tello_video_assembler.get_dropped_access_unit_count() == 0, "reassembling a clean stream drops nothing");
+    }
+
+    const std::string start_code("\x00\x00\x00\x01", 4);
+    const std::string first_fragment = start_code + std::string(TelloVideoReceiver::tello_video_fragment_size - start_code.size(), 'v');
+    const std::string middle_fragment(TelloVideoReceiver::tello_video_fragment_size, 'v');
+    const std::string short_access_unit = start_code + std::string(20, 'v');
+
+    TelloSocket tello_video_receiver(tello_logger, 1, "127.0.0.1", 29405, "127.0.0.1", 29404);
+    TelloSocket tello_video_sender(tello_logger, 1, "127.0.0.1", 29404, "127.0.0.1", 29405);
+    tello_video_receiver.set_receive_timeout(100);
+
+    TelloVideoReceiver tello_video_assembler(tello_video_receiver, 2, 4096);
+    std::vector<std::byte> access_unit(4096);
+
+    tello_video_sender.send_data(middle_fragment);
+    tello_video_sender.send_data("vvvv");
+    tello_video_sender.send_data(first_fragment);
+    tello_video_sender.send_data("vvvv");
+
+    check(tello_video_assembler.receive_access_unit_into(access_unit) == first_fragment.size() + 4 && access_unit[3] == std::byte{1}, "an access unit without a start code is skipped");
+    check(tello_video_assembler.get_dropped_access_unit_count() == 1, "an access unit without a start code is counted as dropped");
+
+    tello_video_sender.send_data(first_fragment);
+    tello_video_sender.send_data(middle_fragment);
+    tello_video_sender.send_data(middle_fragment);
+    tello_video_sender.send_data("vvvv");
+    tello_video_sender.send_data(short_access_unit);
+
+    check(tello_video_assembler.receive_access_unit_into(access_unit) == short_access_unit.size(), "an access unit that overflows its slab is skipped");
+    check(tello_video_assembler.get_dropped_access_unit_count() == 2, "an access unit that overflows its slab is counted as dropped");
+
+    tello_video_sender.send_data(first_fragment);
+
+    bool timed_out = false;
+
+    try
+    {
+        tello_video_assembler.receive_access_unit_into(access_unit);
+    }
+    catch(const std::runtime_error&)
+    {
+        timed_out = true;
+    }
+
+    check(timed_out && tello_video_assembler.get_dropped_access_unit_count() == 3, "an access unit cut off by a timeout is counted as dropped");
+
+    tello_video_sender.send_data("vvvv");
+    tello_video_sender.send_data(short_access_unit);
+
+    check(tello_video_assembler.receive_access_unit_into(access_unit) == short_access_unit.size(), "the tail of a timed out access unit isn't glued to the next one");
+    check(tello_video_assembler.get_dropped_access_unit_count() == 4, "the tail of a timed out access unit is counted as dropped");
+}
+
+void check_remote_control_stream() 
+{
+    bool tello_logging = false;
+    TelloLogger tello_logger(tello_logging);
+
+    TelloSocket tello_client(tello_logger, 1, "127.0.0.1", 29201, "127.0.0.1", 29200);
+    TelloSocket simulated_tello(tello_logger, 1, "127.0.0.1", 29200, "127.0.0.1", 29201);
+    TelloRemoteControlStream tello_remote_control_stream(tello_client, 100);
+
+    tello_remote_control_stream.start();
+    tello_remote_control_stream.set_sticks(10, -20, 30, -40);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    tello_remote_control_stream.stop();
+
+    check(receive_last_datagram(simulated_tello) == "rc 0 0 0 0", "stopping the remote control stream centres the sticks");
+
+    tello_remote_control_stream.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    std::string restarted_sticks = simulated_tello.receive_data();
+    tello_remote_control_stream.stop();
+
+    check(restarted_sticks == "rc 0 0 0 0", "restarting the remote control stream doesn't resume old sticks");
+}
+
+void check_tello_logger() 
+{
+    const std::string tello_state_packet = "mid:-1;x:0;y:0;z:0;mpry:0,0,0;pitch:-2;roll:1;yaw:-87;vgx:0;vgy:0;vgz:0;templ:62;temph:65;tof:10;h:0;bat:87;baro:-57.82;time:0;agx:-3.00;agy:-12.00;agz:-999.00;";
+    const std::string log_location = (std::filesystem::temp_directory_path() / "tello++_tests.log").string();
+
+    std::size_t logged_count = TelloLogger::ring_capacity + 100;
+    std::size_t written_count = 0;
+    bool found_tello_state_packet = false;
+
+    {
+        bool tello_logging = true;
+        TelloLogger tello_logger(tello_logging);
+
+        for (std::size_t log_index = 0; log_index < logged_count; log_index++) 
+        {
+            tello_logger.log_data("history " + std::to_string(log_index));
+
+            if (log_index % 1024 == 0) 
+            {
+                tello_logger.flush();
+            }
+        }
+
+        tello_logger.log_data(tello_state_packet);
+        tello_logger.write_log(log_location);
+    }
+
+    std::ifstream log_file(log_location);
+    std::string log_line;
+
+    while (std::getline(log_file, log_line)) 
+    {
+        written_count++;
+        found_tello_state_packet = found_tello_state_packet || log_line.ends_with(tello_state_packet);
+    }
+
+    std::filesystem::remove(log_location);
+
+    check(written_count == logged_count + 1, "write_log keeps records older than the ring");
+    check(found_tello_state_packet, "write_log keeps whole state packets");
+
+    {
+        bool tello_logging = true;
+        TelloLogger tello_logger(tello_logging);
+
+        for (std::size_t log_index = 0; log_index * tello_state_packet.size() < 2 * TelloLogger::history_capacity; log_index++) 
+        {
+            tello_logger.log_data(tello_state_packet);
+
+            if (log_index % 1024 == 0) 
+            {
+                tello_logger.flush();
+            }
+        }
+
+        tello_logger.log_data("newest record");
+        tello_logger.write_log(log_location);
+    }
+
+    std::string first_log_line;
+    std::string last_log_line;
+
+    log_file.close();
+    log_file.clear();
+    log_file.open(log_location);
+    std::getline(log_file, first_log_line);
+
+    for (log_line = first_log_line; std::getline(log_file, log_line);) 
+    {
+        last_log_line = log_line;
+    }
+
+    log_file.close();
+
+    check(std::filesystem::file_size(log_location) <= TelloLogger::history_capacity, "write_log keeps at most the history capacity");
+    check(first_log_line.starts_with("[") && first_log_line.ends_with(tello_state_packet), "a capped history starts at a whole record");
+    check(last_log_line.ends_with("newest record"), "a capped history keeps the newest records");
+
+    std::filesystem::remove(log_location);
+}
+
+void check_flight_recorder() 
+{
+    constexpr int writer_count = 4;
+    constexpr int samples_per_writer = 1000;
+
+    const std::string recording_location = (std::filesystem::temp_directory_path() / "tello++_tests.flight").string();
+
+    {
+        TelloFlightRecorder tello_flight_recorder(recording_location, 64, 1);
+        std::vector<std::thread> writers;
+
+        for (int writer = 0; writer < writer_count; writer++) 
+        {
+            writers.emplace_back
+            (
+                [&tello_flight_recorder, writer]() 
+                {
+                    for (int sample = 0; sample < samples_per_writer; sample++) 
+                    {
+                        TelloState tello_state{};
+                        tello_state.battery = writer;
+                        tello_state.height = sample;
+
+                        tello_flight_recorder.record(tello_state, static_cast<std::uint32_t>(writer));
+                    }
+                }
+            );
+        }
+
+        for (std::thread &writer : writers) 
+        {
+            writer.join();
+        }
+    }
+
+    TelloFlightRecording tello_flight_recording(recording_location);
+
+    std::vector<int> next_heights(writer_count, 0);
+    bool samples_intact = tello_flight_recording.get_sample_count() == writer_count * samples_per_writer;
+    bool steady_timestamps_ordered = true;
+
+    for (std::size_t sample_index = 0; samples_intact && sample_index < tello_flight_recording.get_sample_count(); sample_index++) 
+    {
+        TelloState tello_state = tello_flight_recording.get_tello_state(sample_index);
+        std::uint32_t tello_id = tello_flight_recording.get_tello_ids(sample_index / 64)[sample_index % 64];
+
+        samples_intact = tello_id < writer_count && tello_state.battery == static_cast<int>(tello_id) && tello_state.height == next_heights[tello_id]++;
+        steady_timestamps_ordered = steady_timestamps_ordered && (sample_index == 0 || tello_flight_recording.get_steady_timestamp(sample_index - 1) <= tello_flight_recording.get_steady_timestamp(sample_index));
+    }
+
+    check(samples_intact, "concurrent writers don't corrupt a flight recording");
+    check(steady_timestamps_ordered, "flight recordings are ordered by their steady timestamps");
+    check(tello_flight_recording.seek(tello_flight_recording.get_steady_timestamp(1234)) <= 1234 && tello_flight_recording.get_steady_timestamp(tello_flight_recording.seek(tello_flight_recording.get_steady_timestamp(1234))) == tello_flight_recording.get_steady_timestamp(1234), "seek finds a recorded steady timestamp");
+
+    std::filesystem::remove(recording_location);
+}
+
+void check_tello_socket() 
+{
+    bool tello_logging = false;
+    TelloLogger tello_logger(tello_logging);
+
+    TelloSocket tello_state_receiver(tello_logger, 1, "127.0.0.2", 29001, "127.0.0.1", 29000);
+    TelloSocket tello_state_sender(tello_logger, 1, "127.0.0.1", 29000, "127.0.0.2", 29001);
+    TelloSocket stranger_sender(tello_logger, 1, "127.0.0.1", 29000, "127.0.0.3", 29001);
+
+    std::size_t open_sockets = count_open_sockets();
+    bool bind_failed = false;
+
+    try
+    {
+        TelloSocket taken_port_socket(tello_logger, 1, "127.0.0.2", 29001, "127.0.0.1", 29000);
+    }
+    catch(const std::runtime_error&)
+    {
+        bind_failed = true;
+    }
+
+    check(bind_failed, "binding a taken port throws");
+    check(count_open_sockets() == open_sockets, "a socket that fails to bind doesn't leak its descriptor");
+
+    stranger_sender.send_data("injected");
+    tello_state_sender.send_data("pitch:0;");
+    tello_state_sender.send_data("pitch:1;");
+
+    char datagram_buffers[4][64];
+    TelloDatagram datagrams[4];
+
+    for (int datagram_index = 0; datagram_index < 4; datagram_index++) 
+    {
+        datagrams[datagram_index] = TelloDatagram{datagram_buffers[datagram_index], 64, 0, {}};
+    }
+
+    int received_count = 0;
+
+    for (int attempt = 0; attempt < 3 && received_count < 2; attempt++) 
+    {
+        int batch_count = tello_state_receiver.receive_datagrams(datagrams + received_count, 4 - received_count);
+
+        for (int datagram_index = received_count; datagram_index < received_count + batch_count; datagram_index++) 
+        {
+            check(std::string_view(datagrams[datagram_index].data, datagrams[datagram_index].size) != "injected", "batch receives drop datagrams from other hosts");
+        }
+
+        received_count += batch_count;
+    }
+
+    check(received_count == 2, "batch receives keep every datagram from the Tello");
+
+    bool rejected_datagram_count = false;
+
+    try
+    {
+        TelloStateBatchReceiver empty_batch_receiver(tello_state_receiver, 0);
+    }
+    catch(const std::invalid_argument&)
+    {
+        rejected_datagram_count = true;
+    }
+
+    check(rejected_datagram_count, "a batch receiver has to receive at least one datagram at a time");
+
+    const std::string tello_state_packet = "pitch:-2;roll:1;yaw:-87;vgx:0;vgy:0;vgz:0;templ:62;temph:65;tof:10;h:0;bat:87;baro:-57.82;time:0;agx:-3.00;agy:-12.00;agz:-999.00;";
+
+    tello_state_sender.send_data(std::string(TelloStateBatchReceiver::max_tello_state_size, 'x') + tello_state_packet);
+    tello_state_sender.send_data(tello_state_packet);
+
+    TelloStateBatch tello_state_batch;
+    TelloStateBatchReceiver tello_state_batch_receiver(tello_state_receiver, 4);
+
+    for (int attempt = 0; attempt < 3 && tello_state_batch.size() + tello_state_batch_receiver.get_truncated_tello_state_count() < 2; attempt++) 
+    {
+        tello_state_batch_receiver.receive_tello_states(tello_state_batch);
+    }
+
+    check(tello_state_batch.size() == 1 && tello_state_batch.battery[0] == 87, "a batch receiver parses whole state packets");
+    check(tello_state_batch_receiver.get_truncated_tello_state_count() == 1 && tello_state_batch_receiver.get_malformed_tello_state_count() == 0, "a batch receiver reports state packets longer than its buffers as truncated");
+}
+
+int main(int argc, char *argv[]) 
+{
+    std::unique_ptr<TelloSimulator> tello_simulator;
+    TelloEndpoint tello_endpoint;
+
+    if (argc > 1 && std::string(argv[1]) == "--simulator") 
+    {
+        check_tello_state_parsing();
+        check_tello_socket();
+        check_late_responses();
+        check_duplicate_responses();
+        check_lossy_responses();
+        check_command_encoding();
+        check_rtt_estimator();
+        check_latency_histogram();
+        check_mission_plans();
+        check_packet_capture();
+        check_state_estimator_settings();
+        check_address_table();
+        check_frame_accounting();
+        check_mission_timeouts();
+        check_video_reassembly();
+        check_remote_control_stream();
+        check_tello_logger();
+        check_flight_recorder();
+
+        tello_simulator = std::make_unique<TelloSimulator>();
+        tello_simulator->start();
+        tello_endpoint = tello_simulator->get_tello_endpoint();
+    }
+
+    Tello tello{tello_endpoint, true, true};
 
     tello.takeoff();
     Tello::TelloState tello_state = tello.get_tello_state();
@@ -33,4 +1071,6 @@ int main()
     std::cout << tello.get_imu_acceleration().x_acceleration << '\n';
     std::cout << tello.get_distance_from_takeoff() << '\n';
     std::cout << tello.get_wifi_snr() << '\n';
+
+    return failed_checks == 0 ? 0 : 1;
 }
\ No newline at end of file